@@ -434,14 +434,18 @@ void add_ability_to_table(ability_data *abil) {
 		HASH_FIND_INT(ability_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(ability_table, vnum, abil);
-			HASH_SORT(ability_table, sort_abilities);
+			if (!defer_table_sorts) {
+				HASH_SORT(ability_table, sort_abilities);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_abilities, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_abilities, vnum, sizeof(int), abil);
-			HASH_SRT(sorted_hh, sorted_abilities, sort_abilities_by_data);
+			if (!defer_table_sorts) {
+				HASH_SRT(sorted_hh, sorted_abilities, sort_abilities_by_data);
+			}
 		}
 	}
 }
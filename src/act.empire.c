@@ -80,25 +80,28 @@ void set_workforce_limit_all(empire_data *emp, int chore, int limit);
 void convert_empire_shipping(empire_data *old_emp, empire_data *new_emp) {
 	extern int find_free_shipping_id(empire_data *emp);
 	
+	struct empire_vehicle_index *vidx, *next_vidx;
 	struct shipping_data *sd, *next_sd;
 	vehicle_data *veh;
 	int old_id, new_id;
 	
-	LL_FOREACH(vehicle_list, veh) {
-		if (VEH_OWNER(veh) != old_emp || VEH_SHIPPING_ID(veh) == -1) {
-			continue;
-		}
-		
-		old_id = VEH_SHIPPING_ID(veh);
-		new_id = find_free_shipping_id(new_emp);
-		
-		LL_FOREACH_SAFE(EMPIRE_SHIPPING_LIST(old_emp), sd, next_sd) {
-			if (sd->shipping_id == old_id) {
-				sd->shipping_id = new_id;
+	HASH_ITER(hh, EMPIRE_VEHICLE_INDEX(old_emp), vidx, next_vidx) {
+		DL_FOREACH2(vidx->vehicles, veh, next_owned) {
+			if (VEH_SHIPPING_ID(veh) == -1) {
+				continue;
+			}
+			
+			old_id = VEH_SHIPPING_ID(veh);
+			new_id = find_free_shipping_id(new_emp);
+			
+			LL_FOREACH_SAFE(EMPIRE_SHIPPING_LIST(old_emp), sd, next_sd) {
+				if (sd->shipping_id == old_id) {
+					sd->shipping_id = new_id;
+				}
 			}
+			
+			VEH_SHIPPING_ID(veh) = new_id;
 		}
-		
-		VEH_SHIPPING_ID(veh) = new_id;
 	}
 	
 	// move all shipping entries over
@@ -317,7 +320,6 @@ int get_war_cost(empire_data *emp, empire_data *victim) {
 bool is_affiliated_island(empire_data *emp, int island_id) {
 	struct empire_island *isle;
 	struct empire_unique_storage *eus;
-	struct empire_storage_data *store;
 	
 	//Grab the empire_isle information.
 	isle = get_empire_island(emp,island_id);
@@ -328,10 +330,8 @@ bool is_affiliated_island(empire_data *emp, int island_id) {
 	}
 	
 	//Check if the empire has at least an item in there.
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		if (isle->island == store->island) {
-			return true;
-		}
+	if (isle->store) {
+		return true;
 	}
 	
 	//Check unique storage too
@@ -635,8 +635,9 @@ static void show_empire_identify_to_char(char_data *ch, empire_data *emp, char *
 		UT_hash_handle hh;
 	};
 	
-	struct empire_storage_data *store;
+	struct empire_storage_data *store, *next_store;
 	struct eid_per_island *eid_pi, *eid_pi_next, *eid_pi_list = NULL;
+	struct empire_island *isle, *next_isle;
 	obj_data *proto = NULL;
 	
 	
@@ -649,24 +650,26 @@ static void show_empire_identify_to_char(char_data *ch, empire_data *emp, char *
 		return;
 	}
 	
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		//If there isn't an item proto yet, the first item that matches the given argument will become the item used for the rest of the loop.
-		if ( !proto ) {
-			if (!multi_isname(argument, GET_OBJ_KEYWORDS(obj_proto(store->vnum)))) {
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		HASH_ITER(hh, isle->store, store, next_store) {
+			//If there isn't an item proto yet, the first item that matches the given argument will become the item used for the rest of the loop.
+			if ( !proto ) {
+				if (!multi_isname(argument, GET_OBJ_KEYWORDS(obj_proto(store->vnum)))) {
+					continue;
+				} else {
+					proto = obj_proto(store->vnum);
+				}
+			}else if ( proto->vnum != store->vnum){
 				continue;
-			} else {
-				proto = obj_proto(store->vnum);
 			}
-		}else if ( proto->vnum != store->vnum){
-			continue;
+			
+			//We have a match.
+			CREATE(eid_pi, struct eid_per_island, 1);
+			eid_pi->island = store->island;
+			eid_pi->quantity = store->amount;
+			HASH_ADD_INT(eid_pi_list, island, eid_pi);
+			break;	// only 1 per island
 		}
-		
-		//We have a match.
-		CREATE(eid_pi, struct eid_per_island, 1);
-		eid_pi->island = store->island;
-		eid_pi->quantity = store->amount;
-		HASH_ADD_INT(eid_pi_list, island, eid_pi);
-		
 	}
 	if ( !proto ) {
 		msg_to_char(ch, "This empire has no item by that name.\r\n");
@@ -685,6 +688,31 @@ static void show_empire_identify_to_char(char_data *ch, empire_data *emp, char *
 	
 }
 
+
+// helper data for show_empire_inventory_to_char
+struct einv_type {
+	obj_vnum vnum;
+	int local;
+	int total;
+	UT_hash_handle hh;
+};
+
+
+/**
+* Sorts the einv display: most on the local island first, then by total.
+*
+* @param struct einv_type *a One element
+* @param struct einv_type *b Another element
+* @return int Sort instruction of <0, 0, or >0
+*/
+static int sort_einv_display(struct einv_type *a, struct einv_type *b) {
+	if (a->local != b->local) {
+		return b->local - a->local;
+	}
+	return b->total - a->total;
+}
+
+
 /**
 * called by do_empire_inventory to show einv
 *
@@ -693,19 +721,12 @@ static void show_empire_identify_to_char(char_data *ch, empire_data *emp, char *
 * @param char *argument The requested inventory item, if any.
 */
 static void show_empire_inventory_to_char(char_data *ch, empire_data *emp, char *argument) {
-	// helper type
-	struct einv_type {
-		obj_vnum vnum;
-		int local;
-		int total;
-		UT_hash_handle hh;
-	};
-
 	char output[MAX_STRING_LENGTH*2], line[MAX_STRING_LENGTH];
 	struct einv_type *einv, *next_einv, *list = NULL;
-	obj_vnum vnum, last_vnum = NOTHING;
-	struct empire_storage_data *store;
+	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle, *next_isle;
 	struct shipping_data *shipd;
+	obj_vnum vnum;
 	obj_data *proto = NULL;
 	size_t lsize, size;
 	bool all = FALSE, any = FALSE;
@@ -725,36 +746,33 @@ static void show_empire_inventory_to_char(char_data *ch, empire_data *emp, char
 	}
 	
 	// build list
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		// prototype lookup
-		if (store->vnum != last_vnum) {
-			proto = obj_proto(store->vnum);
-			last_vnum = store->vnum;
-		}
-		
-		if (!proto) {
-			continue;
-		}
-		
-		// argument given but doesn't match
-		if (*argument && !multi_isname(argument, GET_OBJ_KEYWORDS(proto))) {
-			continue;
-		}
-		
-		// ready to add
-		vnum = store->vnum;
-		HASH_FIND_INT(list, &vnum, einv);
-		if (!einv) {
-			CREATE(einv, struct einv_type, 1);
-			einv->vnum = vnum;
-			einv->local = einv->total = 0;
-			HASH_ADD_INT(list, vnum, einv);
-		}
-		
-		// add
-		einv->total += store->amount;
-		if (store->island == GET_ISLAND_ID(IN_ROOM(ch))) {
-			einv->local += store->amount;
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		HASH_ITER(hh, isle->store, store, next_store) {
+			// prototype lookup
+			if (!(proto = obj_proto(store->vnum))) {
+				continue;
+			}
+			
+			// argument given but doesn't match
+			if (*argument && !multi_isname(argument, GET_OBJ_KEYWORDS(proto))) {
+				continue;
+			}
+			
+			// ready to add
+			vnum = store->vnum;
+			HASH_FIND_INT(list, &vnum, einv);
+			if (!einv) {
+				CREATE(einv, struct einv_type, 1);
+				einv->vnum = vnum;
+				einv->local = einv->total = 0;
+				HASH_ADD_INT(list, vnum, einv);
+			}
+			
+			// add
+			einv->total += store->amount;
+			if (isle->island == GET_ISLAND_ID(IN_ROOM(ch))) {
+				einv->local += store->amount;
+			}
 		}
 	}
 	
@@ -775,6 +793,8 @@ static void show_empire_inventory_to_char(char_data *ch, empire_data *emp, char
 		}
 	}
 	
+	HASH_SORT(list, sort_einv_display);
+	
 	// build output
 	size = snprintf(output, sizeof(output), "Inventory of %s%s&0 on this island:\r\n", EMPIRE_BANNER(emp), EMPIRE_NAME(emp));
 	
@@ -1031,7 +1051,6 @@ void abandon_city(char_data *ch, char *argument) {
 	log_to_empire(emp, ELOG_TERRITORY, "%s has abandoned %s", PERS(ch, ch, 1), city->name);
 	perform_abandon_city(emp, city, TRUE);
 	
-	read_empire_territory(emp, FALSE);
 	save_empire(emp);
 }
 
@@ -1196,6 +1215,7 @@ void claim_city(char_data *ch, char *argument) {
 void downgrade_city(char_data *ch, char *argument) {
 	empire_data *emp = GET_LOYALTY(ch);
 	struct empire_city_data *city;
+	int radius;
 	
 	skip_spaces(&argument);
 	
@@ -1218,7 +1238,10 @@ void downgrade_city(char_data *ch, char *argument) {
 	}
 
 	if (city->type > 0) {
+		radius = city_type[city->type].radius;	// the old, larger radius
+		update_city_area_territory(emp, city->location, radius, FALSE);
 		city->type--;
+		update_city_area_territory(emp, city->location, radius, TRUE);
 		log_to_empire(emp, ELOG_TERRITORY, "%s has downgraded %s to a %s", PERS(ch, ch, 1), city->name, city_type[city->type].name);
 	}
 	else {
@@ -1226,7 +1249,6 @@ void downgrade_city(char_data *ch, char *argument) {
 		perform_abandon_city(emp, city, FALSE);
 	}
 	
-	read_empire_territory(emp, FALSE);
 	save_empire(emp);
 }
 
@@ -1355,7 +1377,6 @@ void found_city(char_data *ch, char *argument) {
 	stop_room_action(IN_ROOM(ch), ACT_HARVESTING, NOTHING);
 	stop_room_action(IN_ROOM(ch), ACT_PLANTING, NOTHING);
 	
-	read_empire_territory(emp, FALSE);
 	save_empire(emp);
 }
 
@@ -1404,6 +1425,61 @@ bool is_in_city_for_empire(room_data *loc, empire_data *emp, bool check_wait, bo
 }
 
 
+/**
+* Takes an empire's territory around a city out of (or back into) its city and
+* outside territory counts, including the island counts. Changing a city (or
+* its radius) only changes which count those tiles fall in, so calling this
+* with add=FALSE before the change and add=TRUE after it, with the same
+* location and radius, keeps the counts right without a full-world rescan.
+* There must be no claims or abandons between the two calls.
+*
+* @param empire_data *emp The empire that owns the city.
+* @param room_data *cityloc The city's location.
+* @param int radius The larger of the city's radius before and after the change.
+* @param bool add FALSE to remove the tiles from the counts, TRUE to add them back.
+*/
+void update_city_area_territory(empire_data *emp, room_data *cityloc, int radius, bool add) {
+	struct empire_island *eisle;
+	room_data *to_room;
+	int x, y, new_x, new_y, dist, max_dist;
+	int amount = add ? 1 : -1;
+	bool junk;
+	
+	if (!emp || !cityloc || GET_ROOM_VNUM(cityloc) >= MAP_SIZE) {
+		return;
+	}
+	
+	// tiles with a large city radius are in the city from 3x as far away
+	max_dist = 3 * radius;
+	
+	for (x = -1 * max_dist; x <= max_dist; ++x) {
+		for (y = -1 * max_dist; y <= max_dist; ++y) {
+			if (!get_coord_shift(FLAT_X_COORD(cityloc), FLAT_Y_COORD(cityloc), x, y, &new_x, &new_y)) {
+				continue;
+			}
+			// owned tiles are never unloaded, so there's no need to load any here
+			if (!(to_room = real_real_room(new_y * MAP_WIDTH + new_x)) || ROOM_OWNER(to_room) != emp || !COUNTS_AS_TERRITORY(to_room)) {
+				continue;
+			}
+			dist = compute_distance(cityloc, to_room);
+			if (dist > radius && (!LARGE_CITY_RADIUS(to_room) || dist > max_dist)) {
+				continue;
+			}
+			
+			eisle = get_empire_island(emp, GET_ISLAND_ID(to_room));
+			if (is_in_city_for_empire(to_room, emp, FALSE, &junk)) {
+				EMPIRE_CITY_TERRITORY(emp) += amount;
+				eisle->city_terr += amount;
+			}
+			else {
+				EMPIRE_OUTSIDE_TERRITORY(emp) += amount;
+				eisle->outside_terr += amount;
+			}
+		}
+	}
+}
+
+
 // for do_city
 void list_cities(char_data *ch, char *argument) {
 	extern int count_city_points_used(empire_data *emp);
@@ -1475,11 +1551,13 @@ void perform_abandon_city(empire_data *emp, struct empire_city_data *city, bool
 	if (IS_CITY_CENTER(cityloc)) {
 		disassociate_building(cityloc);
 	}
+	update_city_area_territory(emp, cityloc, radius, FALSE);
 	REMOVE_FROM_LIST(city, EMPIRE_CITY_LIST(emp), next);
 	if (city->name) {
 		free(city->name);
 	}
 	free(city);
+	update_city_area_territory(emp, cityloc, radius, TRUE);
 	
 	if (full_abandon) {
 		// abandon the radius
@@ -1550,6 +1628,7 @@ void rename_city(char_data *ch, char *argument) {
 void upgrade_city(char_data *ch, char *argument) {	
 	empire_data *emp = GET_LOYALTY(ch);
 	struct empire_city_data *city;
+	int radius;
 	
 	skip_spaces(&argument);
 	
@@ -1575,10 +1654,12 @@ void upgrade_city(char_data *ch, char *argument) {
 		return;
 	}
 	
+	radius = city_type[city->type+1].radius;	// the new, larger radius
+	update_city_area_territory(emp, city->location, radius, FALSE);
 	city->type++;
+	update_city_area_territory(emp, city->location, radius, TRUE);
 	
 	log_to_empire(emp, ELOG_TERRITORY, "%s has upgraded %s to a %s", PERS(ch, ch, 1), city->name, city_type[city->type].name);
-	read_empire_territory(emp, FALSE);
 	save_empire(emp);
 }
 
@@ -2189,7 +2270,7 @@ bool extract_tavern_resources(room_data *room) {
 */
 void show_tavern_status(char_data *ch) {
 	empire_data *emp = GET_LOYALTY(ch);
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	bool found = FALSE;
 	
 	if (!emp) {
@@ -2198,7 +2279,7 @@ void show_tavern_status(char_data *ch) {
 	
 	msg_to_char(ch, "Your taverns:\r\n");
 	
-	for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = ter->next) {
+	HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
 		if (room_has_function_and_city_ok(ter->room, FNC_TAVERN)) {
 			found = TRUE;
 			
@@ -2547,7 +2628,7 @@ void do_abandon_vehicle(char_data *ch, vehicle_data *veh) {
 	else {
 		act("You abandon $V.", FALSE, ch, NULL, veh, TO_CHAR);
 		act("$n abandons $V.", FALSE, ch, NULL, veh, TO_ROOM);
-		VEH_OWNER(veh) = NULL;
+		set_vehicle_owner(veh, NULL);
 		
 		if (VEH_INTERIOR_HOME_ROOM(veh)) {
 			abandon_room(VEH_INTERIOR_HOME_ROOM(veh));
@@ -2898,7 +2979,7 @@ void do_claim_vehicle(char_data *ch, vehicle_data *veh) {
 	else {
 		send_config_msg(ch, "ok_string");
 		act("$n claims $V.", FALSE, ch, NULL, veh, TO_ROOM);
-		VEH_OWNER(veh) = emp;
+		set_vehicle_owner(veh, emp);
 		VEH_SHIPPING_ID(veh) = -1;
 		
 		if (VEH_INTERIOR_HOME_ROOM(veh)) {
@@ -3731,7 +3812,7 @@ ACMD(do_enroll) {
 	struct empire_island *from_isle, *next_isle, *isle;
 	struct empire_territory_data *ter, *next_ter;
 	struct empire_npc_data *npc;
-	struct empire_storage_data *store, *store2;
+	struct empire_storage_data *store, *next_store;
 	struct empire_city_data *city, *next_city, *temp;
 	player_index_data *index, *next_index;
 	struct empire_unique_storage *eus;
@@ -3739,7 +3820,7 @@ ACMD(do_enroll) {
 	vehicle_data *veh, *next_veh;
 	empire_data *e, *old;
 	room_data *room, *next_room;
-	int old_store, iter;
+	int iter;
 	char_data *targ = NULL, *victim, *mob;
 	bool all_zero, file = FALSE, sub_file = FALSE;
 	obj_data *obj;
@@ -3871,7 +3952,7 @@ ACMD(do_enroll) {
 			// vehicles
 			LL_FOREACH_SAFE2(vehicle_list, veh, next_veh, next) {
 				if (VEH_OWNER(veh) == old) {
-					VEH_OWNER(veh) = e;
+					set_vehicle_owner(veh, e);
 				}
 				LL_FOREACH(VEH_ANIMALS(veh), vam) {
 					if (vam->empire == EMPIRE_VNUM(old)) {
@@ -3881,20 +3962,9 @@ ACMD(do_enroll) {
 			}
 
 			// storage
-			for (store = EMPIRE_STORAGE(old); store; store = store->next) {
-				if (!(store2 = find_stored_resource(e, store->island, store->vnum))) {
-					CREATE(store2, struct empire_storage_data, 1);
-					store2->next = EMPIRE_STORAGE(e);
-					EMPIRE_STORAGE(e) = store2;
-					store2->vnum = store->vnum;
-					store2->island = store->island;
-				}
-
-				old_store = store2->amount;
-				store2->amount += store->amount;
-				// bounds checking
-				if (store2->amount < old_store || store2->amount > MAX_STORAGE) {
-					store2->amount = MAX_STORAGE;
+			HASH_ITER(hh, EMPIRE_ISLANDS(old), from_isle, next_isle) {
+				HASH_ITER(hh, from_isle->store, store, next_store) {
+					add_to_empire_storage(e, store->island, store->vnum, store->amount);
 				}
 			}
 			
@@ -3922,7 +3992,8 @@ ACMD(do_enroll) {
 					REMOVE_FROM_LIST(city, EMPIRE_CITY_LIST(old), next);
 					city->next = NULL;
 					
-					// add to new empire
+					// add to new empire (its own land in range moves into the city)
+					update_city_area_territory(e, city->location, city_type[city->type].radius, FALSE);
 					if (EMPIRE_CITY_LIST(e)) {
 						temp = EMPIRE_CITY_LIST(e);
 						while (temp->next) {
@@ -3933,6 +4004,7 @@ ACMD(do_enroll) {
 					else {
 						EMPIRE_CITY_LIST(e) = city;
 					}
+					update_city_area_territory(e, city->location, city_type[city->type].radius, TRUE);
 				}
 				else {
 					// no room for this city
@@ -3941,21 +4013,17 @@ ACMD(do_enroll) {
 			}
 
 			// territory data
-			for (ter = EMPIRE_TERRITORY_LIST(old); ter; ter = next_ter) {
-				next_ter = ter->next;
-				
+			HASH_ITER(hh, EMPIRE_TERRITORY_LIST(old), ter, next_ter) {
 				// switch npc allegiance
 				for (npc = ter->npcs; npc; npc = npc->next) {
 					npc->empire_id = EMPIRE_VNUM(e);
 				}
 				
 				// move territory over
-				ter->next = EMPIRE_TERRITORY_LIST(e);
-				EMPIRE_TERRITORY_LIST(e) = ter;
+				HASH_DEL(EMPIRE_TERRITORY_LIST(old), ter);
+				HASH_ADD_INT(EMPIRE_TERRITORY_LIST(e), vnum, ter);
 			}
 			
-			EMPIRE_TERRITORY_LIST(old) = NULL;
-			
 			// move territory over
 			HASH_ITER(hh, world_table, room, next_room) {
 				if (ROOM_OWNER(room) == old) {
@@ -4240,7 +4308,7 @@ ACMD(do_findmaintenance) {
 	struct resource_data *old_res, *total_list = NULL;
 	struct island_info *find_island = NULL;
 	empire_data *emp = GET_LOYALTY(ch);
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	room_data *find_room = NULL;
 	int total = 0;
 	
@@ -4301,7 +4369,7 @@ ACMD(do_findmaintenance) {
 	}
 	
 	// check all the territory
-	LL_FOREACH(EMPIRE_TERRITORY_LIST(emp), ter) {
+	HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
 		// validate the tile
 		if (GET_ROOM_VNUM(ter->room) >= MAP_SIZE) {
 			continue;
@@ -4503,7 +4571,6 @@ ACMD(do_islands) {
 	struct do_islands_data *item, *next_item, *list = NULL;
 	struct empire_island *eisle, *next_eisle;
 	struct empire_unique_storage *eus;
-	struct empire_storage_data *store;
 	struct island_info *isle;
 	empire_data *emp;
 	room_data *room;
@@ -4544,8 +4611,10 @@ ACMD(do_islands) {
 	}
 	
 	// compute einv
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		do_islands_add_einv(&list, store->island, store->amount);
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), eisle, next_eisle) {
+		if (eisle->store_total > 0) {
+			do_islands_add_einv(&list, eisle->island, eisle->store_total);
+		}
 	}
 	
 	// add unique storage
@@ -457,11 +457,12 @@ void start_ritual(char_data *ch, int ritual) {
 * @param char *argument The typed arg.
 */
 void summon_materials(char_data *ch, char *argument) {
-	void sort_storage(empire_data *emp);
+	void sort_storage(struct empire_island *isle);
 	void read_vault(empire_data *emp);
 
 	char arg1[MAX_INPUT_LENGTH], arg2[MAX_INPUT_LENGTH], *objname;
 	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle;
 	int count = 0, total = 1, number, pos;
 	empire_data *emp;
 	int cost = 2;	// * number of things to summon
@@ -520,17 +521,11 @@ void summon_materials(char_data *ch, char *argument) {
 	act("$n opens a tiny portal to summon materials...", FALSE, ch, NULL, NULL, TO_ROOM);
 	
 	// sort first
-	sort_storage(emp);
+	isle = get_empire_island(emp, GET_ISLAND_ID(IN_ROOM(ch)));
+	sort_storage(isle);
 
 	pos = 0;
-	for (store = EMPIRE_STORAGE(emp); !found && store; store = next_store) {
-		next_store = store->next;
-		
-		// island check
-		if (store->island != GET_ISLAND_ID(IN_ROOM(ch))) {
-			continue;
-		}
-		
+	HASH_ITER(hh, isle->store, store, next_store) {
 		proto = obj_proto(store->vnum);
 		if (proto && multi_isname(objname, GET_OBJ_KEYWORDS(proto)) && (++pos == number)) {
 			found = TRUE;
@@ -548,6 +543,8 @@ void summon_materials(char_data *ch, char *argument) {
 					break;	// no more
 				}
 			}
+			
+			break;	// only 1
 		}
 	}
 	
@@ -1531,6 +1528,8 @@ RITUAL_FINISH_FUNC(perform_chant_of_illusions) {
 	
 	SET_BIT(ROOM_AFF_FLAGS(IN_ROOM(ch)), ROOM_AFF_CHAMELEON);
 	SET_BIT(ROOM_BASE_FLAGS(IN_ROOM(ch)), ROOM_AFF_CHAMELEON);
+	clear_map_render_cache(GET_ROOM_VNUM(IN_ROOM(ch)));
+	request_world_save(GET_ROOM_VNUM(IN_ROOM(ch)));
 	msg_to_char(ch, "As you finish the chant, the road is cloaked in illusion!\r\n");
 }
 
@@ -1811,6 +1810,8 @@ RITUAL_FINISH_FUNC(perform_ritual_of_defense) {
 	}
 	SET_BIT(ROOM_AFF_FLAGS(IN_ROOM(ch)), ROOM_AFF_NO_FLY);
 	SET_BIT(ROOM_BASE_FLAGS(IN_ROOM(ch)), ROOM_AFF_NO_FLY);
+	clear_map_render_cache(GET_ROOM_VNUM(IN_ROOM(ch)));
+	request_world_save(GET_ROOM_VNUM(IN_ROOM(ch)));
 }
 
 
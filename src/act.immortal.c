@@ -23,6 +23,7 @@
 #include "skills.h"
 #include "olc.h"
 #include "dg_scripts.h"
+#include "dg_event.h"
 
 /**
 * Contents:
@@ -333,7 +334,9 @@ bool users_output(char_data *to, char_data *tch, descriptor_data *d, char *name_
 
 ADMIN_UTIL(util_b318_buildings);
 ADMIN_UTIL(util_clear_roles);
+ADMIN_UTIL(util_cmdbench);
 ADMIN_UTIL(util_diminish);
+ADMIN_UTIL(util_eventbench);
 ADMIN_UTIL(util_islandsize);
 ADMIN_UTIL(util_playerdump);
 ADMIN_UTIL(util_randtest);
@@ -352,7 +355,9 @@ struct {
 } admin_utils[] = {
 	{ "b318buildings", LVL_CIMPL, util_b318_buildings },
 	{ "clearroles", LVL_CIMPL, util_clear_roles },
+	{ "cmdbench", LVL_CIMPL, util_cmdbench },
 	{ "diminish", LVL_START_IMM, util_diminish },
+	{ "eventbench", LVL_CIMPL, util_eventbench },
 	{ "islandsize", LVL_START_IMM, util_islandsize },
 	{ "playerdump", LVL_IMPL, util_playerdump },
 	{ "randtest", LVL_CIMPL, util_randtest },
@@ -436,6 +441,72 @@ ADMIN_UTIL(util_clear_roles) {
 }
 
 
+// checks and times find_command_for_char against a plain scan of cmd_info[], using every prefix of every command
+ADMIN_UTIL(util_cmdbench) {
+	extern const struct command_info cmd_info[];
+	
+	const int default_rounds = 20;
+	
+	unsigned long long start, index_time, scan_time;
+	int cmd, len, round, rounds, lookups, mismatches;
+	char prefix[MAX_INPUT_LENGTH];
+	
+	one_argument(argument, arg);
+	
+	if (*arg && !isdigit(*arg)) {
+		msg_to_char(ch, "Usage: cmdbench [rounds]\r\n");
+		return;
+	}
+	
+	rounds = *arg ? atoi(arg) : default_rounds;
+	if (rounds < 1 || rounds > 1000) {
+		msg_to_char(ch, "Invalid number of rounds.\r\n");
+		return;
+	}
+	
+	// check: both lookups must agree on every prefix
+	lookups = mismatches = 0;
+	for (cmd = 0; *cmd_info[cmd].command != '\n'; ++cmd) {
+		for (len = 1; len <= strlen(cmd_info[cmd].command) && len < MAX_INPUT_LENGTH; ++len) {
+			snprintf(prefix, len + 1, "%s", cmd_info[cmd].command);
+			++lookups;
+			if (find_command_for_char(ch, prefix) != find_command_for_char_by_scan(ch, prefix)) {
+				if (++mismatches <= 10) {
+					msg_to_char(ch, "Mismatch: '%s' finds %s (index) but %s (scan)\r\n", prefix, cmd_info[find_command_for_char(ch, prefix)].command, cmd_info[find_command_for_char_by_scan(ch, prefix)].command);
+				}
+			}
+		}
+	}
+	
+	// time: same prefixes, several rounds each
+	start = microtime();
+	for (round = 0; round < rounds; ++round) {
+		for (cmd = 0; *cmd_info[cmd].command != '\n'; ++cmd) {
+			for (len = 1; len <= strlen(cmd_info[cmd].command) && len < MAX_INPUT_LENGTH; ++len) {
+				snprintf(prefix, len + 1, "%s", cmd_info[cmd].command);
+				find_command_for_char(ch, prefix);
+			}
+		}
+	}
+	index_time = microtime() - start;
+	
+	start = microtime();
+	for (round = 0; round < rounds; ++round) {
+		for (cmd = 0; *cmd_info[cmd].command != '\n'; ++cmd) {
+			for (len = 1; len <= strlen(cmd_info[cmd].command) && len < MAX_INPUT_LENGTH; ++len) {
+				snprintf(prefix, len + 1, "%s", cmd_info[cmd].command);
+				find_command_for_char_by_scan(ch, prefix);
+			}
+		}
+	}
+	scan_time = microtime() - start;
+	
+	msg_to_char(ch, "Command lookups for %d prefixes: %d mismatch(es)\r\n", lookups, mismatches);
+	msg_to_char(ch, "Indexed: %.0f lookups/sec\r\n", (double) lookups * rounds * 1000000.0 / MAX(1, index_time));
+	msg_to_char(ch, "Scan: %.0f lookups/sec\r\n", (double) lookups * rounds * 1000000.0 / MAX(1, scan_time));
+}
+
+
 ADMIN_UTIL(util_diminish) {
 	double number, scale, result;
 	
@@ -470,6 +541,73 @@ int sort_isf_list(struct isf_type *a, struct isf_type *b) {
 	return a->island - b->island;
 }
 
+// times the DG event queue (dg_event.c) on a private queue, so live events are not affected
+ADMIN_UTIL(util_eventbench) {
+	const int default_num = 100000, max_delay = 3000, pulses = 3000;
+	
+	unsigned long long start, enq_time, cancel_time, dispatch_time;
+	struct q_element **elements;
+	int iter, num, pos, *ids;
+	long dispatched, pulse_iter;
+	struct queue *q;
+	
+	one_argument(argument, arg);
+	
+	if (*arg && !isdigit(*arg)) {
+		msg_to_char(ch, "Usage: eventbench [number of pending events]\r\n");
+		return;
+	}
+	
+	num = *arg ? atoi(arg) : default_num;
+	if (num < 1 || num > 1000000) {
+		msg_to_char(ch, "Invalid number of events.\r\n");
+		return;
+	}
+	
+	q = queue_init();
+	CREATE(elements, struct q_element*, num);
+	CREATE(ids, int, num);
+	
+	// fill the queue
+	start = microtime();
+	for (iter = 0; iter < num; ++iter) {
+		ids[iter] = iter;
+		elements[iter] = queue_enq(q, &ids[iter], number(1, max_delay));
+	}
+	enq_time = microtime() - start;
+	
+	// cancel and re-add random events, as when a script's wait is reset
+	start = microtime();
+	for (iter = 0; iter < num; ++iter) {
+		pos = number(0, num - 1);
+		queue_deq(q, elements[pos]);
+		elements[pos] = queue_enq(q, &ids[pos], number(1, max_delay));
+	}
+	cancel_time = microtime() - start;
+	
+	// run the queue for a while, re-adding every event that fires
+	dispatched = 0;
+	start = microtime();
+	for (pulse_iter = 1; pulse_iter <= pulses; ++pulse_iter) {
+		while (queue_key(q) <= pulse_iter) {
+			pos = *((int*) queue_head(q));
+			elements[pos] = queue_enq(q, &ids[pos], pulse_iter + number(1, max_delay));
+			++dispatched;
+		}
+	}
+	dispatch_time = microtime() - start;
+	
+	queue_free(q);
+	free(elements);
+	free(ids);
+	
+	msg_to_char(ch, "Event queue with %d pending events (delays 1-%d pulses):\r\n", num, max_delay);
+	msg_to_char(ch, "Enqueue: %.3f us/op\r\n", (double) enq_time / num);
+	msg_to_char(ch, "Cancel and re-enqueue: %.3f us/op\r\n", (double) cancel_time / num);
+	msg_to_char(ch, "Dispatch %d pulses: %.3f sec (%ld events fired and re-enqueued)\r\n", pulses, dispatch_time / 1000000.0, dispatched);
+}
+
+
 ADMIN_UTIL(util_islandsize) {
 	struct isf_type *isf, *next_isf, *list = NULL;
 	char buf[MAX_STRING_LENGTH];
@@ -2007,8 +2145,8 @@ struct show_island_data *find_or_make_show_island(int island, struct show_island
 
 
 SHOW(show_islands) {
+	struct empire_island *eisle, *next_eisle;
 	struct empire_unique_storage *uniq;
-	struct empire_storage_data *store;
 	char arg[MAX_INPUT_LENGTH];
 	struct island_info *isle;
 	empire_data *emp;
@@ -2027,11 +2165,11 @@ SHOW(show_islands) {
 		msg_to_char(ch, "Island storage counts for %s%s&0:\r\n", EMPIRE_BANNER(emp), EMPIRE_NAME(emp));
 		
 		// collate storage info
-		for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-			if (!cur || cur->island != store->island) {
-				cur = find_or_make_show_island(store->island, &list);
+		HASH_ITER(hh, EMPIRE_ISLANDS(emp), eisle, next_eisle) {
+			if (eisle->store_total > 0) {
+				cur = find_or_make_show_island(eisle->island, &list);
+				SAFE_ADD(cur->count, eisle->store_total, INT_MIN, INT_MAX, TRUE);
 			}
-			SAFE_ADD(cur->count, store->amount, INT_MIN, INT_MAX, TRUE);
 		}
 		for (uniq = EMPIRE_UNIQUE_STORAGE(emp); uniq; uniq = uniq->next) {
 			if (!cur || cur->island != uniq->island) {
@@ -2209,6 +2347,7 @@ SHOW(show_rent) {
 SHOW(show_stats) {
 	void update_account_stats();
 	extern int buf_switches, buf_largecount, buf_overflows;
+	extern int evos_per_hour, evos_behind;
 	extern int total_accounts, active_accounts, active_accounts_week;
 	
 	int num_active_empires = 0, num_objs = 0, num_mobs = 0, num_vehs = 0, num_players = 0, num_descs = 0, menu_count = 0;
@@ -2275,6 +2414,7 @@ SHOW(show_stats) {
 	msg_to_char(ch, "  %6d socials\r\n", HASH_COUNT(social_table));
 	msg_to_char(ch, "  %6d large bufs       %6d buf switches\r\n", buf_largecount, buf_switches);
 	msg_to_char(ch, "  %6d overflows\r\n", buf_overflows);
+	msg_to_char(ch, "  %6d evos per hour    %6d evos behind\r\n", evos_per_hour, evos_behind);
 }
 
 
@@ -2480,14 +2620,16 @@ SHOW(show_players) {
 SHOW(show_terrain) {
 	extern int stats_get_crop_count(crop_data *cp);
 	extern int stats_get_sector_count(sector_data *sect);
-	void update_world_count();
+	extern int update_world_count(bool verify);
 	
 	sector_data *sect, *next_sect;
 	crop_data *crop, *next_crop;
-	int count, total, this;
+	int count, total, this, errors;
 	
-	// fresh numbers
-	update_world_count();
+	// check the live numbers against the map
+	if ((errors = update_world_count(TRUE)) > 0) {
+		msg_to_char(ch, "Warning: %d world stat%s had drifted from the map and were corrected (see syslog).\r\n", errors, PLURAL(errors));
+	}
 	
 	// output
 	total = count = 0;
@@ -5932,17 +6074,31 @@ ACMD(do_load) {
 
 ACMD(do_mapout) {
 	void output_map_to_file(void);
-
-	msg_to_char(ch, "Writing map output file...\r\n");
-	output_map_to_file();
-	msg_to_char(ch, "Done.\r\n");
+	void write_world_map_text_file(void);
+	
+	skip_spaces(&argument);
+	
+	if (!*argument) {
+		msg_to_char(ch, "Writing map output file...\r\n");
+		output_map_to_file();
+		msg_to_char(ch, "Done.\r\n");
+	}
+	else if (is_abbrev(argument, "basemap")) {
+		msg_to_char(ch, "Writing text base map file...\r\n");
+		write_world_map_text_file();
+		msg_to_char(ch, "Done.\r\n");
+	}
+	else {
+		msg_to_char(ch, "Usage: mapout [basemap]\r\n");
+	}
 }
 
 
 ACMD(do_moveeinv) {
 	char arg1[MAX_INPUT_LENGTH], arg2[MAX_INPUT_LENGTH], arg3[MAX_INPUT_LENGTH];
 	struct empire_unique_storage *unique;
-	struct empire_storage_data *store, *next_store, *temp;
+	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle;
 	int island_from, island_to, count;
 	empire_data *emp;
 	
@@ -5963,16 +6119,12 @@ ACMD(do_moveeinv) {
 	}
 	else {
 		count = 0;
-		for (store = EMPIRE_STORAGE(emp); store; store = next_store) {
-			next_store = store->next;
-			
-			if (store->island == island_from) {
-				add_to_empire_storage(emp, island_to, store->vnum, store->amount);
-				store->island = island_to;
+		HASH_FIND_INT(EMPIRE_ISLANDS(emp), &island_from, isle);
+		if (isle && island_from != island_to) {
+			HASH_ITER(hh, isle->store, store, next_store) {
 				count += store->amount;
-				
-				REMOVE_FROM_LIST(store, EMPIRE_STORAGE(emp), next);
-				free(store);
+				add_to_empire_storage(emp, island_to, store->vnum, store->amount);
+				add_to_empire_storage(emp, island_from, store->vnum, -store->amount);
 			}
 		}
 		for (unique = EMPIRE_UNIQUE_STORAGE(emp); unique; unique = unique->next) {
@@ -1219,9 +1219,13 @@ char *get_obj_desc(obj_data *obj, char_data *ch, int mode) {
 * @return bool TRUE if any items were shown at all, otherwise FALSE
 */
 bool inventory_store_building(char_data *ch, room_data *room, empire_data *emp) {
+	void sort_storage(struct empire_island *isle);
+	
+	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle;
 	bool found = FALSE;
-	struct empire_storage_data *store;
 	obj_data *proto;
+	int island_id = GET_ISLAND_ID(room);
 
 	/* Must be in an empire */
 	if (!emp) {
@@ -1231,13 +1235,15 @@ bool inventory_store_building(char_data *ch, room_data *room, empire_data *emp)
 	if (room_has_function_and_city_ok(IN_ROOM(ch), FNC_VAULT)) {
 		msg_to_char(ch, "\r\nVault: %.1f coin%s, %d treasure (%d total)\r\n", EMPIRE_COINS(emp), (EMPIRE_COINS(emp) != 1.0 ? "s" : ""), EMPIRE_WEALTH(emp), (int) GET_TOTAL_WEALTH(emp));
 	}
-
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		// things not stored here
-		if (store->island != GET_ISLAND_ID(room)) {
-			continue;
-		}
-		
+	
+	// things not stored on this island
+	HASH_FIND_INT(EMPIRE_ISLANDS(emp), &island_id, isle);
+	if (!isle) {
+		return found;
+	}
+	
+	sort_storage(isle);
+	HASH_ITER(hh, isle->store, store, next_store) {
 		if ((proto = obj_proto(store->vnum))) {
 			if (obj_can_be_stored(proto, room)) {
 				if (!found) {
@@ -2075,13 +2075,13 @@ void deliver_shipment(empire_data *emp, struct shipping_data *shipd) {
 * @return room_data* The found docks room, or NULL for none.
 */
 room_data *find_docks(empire_data *emp, int island_id) {
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	
 	if (!emp || island_id == NO_ISLAND) {
 		return NULL;
 	}
 	
-	for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = ter->next) {
+	HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
 		if (GET_ISLAND_ID(ter->room) != island_id) {
 			continue;
 		}
@@ -2107,7 +2107,7 @@ room_data *find_docks(empire_data *emp, int island_id) {
 * @return vehicle_data* A ship, or NULL if none.
 */
 vehicle_data *find_free_ship(empire_data *emp, struct shipping_data *shipd) {
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	struct shipping_data *iter;
 	bool already_used;
 	vehicle_data *veh;
@@ -2117,7 +2117,7 @@ vehicle_data *find_free_ship(empire_data *emp, struct shipping_data *shipd) {
 		return NULL;
 	}
 	
-	for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = ter->next) {
+	HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
 		if (GET_ISLAND_ID(ter->room) != shipd->from_island) {
 			continue;
 		}
@@ -2210,6 +2210,7 @@ int find_free_shipping_id(empire_data *emp) {
 * @return vehicle_data* The found ship, or NULL.
 */
 vehicle_data *find_ship_by_shipping_id(empire_data *emp, int shipping_id) {
+	struct empire_vehicle_index *vidx, *next_vidx;
 	vehicle_data *veh;
 	
 	// shortcut
@@ -2217,9 +2218,11 @@ vehicle_data *find_ship_by_shipping_id(empire_data *emp, int shipping_id) {
 		return NULL;
 	}
 	
-	LL_FOREACH(vehicle_list, veh) {
-		if (VEH_OWNER(veh) == emp && VEH_SHIPPING_ID(veh) == shipping_id) {
-			return veh;
+	HASH_ITER(hh, EMPIRE_VEHICLE_INDEX(emp), vidx, next_vidx) {
+		DL_FOREACH2(vidx->vehicles, veh, next_owned) {
+			if (VEH_SHIPPING_ID(veh) == shipping_id) {
+				return veh;
+			}
 		}
 	}
 	
@@ -4951,7 +4954,11 @@ ACMD(do_remove) {
 
 
 ACMD(do_retrieve) {	
+	void sort_storage(struct empire_island *isle);
+	
 	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle;
+	int island_id = GET_ISLAND_ID(IN_ROOM(ch));
 	obj_data *objn;
 	int count = 0, total = 1, number, pos;
 	empire_data *emp, *room_emp = ROOM_OWNER(IN_ROOM(ch));
@@ -5012,17 +5019,20 @@ ACMD(do_retrieve) {
 		msg_to_char(ch, "What would you like to retrieve?\r\n");
 		return;
 	}
+	
+	// only this island's storage
+	HASH_FIND_INT(EMPIRE_ISLANDS(emp), &island_id, isle);
+	if (!isle) {
+		msg_to_char(ch, "%s\r\n", str_cmp(objname, "all") ? "Nothing like that is stored here!" : "There is nothing stored here!");
+		return;
+	}
+	
+	// same order as shown in the building's inventory
+	sort_storage(isle);
 
 	/* they hit "ret all" */
 	if (!str_cmp(objname, "all")) {
-		for (store = EMPIRE_STORAGE(emp); store; store = next_store) {
-			next_store = store->next;
-			
-			// same island?
-			if (store->island != GET_ISLAND_ID(IN_ROOM(ch))) {
-				continue;
-			}
-
+		HASH_ITER(hh, isle->store, store, next_store) {
 			if ((objn = obj_proto(store->vnum)) && obj_can_be_stored(objn, IN_ROOM(ch))) {
 				if (stored_item_requires_withdraw(objn) && !has_permission(ch, PRIV_WITHDRAW)) {
 					msg_to_char(ch, "You don't have permission to withdraw that!\r\n");
@@ -5042,14 +5052,7 @@ ACMD(do_retrieve) {
 	}
 	else {	// not "all"
 		pos = 0;
-		for (store = EMPIRE_STORAGE(emp); store && !found; store = next_store) {
-			next_store = store->next;
-			
-			// island check
-			if (store->island != GET_ISLAND_ID(IN_ROOM(ch))) {
-				continue;
-			}
-			
+		HASH_ITER(hh, isle->store, store, next_store) {
 			if ((objn = obj_proto(store->vnum)) && obj_can_be_stored(objn, IN_ROOM(ch))) {
 				if (multi_isname(objname, GET_OBJ_KEYWORDS(objn)) && (++pos == number)) {
 					found = 1;
@@ -5067,6 +5070,8 @@ ACMD(do_retrieve) {
 							}
 						}
 					}
+					
+					break;	// only 1
 				}
 			}
 		}
@@ -5086,9 +5091,8 @@ ACMD(do_retrieve) {
 			remove_room_extra_data(IN_ROOM(ch), ROOM_EXTRA_CEDED);
 		}
 
-		/* save the empire */
+		// save the player; the storage change itself is journaled
 		SAVE_CHAR(ch);
-		EMPIRE_NEEDS_SAVE(emp) = TRUE;
 		read_vault(emp);
 	}
 }
@@ -5556,9 +5560,8 @@ ACMD(do_store) {
 			remove_room_extra_data(IN_ROOM(ch), ROOM_EXTRA_CEDED);
 		}
 
-		/* save the empire */
+		// save the player; the storage change itself is journaled
 		SAVE_CHAR(ch);
-		EMPIRE_NEEDS_SAVE(emp) = TRUE;
 		read_vault(emp);
 	}
 }
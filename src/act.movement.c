@@ -67,6 +67,12 @@ const int flags_door[] = {
 //// HELPERS /////////////////////////////////////////////////////////////////
 
 /**
+* Lays tracks in a room. Each player (or mob vnum) keeps at most one track per
+* room, which is refreshed and moved to the front when they pass through
+* again. Expired tracks are dropped here too, and once a room holds
+* MAX_TRACKS_PER_ROOM tracks, the oldest one is reused for the new track
+* rather than allocating another.
+*
 * @param char_data *ch the person leaving tracks
 * @param room_data *room the location of the tracks
 * @param byte dir the direction the person went
@@ -75,7 +81,10 @@ void add_tracks(char_data *ch, room_data *room, byte dir) {
 	extern bool valid_no_trace(room_data *room);
 	extern bool valid_unseen_passing(room_data *room);
 	
-	struct track_data *track;
+	struct track_data *track, *iter, *next_iter, *last, *temp;
+	int player_id, count;
+	mob_vnum mob_num;
+	time_t now;
 	
 	if (!IS_IMMORTAL(ch) && !ROOM_SECT_FLAGGED(room, SECTF_FRESH_WATER | SECTF_FRESH_WATER)) {
 		if (!IS_NPC(ch) && has_ability(ch, ABIL_NO_TRACE) && valid_no_trace(room)) {
@@ -85,20 +94,47 @@ void add_tracks(char_data *ch, room_data *room, byte dir) {
 			gain_ability_exp(ch, ABIL_UNSEEN_PASSING, 5);
 		}
 		else {
-			CREATE(track, struct track_data, 1);
-		
-			track->timestamp = time(0);
-			track->dir = dir;
-		
-			if (IS_NPC(ch)) {
-				track->mob_num = GET_MOB_VNUM(ch);
-				track->player_id = NOTHING;
+			now = time(0);
+			player_id = IS_NPC(ch) ? NOTHING : GET_IDNUM(ch);
+			mob_num = IS_NPC(ch) ? GET_MOB_VNUM(ch) : NOTHING;
+			
+			// find an existing track to refresh, dropping expired ones and counting the rest
+			track = last = NULL;
+			count = 0;
+			for (iter = ROOM_TRACKS(room); iter; iter = next_iter) {
+				next_iter = iter->next;
+				
+				if (now - iter->timestamp > CONFIG_INT(CFG_TRACKS_LIFESPAN) * SECS_PER_REAL_MIN) {
+					REMOVE_FROM_LIST(iter, ROOM_TRACKS(room), next);
+					free(iter);
+				}
+				else if (!track && iter->player_id == player_id && iter->mob_num == mob_num) {
+					track = iter;
+				}
+				else {
+					++count;
+					last = iter;
+				}
+			}
+			
+			if (track) {
+				// refresh
+				REMOVE_FROM_LIST(track, ROOM_TRACKS(room), next);
+			}
+			else if (count >= MAX_TRACKS_PER_ROOM && last) {
+				// full: reuse the oldest (tracks are kept newest-first)
+				REMOVE_FROM_LIST(last, ROOM_TRACKS(room), next);
+				track = last;
 			}
 			else {
-				track->mob_num = NOTHING;
-				track->player_id = GET_IDNUM(ch);
+				CREATE(track, struct track_data, 1);
 			}
 			
+			track->timestamp = now;
+			track->dir = dir;
+			track->mob_num = mob_num;
+			track->player_id = player_id;
+			
 			track->next = ROOM_TRACKS(room);
 			ROOM_TRACKS(room) = track;
 		}
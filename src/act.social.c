@@ -77,15 +77,28 @@ bool check_social(char_data *ch, char *string, bool exact) {
 * @return social_data* The social, or NULL if no match.
 */
 social_data *find_social(char_data *ch, char *name, bool exact) {
-	social_data *soc, *next_soc, *found = NULL;
-	int num_found = 0;
+	social_data *soc, *found = NULL;
+	int num_found = 0, lo, hi, mid, pos;
 	
-	HASH_ITER(sorted_hh, sorted_socials, soc, next_soc) {
-		if (LOWER(*SOC_COMMAND(soc)) < LOWER(*name)) {	// shortcut: check first letter
-			continue;
+	// binary search social_index for the first social >= name; any abbrev
+	// matches come right after it, in the same order as sorted_socials
+	lo = 0;
+	hi = social_index_size;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (str_cmp(NULLSAFE(SOC_COMMAND(social_index[mid])), name) < 0) {
+			lo = mid + 1;
 		}
-		if (LOWER(*SOC_COMMAND(soc)) > LOWER(*name)) {	// short exit: past the right letter
-			break;
+		else {
+			hi = mid;
+		}
+	}
+	
+	for (pos = lo; pos < social_index_size; ++pos) {
+		soc = social_index[pos];
+		
+		if (!is_abbrev(name, NULLSAFE(SOC_COMMAND(soc)))) {
+			break;	// past the matches
 		}
 		if (SOCIAL_FLAGGED(soc, SOC_IN_DEVELOPMENT) && !IS_IMMORTAL(ch)) {
 			continue;
@@ -93,9 +106,6 @@ social_data *find_social(char_data *ch, char *name, bool exact) {
 		if (exact && str_cmp(name, SOC_COMMAND(soc))) {
 			continue;
 		}
-		if (!exact && !is_abbrev(name, SOC_COMMAND(soc))) {
-			continue;
-		}
 		if (!validate_social_requirements(ch, soc)) {
 			continue;
 		}
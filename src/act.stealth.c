@@ -1706,11 +1706,17 @@ ACMD(do_steal) {
 	
 	struct empire_storage_data *store, *next_store;
 	empire_data *emp = ROOM_OWNER(HOME_ROOM(IN_ROOM(ch)));
+	int island_id = GET_ISLAND_ID(IN_ROOM(ch));
+	struct empire_island *isle = NULL;
 	obj_data *proto;
 	bool found = FALSE;
 	
 	one_argument(argument, arg);
 	
+	if (emp) {
+		HASH_FIND_INT(EMPIRE_ISLANDS(emp), &island_id, isle);
+	}
+	
 	if (IS_NPC(ch)) {
 		msg_to_char(ch, "NPCs cannot steal.\r\n");
 	}
@@ -1734,15 +1740,11 @@ ACMD(do_steal) {
 			msg_to_char(ch, "Nothing is stored here.\r\n");
 		}
 	}
+	else if (!isle) {
+		msg_to_char(ch, "Nothing like that is stored here!\r\n");
+	}
 	else {
-		for (store = EMPIRE_STORAGE(emp); store && !found; store = next_store) {
-			next_store = store->next;
-			
-			// island check
-			if (store->island != GET_ISLAND_ID(IN_ROOM(ch))) {
-				continue;
-			}
-			
+		HASH_ITER(hh, isle->store, store, next_store) {
 			proto = obj_proto(store->vnum);
 			
 			if (proto && obj_can_be_stored(proto, IN_ROOM(ch)) && isname(arg, GET_OBJ_KEYWORDS(proto))) {
@@ -1774,6 +1776,8 @@ ACMD(do_steal) {
 				
 					GET_WAIT_STATE(ch) = 4 RL_SEC;	// long wait
 				}
+				
+				break;	// only 1
 			}
 		}
 
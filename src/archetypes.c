@@ -703,14 +703,18 @@ void add_archetype_to_table(archetype_data *arch) {
 		HASH_FIND_INT(archetype_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(archetype_table, vnum, arch);
-			HASH_SORT(archetype_table, sort_archetypes);
+			if (!defer_table_sorts) {
+				HASH_SORT(archetype_table, sort_archetypes);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_archetypes, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_archetypes, vnum, sizeof(int), arch);
-			HASH_SRT(sorted_hh, sorted_archetypes, sort_archetypes_by_data);
+			if (!defer_table_sorts) {
+				HASH_SRT(sorted_hh, sorted_archetypes, sort_archetypes_by_data);
+			}
 		}
 	}
 }
@@ -321,14 +321,18 @@ void add_augment_to_table(augment_data *aug) {
 		HASH_FIND_INT(augment_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(augment_table, vnum, aug);
-			HASH_SORT(augment_table, sort_augments);
+			if (!defer_table_sorts) {
+				HASH_SORT(augment_table, sort_augments);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_augments, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_augments, vnum, sizeof(int), aug);
-			HASH_SRT(sorted_hh, sorted_augments, sort_augments_by_data);
+			if (!defer_table_sorts) {
+				HASH_SRT(sorted_hh, sorted_augments, sort_augments_by_data);
+			}
 		}
 	}
 }
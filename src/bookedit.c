@@ -74,7 +74,9 @@ void add_book_to_table(book_data *book) {
 		HASH_FIND_INT(book_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(book_table, vnum, book);
-			HASH_SORT(book_table, sort_book_table);
+			if (!defer_table_sorts) {
+				HASH_SORT(book_table, sort_book_table);
+			}
 		}
 	}
 }
@@ -153,6 +153,8 @@ void complete_building(room_data *room) {
 	// remove incomplete
 	REMOVE_BIT(ROOM_AFF_FLAGS(room), ROOM_AFF_INCOMPLETE);
 	REMOVE_BIT(ROOM_BASE_FLAGS(room), ROOM_AFF_INCOMPLETE);
+	clear_map_render_cache(GET_ROOM_VNUM(room));	// neighboring barriers may change
+	request_world_save(GET_ROOM_VNUM(room));
 	
 	complete_wtrigger(room);
 	
@@ -1050,6 +1052,8 @@ void start_dismantle_building(room_data *loc) {
 
 	SET_BIT(ROOM_AFF_FLAGS(loc), ROOM_AFF_DISMANTLING);
 	SET_BIT(ROOM_BASE_FLAGS(loc), ROOM_AFF_DISMANTLING);
+	clear_map_render_cache(GET_ROOM_VNUM(loc));
+	request_world_save(GET_ROOM_VNUM(loc));
 	delete_room_npcs(loc, NULL);
 	
 	if (loc && ROOM_OWNER(loc) && GET_BUILDING(loc) && complete) {
@@ -649,14 +649,18 @@ void add_class_to_table(class_data *cls) {
 		HASH_FIND_INT(class_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(class_table, vnum, cls);
-			HASH_SORT(class_table, sort_classes);
+			if (!defer_table_sorts) {
+				HASH_SORT(class_table, sort_classes);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_classes, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_classes, vnum, sizeof(int), cls);
-			HASH_SRT(sorted_hh, sorted_classes, sort_classes_by_data);
+			if (!defer_table_sorts) {
+				HASH_SRT(sorted_hh, sorted_classes, sort_classes_by_data);
+			}
 		}
 	}
 }
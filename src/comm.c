@@ -47,6 +47,14 @@
 #define INVALID_SOCKET -1
 #endif
 
+#ifdef HAVE_SYS_EPOLL_H
+#define EPOLL_MAX_EVENTS  64	// socket events handled per epoll_wait()
+#endif
+
+#ifdef USING_MCCP
+#define MCCP_CHUNK_SIZE  4096	// minimum room to make for deflate() output
+#endif
+
 // external vars
 extern struct ban_list_element *ban_list;
 extern bool data_table_needs_save;
@@ -64,6 +72,7 @@ extern char *help;
 
 // external functions
 void save_all_players();
+void save_player_index_file(bool force);
 extern char *flush_reduced_color_codes(descriptor_data *desc);
 void mobile_activity(void);
 void show_string(descriptor_data *d, char *input);
@@ -92,12 +101,16 @@ socket_t init_socket(ush_int port);
 ssize_t perform_socket_read(socket_t desc, char *read_point,size_t space_left);
 ssize_t perform_socket_write(socket_t desc, const char *txt,size_t length);
 static int process_output(descriptor_data *t);
+static ssize_t read_from_client(descriptor_data *d, char *read_point, size_t space_left);
+static void free_mccp(descriptor_data *d);
+static void reset_output_buffer(descriptor_data *t);
 struct in_addr *get_bind_addr(void);
 void empire_sleep(struct timeval *timeout);
 void flush_queues(descriptor_data *d);
 void game_loop(socket_t mother_desc);
 void heartbeat(int heart_pulse);
 void init_descriptor(descriptor_data *newd, int desc);
+void init_descriptor_polling(socket_t mother);
 void init_game(ush_int port);
 void nonblock(socket_t s);
 void perform_act(const char *orig, char_data *ch, const void *obj, const void *vict_obj, const char_data *to, bitvector_t act_flags);
@@ -132,6 +145,9 @@ unsigned long pulse = 0;	/* number of pulses since game start */
 static bool reboot_recovery = FALSE;
 int mother_desc;
 ush_int port;
+#ifdef HAVE_SYS_EPOLL_H
+static int epoll_desc = -1;	// watches the mother and player sockets, instead of select()
+#endif
 
 // vars to prevent running multiple cycles during a missed-pulse catch-up cycle
 bool catch_up_combat = FALSE;	// frequent_combat()
@@ -735,7 +751,7 @@ void perform_reboot(void) {
 		
 		// people not in-game get trimmed
 		if (!och || STATE(desc) != CON_PLAYING) {
-			write_to_descriptor(desc->descriptor, buf);
+			write_to_client(desc, buf);
 			close_socket(desc);
 			continue;
 		}
@@ -749,9 +765,9 @@ void perform_reboot(void) {
 		}
 		
 		// send output
-		write_to_descriptor(desc->descriptor, buf);
+		write_to_client(desc, buf);
 		if (reboot_control.type == SCMD_REBOOT) {
-			write_to_descriptor(desc->descriptor, reboot_strings[number(0, num_of_reboot_strings - 1)]);
+			write_to_client(desc, reboot_strings[number(0, num_of_reboot_strings - 1)]);
 		}
 		
 		SAVE_CHAR(och);
@@ -894,15 +910,17 @@ void heartbeat(int heart_pulse) {
 	void reduce_city_overages();
 	void reduce_outside_territory();
 	void reduce_stale_empires();
+	void request_whole_world_save();
 	void reset_instances();
-	void run_map_evolutions();
 	void run_mob_echoes();
 	void sanity_check();
 	void save_data_table(bool force);
 	void save_marked_empires();
+	void save_world_blocks(int max_blocks);
 	void update_actions();
 	void update_empire_npc_data();
 	void update_guard_towers();
+	void update_map_evolutions();
 	void update_players_online_stats();
 	void update_trading_post();
 	void update_world();
@@ -933,6 +951,8 @@ void heartbeat(int heart_pulse) {
 		if (debug_log && HEARTBEAT(15)) { log("debug  3:\t%lld", microtime()); }
 		check_expired_cooldowns();	// descriptor list
 		if (debug_log && HEARTBEAT(15)) { log("debug  4:\t%lld", microtime()); }
+		save_world_blocks(WORLD_BLOCK_SAVES_PER_SEC);
+		if (debug_log && HEARTBEAT(15)) { log("debug  4.5:\t%lld", microtime()); }
 	}
 
 	if (HEARTBEAT(3)) {
@@ -989,9 +1009,9 @@ void heartbeat(int heart_pulse) {
 		chore_update();
 		if (debug_log && HEARTBEAT(15)) { log("debug 14b:\t%lld", microtime()); }
 		
-		// save the world at dawn
+		// save the world at dawn (gradually, by save_world_blocks)
 		if (time_info.hours == 7) {
-			save_whole_world();
+			request_whole_world_save();
 			if (debug_log && HEARTBEAT(15)) { log("debug 14c:\t%lld", microtime()); }
 		}
 	}
@@ -1019,6 +1039,7 @@ void heartbeat(int heart_pulse) {
 		if (++mins_since_crashsave >= 5) {
 			mins_since_crashsave = 0;
 			save_all_players();
+			save_player_index_file(FALSE);
 			if (debug_log && HEARTBEAT(15)) { log("debug 19:\t%lld", microtime()); }
 		}
 	}
@@ -1059,11 +1080,12 @@ void heartbeat(int heart_pulse) {
 			process_imports();
 			if (debug_log && HEARTBEAT(15)) { log("debug 25:\t%lld", microtime()); }
 		}
-		// evos happen every hour
-		run_map_evolutions();
-		if (debug_log && HEARTBEAT(15)) { log("debug 26:\t%lld", microtime()); }
 	}
 	
+	// evos run a few at a time, every pulse
+	update_map_evolutions();
+	if (debug_log && HEARTBEAT(15)) { log("debug 26:\t%lld", microtime()); }
+	
 	if (HEARTBEAT(1)) {
 		if (data_table_needs_save) {
 			save_data_table(FALSE);
@@ -1594,8 +1616,12 @@ void close_socket(descriptor_data *d) {
 	descriptor_data *temp;
 
 	REMOVE_FROM_LIST(d, descriptor_list, next);
+#ifdef HAVE_SYS_EPOLL_H
+	epoll_ctl(epoll_desc, EPOLL_CTL_DEL, d->descriptor, NULL);
+#endif
 	CLOSE_SOCKET(d->descriptor);
 	flush_queues(d);
+	free_mccp(d);
 
 	/* Forget snooping */
 	if (d->snooping)
@@ -1733,6 +1759,9 @@ void close_socket(descriptor_data *d) {
 	if (d->olc_vehicle) {
 		free_vehicle(d->olc_vehicle);
 	}
+	if (d->output_builder) {
+		free(d->output_builder);
+	}
 	
 	free(d);
 }
@@ -1915,9 +1944,99 @@ void init_descriptor(descriptor_data *newd, int desc) {
 	} while (desc_num_in_use(last_desc) && last_desc != start);	// prevent infinite loop
 	
 	newd->desc_num = last_desc;
+	
+#ifdef HAVE_SYS_EPOLL_H
+	{
+		struct epoll_event ev;
+		
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN | EPOLLPRI;
+		ev.data.ptr = newd;
+		if (epoll_ctl(epoll_desc, EPOLL_CTL_ADD, desc, &ev) < 0) {
+			perror("SYSERR: epoll_ctl (init_descriptor)");
+		}
+	}
+#endif
 }
 
 
+/**
+* Sets up whatever game_loop() uses to wait on sockets. On systems with epoll,
+* this creates the epoll instance and adds the mother socket to it (player
+* sockets are added in init_descriptor). Otherwise, game_loop() uses select()
+* and this does nothing.
+*
+* @param socket_t mother The listening socket.
+*/
+void init_descriptor_polling(socket_t mother) {
+#ifdef HAVE_SYS_EPOLL_H
+	struct epoll_event ev;
+	
+#ifdef EPOLL_CLOEXEC
+	epoll_desc = epoll_create1(EPOLL_CLOEXEC);	// don't leak it through a reboot
+#else
+	epoll_desc = epoll_create(EPOLL_MAX_EVENTS);
+#endif
+	if (epoll_desc < 0) {
+		perror("SYSERR: epoll_create");
+		exit(1);
+	}
+	
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.ptr = NULL;	// NULL means the mother socket
+	if (epoll_ctl(epoll_desc, EPOLL_CTL_ADD, mother, &ev) < 0) {
+		perror("SYSERR: epoll_ctl (mother)");
+		exit(1);
+	}
+#endif
+}
+
+
+#ifdef HAVE_SYS_EPOLL_H
+/**
+* Sleeps until a socket has activity or the timeout passes, whichever comes
+* first. New connections are accepted and input is read right away, but only
+* for the sockets that had activity; commands still run on the pulse.
+*
+* @param socket_t mother The listening socket.
+* @param struct timeval *timeout The longest to wait.
+* @return bool FALSE if polling failed and the game should shut down.
+*/
+static bool poll_descriptors(socket_t mother, struct timeval *timeout) {
+	struct epoll_event events[EPOLL_MAX_EVENTS];
+	descriptor_data *d;
+	int count, iter, msec;
+	
+	// round up so a sub-millisecond remainder doesn't busy-loop
+	msec = timeout->tv_sec * 1000 + (timeout->tv_usec + 999) / 1000;
+	
+	if ((count = epoll_wait(epoll_desc, events, EPOLL_MAX_EVENTS, msec)) < 0) {
+		if (errno == EINTR) {
+			return TRUE;	// signal: just recalculate the timeout
+		}
+		perror("SYSERR: epoll_wait");
+		return FALSE;
+	}
+	
+	for (iter = 0; iter < count; ++iter) {
+		if (!(d = (descriptor_data*)events[iter].data.ptr)) {
+			new_descriptor(mother);
+		}
+		else if (events[iter].events & (EPOLLERR | EPOLLPRI)) {
+			// same as select()'s exception set: kick them out
+			close_socket(d);
+		}
+		else if (process_input(d) < 0) {
+			close_socket(d);
+		}
+	}
+	
+	return TRUE;
+}
+#endif
+
+
 /*
  * init_socket sets up the mother descriptor - creates the socket, sets
  * its options up, binds it, and listens.
@@ -2341,7 +2460,7 @@ int process_input(descriptor_data *t) {
 			}
 			
 			snprintf(buffer, sizeof(buffer), "Line too long. Truncated to:\r\n%s\r\n", t->inbuf);
-			if (write_to_descriptor(t->descriptor, buffer) < 0) {
+			if (write_to_client(t, buffer) < 0) {
 				return (-1);
 			}
 			
@@ -2349,7 +2468,7 @@ int process_input(descriptor_data *t) {
 			
 			// flush the rest of the input
 			do {
-				bytes_read = perform_socket_read(t->descriptor, read_buf, MAX_PROTOCOL_BUFFER);
+				bytes_read = read_from_client(t, read_buf, MAX_PROTOCOL_BUFFER);
 				if (bytes_read < 0) {
 					return -1;
 				}
@@ -2364,7 +2483,7 @@ int process_input(descriptor_data *t) {
 			*/
 		}
 
-		bytes_read = perform_socket_read(t->descriptor, read_buf, MAX_PROTOCOL_BUFFER);
+		bytes_read = read_from_client(t, read_buf, MAX_PROTOCOL_BUFFER);
 
 		if (bytes_read < 0) {	/* Error, disconnect them. */
 			return (-1);
@@ -2450,7 +2569,7 @@ int process_input(descriptor_data *t) {
 			char buffer[MAX_INPUT_LENGTH + 64];
 
 			sprintf(buffer, "Line too long. Truncated to:\r\n%s\r\n", tmp);
-			if (write_to_descriptor(t->descriptor, buffer) < 0)
+			if (write_to_client(t, buffer) < 0)
 				return (-1);
 		}
 		if (t->snoop_by && *input) {
@@ -2578,13 +2697,13 @@ static int process_output(descriptor_data *t) {
 	* CRLF, otherwise send the straight output sans CRLF. */
 	if (t->has_prompt && !t->data_left_to_write && !t->pProtocol->WriteOOB) {
 		t->has_prompt = FALSE;
-		result = write_to_descriptor(t->descriptor, i);
+		result = write_to_client(t, i);
 		if (result >= 2)
 			result -= 2;
 	}
 	else {
 		t->has_prompt = FALSE;
-		result = write_to_descriptor(t->descriptor, osb);
+		result = write_to_client(t, osb);
 	}
 
 	if (result < 0) {	/* Oops, fatal error. Bye! */
@@ -2610,18 +2729,7 @@ static int process_output(descriptor_data *t) {
 	
 	/* The common case: all saved output was handed off to the kernel buffer. */
 	if (result >= t->bufptr) {
-		/* If we were using a large buffer, put the large buffer on the buffer pool
-		* and switch back to the small one. */
-		if (t->large_outbuf) {
-			t->large_outbuf->next = bufpool;
-			bufpool = t->large_outbuf;
-			t->large_outbuf = NULL;
-			t->output = t->small_outbuf;
-		}
-		/* reset total bufspace back to that of a small buffer */
-		t->bufspace = SMALL_BUFSIZE - 1;
-		t->bufptr = 0;
-		*(t->output) = '\0';
+		reset_output_buffer(t);
 
 		/* If the overflow message or prompt were partially written, try to save
 		* them. There will be enough space for them if this is true.  'result'
@@ -2649,6 +2757,28 @@ static int process_output(descriptor_data *t) {
 }
 
 
+/**
+* Empties a descriptor's output buffer once everything in it has been sent,
+* returning its large buffer (if any) to the pool.
+*
+* @param descriptor_data *t The descriptor.
+*/
+static void reset_output_buffer(descriptor_data *t) {
+	/* If we were using a large buffer, put the large buffer on the buffer pool
+	* and switch back to the small one. */
+	if (t->large_outbuf) {
+		t->large_outbuf->next = bufpool;
+		bufpool = t->large_outbuf;
+		t->large_outbuf = NULL;
+		t->output = t->small_outbuf;
+	}
+	/* reset total bufspace back to that of a small buffer */
+	t->bufspace = SMALL_BUFSIZE - 1;
+	t->bufptr = 0;
+	*(t->output) = '\0';
+}
+
+
 /* Sets the kernel's send buffer size for the descriptor */
 int set_sendbuf(socket_t s) {
 #if defined(SO_SNDBUF)
@@ -2704,6 +2834,125 @@ int write_to_descriptor(socket_t desc, const char *txt) {
 }
 
 
+/**
+* Sends everything held in a descriptor's output builder to write_to_output(),
+* in pieces small enough that color codes can't overflow its buffer. Pieces
+* end on a newline when possible, and never in the middle of a color code.
+*
+* @param descriptor_data *d The descriptor whose output builder to send.
+*/
+static void send_output_builder(descriptor_data *d) {
+	char chunk[OUTPUT_BUILDER_CHUNK + 1];
+	size_t pos, end, iter;
+	int depth;
+	
+	if (!d->output_builder || d->output_builder_len == 0) {
+		return;
+	}
+	
+	// write_to_output would only hold it again otherwise
+	depth = d->output_builder_depth;
+	d->output_builder_depth = 0;
+	
+	for (pos = 0; pos < d->output_builder_len; pos = end) {
+		end = MIN(pos + OUTPUT_BUILDER_CHUNK, d->output_builder_len);
+		
+		if (end < d->output_builder_len) {
+			// prefer to break after a newline in the 2nd half of the chunk
+			for (iter = end; iter > pos + OUTPUT_BUILDER_CHUNK / 2 && d->output_builder[iter-1] != '\n'; --iter);
+			if (d->output_builder[iter-1] == '\n') {
+				end = iter;
+			}
+			else {
+				// don't split a \t[...] code
+				for (iter = end - 1; iter > pos && iter + 8 > end && d->output_builder[iter] != ']'; --iter) {
+					if (d->output_builder[iter] == '[' && d->output_builder[iter-1] == '\t' && iter - 1 > pos) {
+						end = iter - 1;
+						break;
+					}
+				}
+				// don't split an &x or \tx code
+				while (end > pos + 1 && (d->output_builder[end-1] == '&' || d->output_builder[end-1] == '\t')) {
+					--end;
+				}
+			}
+		}
+		
+		memcpy(chunk, d->output_builder + pos, end - pos);
+		chunk[end - pos] = '\0';
+		write_to_output(chunk, d);
+	}
+	
+	d->output_builder_len = 0;
+	*d->output_builder = '\0';
+	d->output_builder_depth = depth;
+}
+
+
+/**
+* Holds text for a descriptor's output builder (see start_output_builder).
+*
+* @param const char *txt The text to add.
+* @param descriptor_data *d The descriptor whose builder to add it to.
+*/
+static void add_to_output_builder(const char *txt, descriptor_data *d) {
+	size_t len = strlen(txt);
+	int depth;
+	
+	// more than the output buffer can hold anyway: send what we have so far
+	if (d->output_builder_len + len >= LARGE_BUFSIZE) {
+		send_output_builder(d);
+		if (len >= LARGE_BUFSIZE) {
+			depth = d->output_builder_depth;
+			d->output_builder_depth = 0;
+			write_to_output(txt, d);
+			d->output_builder_depth = depth;
+			return;
+		}
+	}
+	
+	if (d->output_builder_len + len + 1 > d->output_builder_size) {
+		d->output_builder_size = MAX(d->output_builder_size * 2, MAX_STRING_LENGTH);
+		while (d->output_builder_len + len + 1 > d->output_builder_size) {
+			d->output_builder_size *= 2;
+		}
+		RECREATE(d->output_builder, char, d->output_builder_size);
+	}
+	
+	strcpy(d->output_builder + d->output_builder_len, txt);
+	d->output_builder_len += len;
+}
+
+
+/**
+* Starts holding all output to the descriptor, so that a long run of small
+* messages (like the rows of the map) can be sent to write_to_output() in a
+* few large pieces instead of hundreds of tiny ones. Every call must be
+* matched by a call to flush_output_builder(); these may be nested, and the
+* output is only sent when the outermost one is flushed.
+*
+* @param descriptor_data *d The descriptor to hold output for (may be NULL).
+*/
+void start_output_builder(descriptor_data *d) {
+	if (d) {
+		++d->output_builder_depth;
+	}
+}
+
+
+/**
+* Ends a start_output_builder() call. If this was the outermost one, all the
+* held output is sent to the descriptor.
+*
+* @param descriptor_data *d The descriptor to flush (may be NULL).
+*/
+void flush_output_builder(descriptor_data *d) {
+	if (d && d->output_builder_depth > 0 && --d->output_builder_depth == 0) {
+		send_output_builder(d);
+	}
+}
+
+
 /* Add a new string to a player's output queue */
 void write_to_output(const char *txt, descriptor_data *t) {
 	const char *overflow_txt = "**OVERFLOW**\r\n";
@@ -2713,10 +2962,16 @@ void write_to_output(const char *txt, descriptor_data *t) {
 	/* if we're in the overflow state already, ignore this new output */
 	if (t->bufspace == 0)
 		return;
+	
+	// being held for one big write? (see start_output_builder)
+	if (t->output_builder_depth > 0) {
+		add_to_output_builder(txt, t);
+		return;
+	}
 
 	size = wantsize = strlen(txt);
-	strncpy(protocol_txt, ProtocolOutput(t, txt, &wantsize), MAX_STRING_LENGTH);
-	protocol_txt[MAX_STRING_LENGTH-1] = '\0';
+	// copies only the string, unlike strncpy which pads the whole buffer
+	snprintf(protocol_txt, sizeof(protocol_txt), "%s", ProtocolOutput(t, txt, &wantsize));
 	size = wantsize;
 	if (t->pProtocol->WriteOOB > 0) {
 		--t->pProtocol->WriteOOB;
@@ -2800,6 +3055,372 @@ void write_to_q(const char *txt, struct txt_q *queue, int aliased, bool add_to_h
 }
 
 
+ //////////////////////////////////////////////////////////////////////////////
+//// MCCP COMPRESSION ////////////////////////////////////////////////////////
+
+#ifdef USING_MCCP
+/**
+* Adds bytes to the end of a descriptor's pending MCCP output, which is sent
+* ahead of anything else written to that descriptor.
+*
+* @param descriptor_data *d The descriptor.
+* @param const char *data The bytes to add.
+* @param size_t length How many bytes to add.
+*/
+static void add_mccp_pending(descriptor_data *d, const char *data, size_t length) {
+	if (d->mccp_pending_len + length > d->mccp_pending_size) {
+		d->mccp_pending_size = MAX(d->mccp_pending_size * 2, d->mccp_pending_len + length);
+		RECREATE(d->mccp_pending, char, d->mccp_pending_size);
+	}
+	memcpy(d->mccp_pending + d->mccp_pending_len, data, length);
+	d->mccp_pending_len += length;
+}
+
+
+/**
+* Sends as much of a descriptor's pending MCCP output as the socket will take
+* without blocking.
+*
+* @param descriptor_data *d The descriptor.
+* @return int The number of bytes still pending, or -1 on a fatal error.
+*/
+static int flush_mccp_pending(descriptor_data *d) {
+	ssize_t written;
+	size_t pos = 0;
+	
+	while (pos < d->mccp_pending_len) {
+		written = perform_socket_write(d->descriptor, d->mccp_pending + pos, d->mccp_pending_len - pos);
+		if (written < 0) {
+			perror("SYSERR: Write to socket");
+			return (-1);
+		}
+		else if (written == 0) {
+			break;	// socket buffer full
+		}
+		pos += written;
+	}
+	
+	if (pos > 0) {
+		d->mccp_pending_len -= pos;
+		memmove(d->mccp_pending, d->mccp_pending + pos, d->mccp_pending_len);
+	}
+	return d->mccp_pending_len;
+}
+
+
+/**
+* Runs text through a descriptor's MCCP deflate stream, adding the compressed
+* bytes to its pending output.
+*
+* @param descriptor_data *d The descriptor, which must have mccp_out.
+* @param const char *txt The text to compress (may be NULL if length is 0).
+* @param size_t length How much of txt to compress.
+* @param int flush Z_SYNC_FLUSH to send everything so far, or Z_FINISH to end the stream.
+* @return bool TRUE on success, FALSE if zlib failed.
+*/
+static bool deflate_mccp(descriptor_data *d, const char *txt, size_t length, int flush) {
+	z_stream *zs = d->mccp_out;
+	int result;
+	
+	zs->next_in = (Bytef*)txt;
+	zs->avail_in = length;
+	
+	do {
+		if (d->mccp_pending_size - d->mccp_pending_len < MCCP_CHUNK_SIZE) {
+			d->mccp_pending_size += MCCP_CHUNK_SIZE;
+			RECREATE(d->mccp_pending, char, d->mccp_pending_size);
+		}
+		
+		zs->next_out = (Bytef*)(d->mccp_pending + d->mccp_pending_len);
+		zs->avail_out = d->mccp_pending_size - d->mccp_pending_len;
+		result = deflate(zs, flush);
+		d->mccp_pending_len = d->mccp_pending_size - zs->avail_out;
+		
+		if (result == Z_STREAM_ERROR) {
+			log("SYSERR: deflate() failed for MCCP on descriptor %d", d->descriptor);
+			return FALSE;
+		}
+	} while (zs->avail_out == 0);
+	
+	return TRUE;
+}
+
+
+/**
+* Turns on MCCP2 output compression for a descriptor: anything already queued
+* goes out plain, followed by IAC SB MCCP2 IAC SE, and then everything after
+* that is compressed. The level is the mccp_compression_level config (0 or an
+* invalid value uses zlib's default).
+*
+* @param descriptor_data *d The descriptor.
+* @return bool TRUE if compression started, FALSE if it couldn't.
+*/
+bool start_mccp_output(descriptor_data *d) {
+	static const char start_seq[] = { (char)IAC, (char)SB, (char)TELOPT_MCCP, (char)IAC, (char)SE, '\0' };
+	z_stream *zs;
+	int level;
+	
+	if (d->mccp_out) {
+		return TRUE;	// already on
+	}
+	
+	level = config_get_int("mccp_compression_level");
+	if (level < Z_BEST_SPEED || level > Z_BEST_COMPRESSION) {
+		level = Z_DEFAULT_COMPRESSION;
+	}
+	
+	CREATE(zs, z_stream, 1);	// zeroed: default zalloc/zfree
+	if (deflateInit(zs, level) != Z_OK) {
+		log("SYSERR: deflateInit() failed for MCCP on descriptor %d", d->descriptor);
+		free(zs);
+		return FALSE;
+	}
+	
+	// anything already queued was written before the client asked for compression
+	if (*(d->output)) {
+		add_mccp_pending(d, d->output, strlen(d->output));
+		reset_output_buffer(d);
+	}
+	add_mccp_pending(d, start_seq, strlen(start_seq));
+	d->mccp_out = zs;
+	
+	flush_mccp_pending(d);	// errors show up on the next write
+	return TRUE;
+}
+
+
+/**
+* Turns off MCCP2 output compression for a descriptor, finishing the stream so
+* the client knows to go back to plain text.
+*
+* @param descriptor_data *d The descriptor.
+*/
+void end_mccp_output(descriptor_data *d) {
+	if (!d->mccp_out) {
+		return;
+	}
+	
+	deflate_mccp(d, NULL, 0, Z_FINISH);
+	deflateEnd(d->mccp_out);
+	free(d->mccp_out);
+	d->mccp_out = NULL;
+	
+	flush_mccp_pending(d);
+}
+
+
+/**
+* Turns on MCCP3 input decompression for a descriptor, after the client sent
+* IAC SB MCCP3 IAC SE.
+*
+* @param descriptor_data *d The descriptor.
+* @param const char *data Compressed input that arrived with the start sequence.
+* @param size_t length How much data there is (at most MAX_PROTOCOL_BUFFER).
+* @return bool TRUE if decompression started, FALSE if it couldn't.
+*/
+static bool start_mccp_input(descriptor_data *d, const char *data, size_t length) {
+	z_stream *zs;
+	
+	CREATE(zs, z_stream, 1);	// zeroed: default zalloc/zfree
+	if (inflateInit(zs) != Z_OK) {
+		log("SYSERR: inflateInit() failed for MCCP3 on descriptor %d", d->descriptor);
+		free(zs);
+		return FALSE;
+	}
+	
+	if (!d->mccp_inbuf) {
+		CREATE(d->mccp_inbuf, char, MAX_PROTOCOL_BUFFER);
+	}
+	memcpy(d->mccp_inbuf, data, length);
+	zs->next_in = (Bytef*)d->mccp_inbuf;
+	zs->avail_in = length;
+	
+	d->mccp_in = zs;
+	return TRUE;
+}
+
+
+/**
+* Turns off MCCP3 input decompression for a descriptor, if it's on.
+*
+* @param descriptor_data *d The descriptor.
+*/
+void end_mccp_input(descriptor_data *d) {
+	if (d->mccp_in) {
+		inflateEnd(d->mccp_in);
+		free(d->mccp_in);
+		d->mccp_in = NULL;
+	}
+}
+#endif	/* USING_MCCP */
+
+
+/**
+* Frees all of a descriptor's MCCP streams and buffers, without sending
+* anything.
+*
+* @param descriptor_data *d The descriptor.
+*/
+static void free_mccp(descriptor_data *d) {
+#ifdef USING_MCCP
+	if (d->mccp_out) {
+		deflateEnd(d->mccp_out);
+		free(d->mccp_out);
+		d->mccp_out = NULL;
+	}
+	end_mccp_input(d);
+#endif
+	if (d->mccp_pending) {
+		free(d->mccp_pending);
+		d->mccp_pending = NULL;
+	}
+	d->mccp_pending_len = d->mccp_pending_size = 0;
+	if (d->mccp_inbuf) {
+		free(d->mccp_inbuf);
+		d->mccp_inbuf = NULL;
+	}
+	d->mccp_inbuf_len = 0;
+	d->mccp_marker_len = 0;
+}
+
+
+/**
+* Reads input from a descriptor's socket, decompressing it if the client has
+* started MCCP3. Takes the place of perform_socket_read() for descriptors.
+*
+* @param descriptor_data *d The descriptor to read from.
+* @param char *read_point Where to put the (uncompressed) input.
+* @param size_t space_left How much room there is at read_point.
+* @return ssize_t The number of bytes read, 0 for none, or -1 on a fatal error.
+*/
+static ssize_t read_from_client(descriptor_data *d, char *read_point, size_t space_left) {
+#ifdef USING_MCCP
+	static const char mccp3_start[] = { (char)IAC, (char)SB, (char)TELOPT_MCCP3, (char)IAC, (char)SE };
+	z_stream *zs = d->mccp_in;
+	ssize_t bytes, iter, held;
+	int result;
+	
+	if (!zs) {
+		// plain input that came in behind the end of a compressed stream
+		if (d->mccp_inbuf_len > 0) {
+			bytes = MIN(space_left, d->mccp_inbuf_len);
+			memcpy(read_point, d->mccp_inbuf, bytes);
+			d->mccp_inbuf_len -= bytes;
+			memmove(d->mccp_inbuf, d->mccp_inbuf + bytes, d->mccp_inbuf_len);
+			return bytes;
+		}
+		
+		// anything held back from the last read (see below) goes first
+		held = d->mccp_marker_len;
+		memcpy(read_point, d->mccp_marker, held);
+		d->mccp_marker_len = 0;
+		
+		if ((bytes = perform_socket_read(d->descriptor, read_point + held, space_left - held)) <= 0) {
+			if (bytes == 0 && held > 0) {
+				// still waiting on the rest of it
+				memcpy(d->mccp_marker, read_point, held);
+				d->mccp_marker_len = held;
+			}
+			return bytes;
+		}
+		bytes += held;
+		
+		if (!d->pProtocol->bMCCP3) {
+			return bytes;
+		}
+		
+		// IAC SB MCCP3 IAC SE: everything after it is compressed
+		for (iter = 0; iter + 4 < bytes; ++iter) {
+			if (!memcmp(read_point + iter, mccp3_start, sizeof(mccp3_start))) {
+				if (!start_mccp_input(d, read_point + iter + 5, bytes - (iter + 5))) {
+					return (-1);
+				}
+				return (iter + 5);	// the rest is inflated on the next read
+			}
+		}
+		
+		// hold back a partial start sequence at the end, so it can be matched after the next read
+		for (held = MIN(4, bytes); held > 0; --held) {
+			if (!memcmp(read_point + bytes - held, mccp3_start, held)) {
+				memcpy(d->mccp_marker, read_point + bytes - held, held);
+				d->mccp_marker_len = held;
+				bytes -= held;
+				break;
+			}
+		}
+		return bytes;
+	}
+	
+	if (zs->avail_in == 0) {
+		if ((bytes = perform_socket_read(d->descriptor, d->mccp_inbuf, MAX_PROTOCOL_BUFFER)) <= 0) {
+			return bytes;
+		}
+		zs->next_in = (Bytef*)d->mccp_inbuf;
+		zs->avail_in = bytes;
+	}
+	
+	zs->next_out = (Bytef*)read_point;
+	zs->avail_out = space_left;
+	result = inflate(zs, Z_SYNC_FLUSH);
+	bytes = space_left - zs->avail_out;
+	
+	if (result == Z_STREAM_END) {
+		// client stopped compressing: keep whatever followed the stream as plain input
+		d->mccp_inbuf_len = zs->avail_in;
+		memmove(d->mccp_inbuf, zs->next_in, zs->avail_in);
+		end_mccp_input(d);
+	}
+	else if (result != Z_OK && result != Z_BUF_ERROR) {
+		log("WARNING: MCCP3 input from descriptor %d could not be decompressed (error %d)", d->descriptor, result);
+		return (-1);
+	}
+	
+	return bytes;
+#else
+	return perform_socket_read(d->descriptor, read_point, space_left);
+#endif
+}
+
+
+/**
+* Writes text to a descriptor's socket, through its MCCP stream if the client
+* asked for compression. Compressed output the socket can't take yet is kept
+* and sent ahead of the next write, so this never splits the deflate stream.
+*
+* @param descriptor_data *d The descriptor to write to.
+* @param const char *txt The text to send.
+* @return int >= 0 if all is well (0 if the socket is still too full to take anything), or -1 on a fatal error.
+*/
+int write_to_client(descriptor_data *d, const char *txt) {
+#ifdef USING_MCCP
+	size_t length;
+	int pending;
+	
+	if (d->mccp_out || d->mccp_pending_len > 0) {
+		// don't compress more until the socket drains: d->output holds the backlog
+		if (d->mccp_pending_len > 0 && (pending = flush_mccp_pending(d)) != 0) {
+			return (pending < 0 ? -1 : 0);
+		}
+		
+		length = strlen(txt);
+		if (d->mccp_out) {
+			if (!deflate_mccp(d, txt, length, Z_SYNC_FLUSH)) {
+				return (-1);
+			}
+		}
+		else {
+			// the end of a finished stream is still draining
+			add_mccp_pending(d, txt, length);
+		}
+		
+		return (flush_mccp_pending(d) < 0 ? -1 : length);
+	}
+#endif
+	
+	return write_to_descriptor(d->descriptor, txt);
+}
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// PROMPT //////////////////////////////////////////////////////////////////
 
@@ -3383,19 +4004,24 @@ void signal_setup(void) {
 void game_loop(socket_t mother_desc) {
 	void reset_time(void);
 
+#ifndef HAVE_SYS_EPOLL_H
 	fd_set input_set, output_set, exc_set, null_set;
+	int maxdesc;
+#endif
 	struct timeval last_time, opt_time, process_time, temp_time;
 	struct timeval before_sleep, now, timeout;
 	char comm[MAX_INPUT_LENGTH];
 	descriptor_data *d, *next_d;
-	int missed_pulses, maxdesc, aliased;
+	int missed_pulses, aliased;
 
 	/* initialize various time values */
 	null_time.tv_sec = 0;
 	null_time.tv_usec = 0;
 	opt_time.tv_usec = OPT_USEC;
 	opt_time.tv_sec = 0;
+#ifndef HAVE_SYS_EPOLL_H
 	FD_ZERO(&null_set);
+#endif
 
 	gettimeofday(&last_time, (struct timezone *) 0);
 
@@ -3422,6 +4048,7 @@ void game_loop(socket_t mother_desc) {
 		}
 		*/
 		
+#ifndef HAVE_SYS_EPOLL_H
 		/* Set up the input, output, and exception sets for select(). */
 		FD_ZERO(&input_set);
 		FD_ZERO(&output_set);
@@ -3436,6 +4063,7 @@ void game_loop(socket_t mother_desc) {
 			FD_SET(d->descriptor, &output_set);
 			FD_SET(d->descriptor, &exc_set);
 		}
+#endif
 
 		/*
 		 * At this point, we have completed all input, output and heartbeat
@@ -3469,6 +4097,16 @@ void game_loop(socket_t mother_desc) {
 		gettimeofday(&now, (struct timezone *) 0);
 		timediff(&timeout, &last_time, &now);
 
+#ifdef HAVE_SYS_EPOLL_H
+		/* Go to sleep, waking up to read input from only the sockets that have it */
+		do {
+			if (!poll_descriptors(mother_desc, &timeout)) {
+				return;
+			}
+			gettimeofday(&now, (struct timezone *) 0);
+			timediff(&timeout, &last_time, &now);
+		} while (timeout.tv_usec || timeout.tv_sec);
+#else
 		/* Go to sleep */
 		do {
 			empire_sleep(&timeout);
@@ -3502,6 +4140,17 @@ void game_loop(socket_t mother_desc) {
 				if (process_input(d) < 0)
 					close_socket(d);
 		}
+#endif
+
+#ifdef USING_MCCP
+		/* Finish input that arrived compressed (MCCP3) but didn't fit in one read */
+		for (d = descriptor_list; d; d = next_d) {
+			next_d = d->next;
+			if (((d->mccp_in && d->mccp_in->avail_in > 0) || d->mccp_inbuf_len > 0) && process_input(d) < 0) {
+				close_socket(d);
+			}
+		}
+#endif
 
 		/* Process commands we just read from process_input */
 		for (d = descriptor_list; d; d = next_d) {
@@ -3548,7 +4197,18 @@ void game_loop(socket_t mother_desc) {
 		/* Send queued output out to the operating system (ultimately to user). */
 		for (d = descriptor_list; d; d = next_d) {
 			next_d = d->next;
+#ifdef USING_MCCP
+			// compressed output the socket couldn't take last time goes first
+			if (d->mccp_pending_len > 0 && flush_mccp_pending(d) < 0) {
+				close_socket(d);
+				continue;
+			}
+#endif
+#ifdef HAVE_SYS_EPOLL_H
+			if (*(d->output)) {	// non-blocking: a full socket just takes 0 bytes
+#else
 			if (*(d->output) && FD_ISSET(d->descriptor, &output_set)) {
+#endif
 				/* Output for this player is ready */
 				if (process_output(d) < 0) {
 					// process_output actually kills it itself
@@ -3576,7 +4236,7 @@ void game_loop(socket_t mother_desc) {
 				// force a color code flush
 				snprintf(prompt + strlen(prompt), sizeof(prompt) - strlen(prompt), "%s", flush_reduced_color_codes(d));
 				
-				if (write_to_descriptor(d->descriptor, prompt) >= 0) {
+				if (write_to_client(d, prompt) >= 0) {
 					d->has_prompt = 1;
 				}
 			}
@@ -3634,6 +4294,8 @@ void init_game(ush_int port) {
 		log("Opening mother connection.");
 		mother_desc = init_socket(port);
 	}
+	
+	init_descriptor_polling(mother_desc);
 
 	event_init();
 
@@ -3652,6 +4314,7 @@ void init_game(ush_int port) {
 	game_loop(mother_desc);
 
 	save_all_players();
+	save_player_index_file(TRUE);
 
 	log("Closing all sockets.");
 	while (descriptor_list)
@@ -3903,11 +4566,11 @@ void reboot_recover(void) {
 		CopyoverSet(d, protocol_info);
 
 		if (!fOld) {
-			write_to_descriptor(desc, "\r\nSomehow, your character couldn't be loaded.\r\n");
+			write_to_client(d, "\r\nSomehow, your character couldn't be loaded.\r\n");
 			close_socket(d);
 		}
 		else {
-			write_to_descriptor(desc, "\033[0mRecovery complete.\r\n\r\n");
+			write_to_client(d, "\033[0mRecovery complete.\r\n\r\n");
 			enter_player_game(d, FALSE, FALSE);
 			d->connected = CON_PLAYING;
 		}
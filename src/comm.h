@@ -55,13 +55,23 @@ void act(const char *str, int hide_invisible, char_data *ch, const void *obj, co
 #define TO_COMBAT_MISS  BIT(16)	// is a miss (fightmessages) -- REQUIRES vict_obj is a char
 
 /* I/O functions */
+int write_to_client(descriptor_data *d, const char *txt);
 int write_to_descriptor(socket_t desc, const char *txt);
 void write_to_q(const char *txt, struct txt_q *queue, int aliased, bool add_to_head);
 void write_to_output(const char *txt, descriptor_data *d);
+void start_output_builder(descriptor_data *d);
+void flush_output_builder(descriptor_data *d);
 void page_string(descriptor_data *d, char *str, int keep_internal);
 void string_add(descriptor_data *d, char *str);
 void start_string_editor(descriptor_data *d, char *prompt, char **writeto, size_t max_len, bool allow_null);
 
+// MCCP compression (comm.c)
+#ifdef USING_MCCP
+void end_mccp_input(descriptor_data *d);
+void end_mccp_output(descriptor_data *d);
+bool start_mccp_output(descriptor_data *d);
+#endif
+
 #define SEND_TO_Q(messg, desc)  write_to_output((messg), desc)
 
 #define USING_SMALL(d)	((d)->output == (d)->small_outbuf)
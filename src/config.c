@@ -337,14 +337,233 @@ const char *config_types[] = {
 };
 
 
-// data storage for config system
-union config_data_union {
-	bitvector_t bitvector_val;
-	bool bool_val;
-	double double_val;
-	int int_val;
-	int *int_array;
-	char *string_val;
+// for CFG_x typed config handles
+struct config_handle_data {
+	char *key;	// config key
+	int type;	// CONFTYPE_x expected type
+};
+
+
+// CFG_x: the config key and expected CONFTYPE_x for each typed handle (any
+// missing entry is reported by resolve_config_handles)
+const struct config_handle_data config_handle_list[NUM_CONFIG_HANDLES] = {
+	// approval
+	[CFG_AUTO_APPROVE] = { "auto_approve", CONFTYPE_BOOL },
+	[CFG_APPROVE_PER_CHARACTER] = { "approve_per_character", CONFTYPE_BOOL },
+	[CFG_NEED_APPROVAL_STRING] = { "need_approval_string", CONFTYPE_SHORT_STRING },
+	[CFG_BUILD_APPROVAL] = { "build_approval", CONFTYPE_BOOL },
+	[CFG_CHAT_APPROVAL] = { "chat_approval", CONFTYPE_BOOL },
+	[CFG_CRAFT_APPROVAL] = { "craft_approval", CONFTYPE_BOOL },
+	[CFG_GATHER_APPROVAL] = { "gather_approval", CONFTYPE_BOOL },
+	[CFG_JOIN_EMPIRE_APPROVAL] = { "join_empire_approval", CONFTYPE_BOOL },
+	[CFG_MANAGE_EMPIRE_APPROVAL] = { "manage_empire_approval", CONFTYPE_BOOL },
+	[CFG_QUEST_APPROVAL] = { "quest_approval", CONFTYPE_BOOL },
+	[CFG_SKILL_GAIN_APPROVAL] = { "skill_gain_approval", CONFTYPE_BOOL },
+	[CFG_TELL_APPROVAL] = { "tell_approval", CONFTYPE_BOOL },
+	[CFG_TERRAFORM_APPROVAL] = { "terraform_approval", CONFTYPE_BOOL },
+	[CFG_TITLE_APPROVAL] = { "title_approval", CONFTYPE_BOOL },
+	[CFG_TRAVEL_APPROVAL] = { "travel_approval", CONFTYPE_BOOL },
+	[CFG_WRITE_APPROVAL] = { "write_approval", CONFTYPE_BOOL },
+	
+	// game configs
+	[CFG_ALLOW_EXTENDED_COLOR_CODES] = { "allow_extended_color_codes", CONFTYPE_BOOL },
+	[CFG_HIRING_BUILDERS] = { "hiring_builders", CONFTYPE_BOOL },
+	[CFG_HIRING_CODERS] = { "hiring_coders", CONFTYPE_BOOL },
+	[CFG_MUD_CONTACT] = { "mud_contact", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_CREATED] = { "mud_created", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_HOSTNAME] = { "mud_hostname", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_ICON] = { "mud_icon", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_IP] = { "mud_ip", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_LOCATION] = { "mud_location", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_MINIMUM_AGE] = { "mud_minimum_age", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_NAME] = { "mud_name", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_STATUS] = { "mud_status", CONFTYPE_SHORT_STRING },
+	[CFG_MUD_WEBSITE] = { "mud_website", CONFTYPE_SHORT_STRING },
+	[CFG_NEWYEAR_MESSAGE] = { "newyear_message", CONFTYPE_SHORT_STRING },
+	[CFG_STARTING_YEAR] = { "starting_year", CONFTYPE_INT },
+	[CFG_WELCOME_MESSAGE] = { "welcome_message", CONFTYPE_SHORT_STRING },
+	[CFG_OK_STRING] = { "ok_string", CONFTYPE_SHORT_STRING },
+	[CFG_NO_PERSON] = { "no_person", CONFTYPE_SHORT_STRING },
+	[CFG_HUH_STRING] = { "huh_string", CONFTYPE_SHORT_STRING },
+	[CFG_PUBLIC_LOGINS] = { "public_logins", CONFTYPE_BOOL },
+	
+	// actions
+	[CFG_CHORE_DISTANCE] = { "chore_distance", CONFTYPE_INT },
+	[CFG_CHIP_TIMER] = { "chip_timer", CONFTYPE_INT },
+	[CFG_CHOP_TIMER] = { "chop_timer", CONFTYPE_INT },
+	[CFG_DIG_BASE_TIMER] = { "dig_base_timer", CONFTYPE_INT },
+	[CFG_FISHING_TIMER] = { "fishing_timer", CONFTYPE_INT },
+	[CFG_GATHER_BASE_TIMER] = { "gather_base_timer", CONFTYPE_INT },
+	[CFG_HARVEST_TIMER] = { "harvest_timer", CONFTYPE_INT },
+	[CFG_MINING_TIMER] = { "mining_timer", CONFTYPE_INT },
+	[CFG_PANNING_TIMER] = { "panning_timer", CONFTYPE_INT },
+	[CFG_PICK_BASE_TIMER] = { "pick_base_timer", CONFTYPE_INT },
+	[CFG_PLANTING_BASE_TIMER] = { "planting_base_timer", CONFTYPE_INT },
+	[CFG_TAN_TIMER] = { "tan_timer", CONFTYPE_INT },
+	[CFG_CHOP_DEPLETION] = { "chop_depletion", CONFTYPE_INT },
+	[CFG_COMMON_DEPLETION] = { "common_depletion", CONFTYPE_INT },
+	[CFG_GARDEN_DEPLETION] = { "garden_depletion", CONFTYPE_INT },
+	[CFG_GATHER_DEPLETION] = { "gather_depletion", CONFTYPE_INT },
+	[CFG_PICK_DEPLETION] = { "pick_depletion", CONFTYPE_INT },
+	[CFG_SHORT_DEPLETION] = { "short_depletion", CONFTYPE_INT },
+	[CFG_HIGH_DEPLETION] = { "high_depletion", CONFTYPE_INT },
+	[CFG_SHEAR_GROWTH_TIME] = { "shear_growth_time", CONFTYPE_INT },
+	[CFG_TAVERN_BREW_TIME] = { "tavern_brew_time", CONFTYPE_INT },
+	[CFG_TAVERN_TIMER] = { "tavern_timer", CONFTYPE_INT },
+	[CFG_TRENCH_INITIAL_VALUE] = { "trench_initial_value", CONFTYPE_INT },
+	[CFG_TRENCH_GAIN_FROM_RAIN] = { "trench_gain_from_rain", CONFTYPE_INT },
+	[CFG_TRENCH_FULL_VALUE] = { "trench_full_value", CONFTYPE_INT },
+	[CFG_MAX_CHORE_RESOURCE] = { "max_chore_resource", CONFTYPE_INT },
+	[CFG_MAX_CHORE_RESOURCE_OVER_TOTAL] = { "max_chore_resource_over_total", CONFTYPE_INT },
+	[CFG_MAX_CHORE_RESOURCE_SKILLED] = { "max_chore_resource_skilled", CONFTYPE_INT },
+	
+	// cities
+	[CFG_PLAYERS_PER_CITY_POINT] = { "players_per_city_point", CONFTYPE_INT },
+	[CFG_BONUS_CITY_POINT_WEALTH] = { "bonus_city_point_wealth", CONFTYPE_INT },
+	[CFG_BONUS_CITY_POINT_TECHS] = { "bonus_city_point_techs", CONFTYPE_INT },
+	[CFG_MIN_DISTANCE_BETWEEN_CITIES] = { "min_distance_between_cities", CONFTYPE_INT },
+	[CFG_MIN_DISTANCE_BETWEEN_ALLY_CITIES] = { "min_distance_between_ally_cities", CONFTYPE_INT },
+	[CFG_MIN_DISTANCE_FROM_CITY_TO_STARTING_LOCATION] = { "min_distance_from_city_to_starting_location", CONFTYPE_INT },
+	[CFG_CITIES_ON_NEWBIE_ISLANDS] = { "cities_on_newbie_islands", CONFTYPE_BOOL },
+	[CFG_CITY_TRAIT_RADIUS] = { "city_trait_radius", CONFTYPE_INT },
+	[CFG_DISREPAIR_MINOR] = { "disrepair_minor", CONFTYPE_INT },
+	[CFG_DISREPAIR_MAJOR] = { "disrepair_major", CONFTYPE_INT },
+	[CFG_DISREPAIR_LIMIT] = { "disrepair_limit", CONFTYPE_INT },
+	[CFG_DISREPAIR_LIMIT_UNFINISHED] = { "disrepair_limit_unfinished", CONFTYPE_INT },
+	[CFG_MAX_OUT_OF_CITY_PORTAL] = { "max_out_of_city_portal", CONFTYPE_INT },
+	[CFG_MINUTES_TO_FULL_CITY] = { "minutes_to_full_city", CONFTYPE_INT },
+	
+	// empire
+	[CFG_LAND_PER_GREATNESS] = { "land_per_greatness", CONFTYPE_INT },
+	[CFG_LAND_PER_TECH] = { "land_per_tech", CONFTYPE_INT },
+	[CFG_LAND_PER_WEALTH] = { "land_per_wealth", CONFTYPE_DOUBLE },
+	[CFG_LAND_OUTSIDE_CITY_MODIFIER] = { "land_outside_city_modifier", CONFTYPE_DOUBLE },
+	[CFG_BUILDING_POPULATION_TIMER] = { "building_population_timer", CONFTYPE_INT },
+	[CFG_TIME_TO_EMPIRE_DELETE] = { "time_to_empire_delete", CONFTYPE_INT },
+	[CFG_TIME_TO_EMPIRE_EMPTINESS] = { "time_to_empire_emptiness", CONFTYPE_INT },
+	[CFG_MEMBER_TIMEOUT_NEWBIE] = { "member_timeout_newbie", CONFTYPE_INT },
+	[CFG_MINUTES_PER_DAY_NEWBIE] = { "minutes_per_day_newbie", CONFTYPE_INT },
+	[CFG_MEMBER_TIMEOUT_FULL] = { "member_timeout_full", CONFTYPE_INT },
+	[CFG_MINUTES_PER_DAY_FULL] = { "minutes_per_day_full", CONFTYPE_INT },
+	[CFG_MEMBER_TIMEOUT_MAX_THRESHOLD] = { "member_timeout_max_threshold", CONFTYPE_INT },
+	[CFG_NEWBIE_ISLAND_DAY_LIMIT] = { "newbie_island_day_limit", CONFTYPE_INT },
+	[CFG_WHOLE_EMPIRE_TIMEOUT] = { "whole_empire_timeout", CONFTYPE_INT },
+	[CFG_EMPIRE_LOG_TTL] = { "empire_log_ttl", CONFTYPE_INT },
+	[CFG_REDESIGNATE_TIME] = { "redesignate_time", CONFTYPE_INT },
+	
+	// items
+	[CFG_AUTO_UPDATE_ITEMS] = { "auto_update_items", CONFTYPE_BOOL },
+	[CFG_AUTOSTORE_TIME] = { "autostore_time", CONFTYPE_INT },
+	[CFG_BOUND_ITEM_JUNK_TIME] = { "bound_item_junk_time", CONFTYPE_INT },
+	[CFG_LONG_AUTOSTORE_TIME] = { "long_autostore_time", CONFTYPE_INT },
+	[CFG_ROOM_ITEM_LIMIT] = { "room_item_limit", CONFTYPE_INT },
+	[CFG_SCALE_POINTS_AT_100] = { "scale_points_at_100", CONFTYPE_DOUBLE },
+	[CFG_SCALE_FOOD_FULLNESS] = { "scale_food_fullness", CONFTYPE_DOUBLE },
+	[CFG_SCALE_DRINK_CAPACITY] = { "scale_drink_capacity", CONFTYPE_DOUBLE },
+	[CFG_SCALE_COIN_AMOUNT] = { "scale_coin_amount", CONFTYPE_DOUBLE },
+	[CFG_SCALE_PACK_SIZE] = { "scale_pack_size", CONFTYPE_DOUBLE },
+	
+	// mobs
+	[CFG_MAX_NPC_ATTRIBUTE] = { "max_npc_attribute", CONFTYPE_INT },
+	[CFG_MOB_SPAWN_INTERVAL] = { "mob_spawn_interval", CONFTYPE_INT },
+	[CFG_MOB_SPAWN_RADIUS] = { "mob_spawn_radius", CONFTYPE_INT },
+	[CFG_MOB_DESPAWN_RADIUS] = { "mob_despawn_radius", CONFTYPE_INT },
+	[CFG_NPC_FOLLOWER_LIMIT] = { "npc_follower_limit", CONFTYPE_INT },
+	[CFG_NUM_DUPLICATES_IN_STABLE] = { "num_duplicates_in_stable", CONFTYPE_INT },
+	[CFG_SPAWN_LIMIT_PER_ROOM] = { "spawn_limit_per_room", CONFTYPE_INT },
+	[CFG_MOB_PURSUIT_TIMEOUT] = { "mob_pursuit_timeout", CONFTYPE_INT },
+	[CFG_MOB_PURSUIT_DISTANCE] = { "mob_pursuit_distance", CONFTYPE_INT },
+	[CFG_USE_MOB_STACKING] = { "use_mob_stacking", CONFTYPE_BOOL },
+	
+	// other
+	[CFG_TEST_CONFIG] = { "test_config", CONFTYPE_INT },
+	
+	// players
+	[CFG_DAILIES_PER_DAY] = { "dailies_per_day", CONFTYPE_INT },
+	[CFG_DEFAULT_CLASS_ABBREV] = { "default_class_abbrev", CONFTYPE_SHORT_STRING },
+	[CFG_DEFAULT_CLASS_NAME] = { "default_class_name", CONFTYPE_SHORT_STRING },
+	[CFG_DELETE_INACTIVE_PLAYERS_AFTER] = { "delete_inactive_players_after", CONFTYPE_INT },
+	[CFG_DELETE_INVALID_PLAYERS_AFTER] = { "delete_invalid_players_after", CONFTYPE_INT },
+	[CFG_EXP_LEVEL_DIFFERENCE] = { "exp_level_difference", CONFTYPE_INT },
+	[CFG_POOL_BONUS_AMOUNT] = { "pool_bonus_amount", CONFTYPE_INT },
+	[CFG_NUM_DAILY_SKILL_POINTS] = { "num_daily_skill_points", CONFTYPE_INT },
+	[CFG_NUM_BONUS_TRAIT_DAILY_SKILLS] = { "num_bonus_trait_daily_skills", CONFTYPE_INT },
+	[CFG_IDLE_RENT_TIME] = { "idle_rent_time", CONFTYPE_INT },
+	[CFG_IDLE_LINKDEAD_RENT_TIME] = { "idle_linkdead_rent_time", CONFTYPE_INT },
+	[CFG_MAX_CAPITALS_IN_NAME] = { "max_capitals_in_name", CONFTYPE_INT },
+	[CFG_MAX_PLAYER_ATTRIBUTE] = { "max_player_attribute", CONFTYPE_INT },
+	[CFG_MAX_SLEEPING_REGEN_TIME] = { "max_sleeping_regen_time", CONFTYPE_INT },
+	[CFG_REMOVE_LORE_AFTER_YEARS] = { "remove_lore_after_years", CONFTYPE_INT },
+	[CFG_DEFAULT_MAP_SIZE] = { "default_map_size", CONFTYPE_INT },
+	[CFG_MAX_MAP_SIZE] = { "max_map_size", CONFTYPE_INT },
+	[CFG_MAX_MAP_WHILE_MOVING] = { "max_map_while_moving", CONFTYPE_INT },
+	[CFG_BLOOD_STARVATION_LEVEL] = { "blood_starvation_level", CONFTYPE_INT },
+	[CFG_OFFER_TIME] = { "offer_time", CONFTYPE_INT },
+	
+	// skills
+	[CFG_EXP_FROM_WORKFORCE] = { "exp_from_workforce", CONFTYPE_DOUBLE },
+	[CFG_MORPH_TIMER] = { "morph_timer", CONFTYPE_INT },
+	[CFG_TRACKS_LIFESPAN] = { "tracks_lifespan", CONFTYPE_INT },
+	[CFG_GREATER_ENCHANTMENTS_BONUS] = { "greater_enchantments_bonus", CONFTYPE_DOUBLE },
+	[CFG_ENCHANT_POINTS_AT_100] = { "enchant_points_at_100", CONFTYPE_DOUBLE },
+	[CFG_MIN_EXP_TO_ROLL_SKILLUP] = { "min_exp_to_roll_skillup", CONFTYPE_INT },
+	[CFG_MUST_BE_VAMPIRE] = { "must_be_vampire", CONFTYPE_SHORT_STRING },
+	[CFG_POTION_HEAL_SCALE] = { "potion_heal_scale", CONFTYPE_DOUBLE },
+	[CFG_POTION_APPLY_PER_100] = { "potion_apply_per_100", CONFTYPE_DOUBLE },
+	[CFG_SKILL_SWAP_ALLOWED] = { "skill_swap_allowed", CONFTYPE_BOOL },
+	[CFG_SKILL_SWAP_MIN_LEVEL] = { "skill_swap_min_level", CONFTYPE_INT },
+	[CFG_SUMMON_NPC_LIMIT] = { "summon_npc_limit", CONFTYPE_INT },
+	
+	// system
+	[CFG_NAMESERVER_IS_SLOW] = { "nameserver_is_slow", CONFTYPE_BOOL },
+	[CFG_MAX_FILESIZE] = { "max_filesize", CONFTYPE_INT },
+	[CFG_MAX_BAD_PWS] = { "max_bad_pws", CONFTYPE_INT },
+	[CFG_MCCP_COMPRESSION_LEVEL] = { "mccp_compression_level", CONFTYPE_INT },
+	[CFG_USE_AUTOWIZ] = { "use_autowiz", CONFTYPE_BOOL },
+	[CFG_SITEOK_EVERYONE] = { "siteok_everyone", CONFTYPE_BOOL },
+	[CFG_LOG_LOSING_DESCRIPTOR_WITHOUT_CHAR] = { "log_losing_descriptor_without_char", CONFTYPE_BOOL },
+	
+	// trade
+	[CFG_IMPORTS_PER_DAY] = { "imports_per_day", CONFTYPE_INT },
+	[CFG_TRADING_POST_MAX_HOURS] = { "trading_post_max_hours", CONFTYPE_INT },
+	[CFG_TRADING_POST_DAYS_TO_TIMEOUT] = { "trading_post_days_to_timeout", CONFTYPE_INT },
+	[CFG_TRADING_POST_FEE] = { "trading_post_fee", CONFTYPE_DOUBLE },
+	
+	// war
+	[CFG_FIRE_EXTINGUISH_VALUE] = { "fire_extinguish_value", CONFTYPE_INT },
+	[CFG_PVP_TIMER] = { "pvp_timer", CONFTYPE_INT },
+	[CFG_STOLEN_OBJECT_TIMER] = { "stolen_object_timer", CONFTYPE_INT },
+	[CFG_HOSTILE_FLAG_TIME] = { "hostile_flag_time", CONFTYPE_INT },
+	[CFG_DEATH_RELEASE_MINUTES] = { "death_release_minutes", CONFTYPE_INT },
+	[CFG_DEATHS_BEFORE_PENALTY] = { "deaths_before_penalty", CONFTYPE_INT },
+	[CFG_DEATHS_BEFORE_PENALTY_WAR] = { "deaths_before_penalty_war", CONFTYPE_INT },
+	[CFG_HOSTILE_LOGIN_DELAY] = { "hostile_login_delay", CONFTYPE_INT },
+	[CFG_MUTUAL_WAR_ONLY] = { "mutual_war_only", CONFTYPE_BOOL },
+	[CFG_ROGUE_FLAG_TIME] = { "rogue_flag_time", CONFTYPE_INT },
+	[CFG_SECONDS_PER_DEATH] = { "seconds_per_death", CONFTYPE_INT },
+	[CFG_STUN_IMMUNITY_TIME] = { "stun_immunity_time", CONFTYPE_INT },
+	[CFG_VEHICLE_SIEGE_TIME] = { "vehicle_siege_time", CONFTYPE_INT },
+	[CFG_WAR_COST_MAX] = { "war_cost_max", CONFTYPE_INT },
+	[CFG_WAR_COST_MIN] = { "war_cost_min", CONFTYPE_INT },
+	[CFG_WAR_LOGIN_DELAY] = { "war_login_delay", CONFTYPE_INT },
+	
+	// world
+	[CFG_DEFAULT_INTERIOR] = { "default_interior", CONFTYPE_INT },
+	[CFG_WATER_CROP_DISTANCE] = { "water_crop_distance", CONFTYPE_INT },
+	[CFG_NATURALIZE_NEWBIE_ISLANDS] = { "naturalize_newbie_islands", CONFTYPE_BOOL },
+	[CFG_NATURALIZE_UNCLAIMABLE] = { "naturalize_unclaimable", CONFTYPE_BOOL },
+	[CFG_NEARBY_SECTOR_DISTANCE] = { "nearby_sector_distance", CONFTYPE_INT },
+	[CFG_INTERLINK_DISTANCE] = { "interlink_distance", CONFTYPE_INT },
+	[CFG_INTERLINK_RIVER_LIMIT] = { "interlink_river_limit", CONFTYPE_INT },
+	[CFG_INTERLINK_MOUNTAIN_LIMIT] = { "interlink_mountain_limit", CONFTYPE_INT },
+	[CFG_GENERIC_FACING] = { "generic_facing", CONFTYPE_BITVECTOR },
+	[CFG_NEWBIE_ADVENTURE_CAP] = { "newbie_adventure_cap", CONFTYPE_INT },
+	[CFG_ARCTIC_PERCENT] = { "arctic_percent", CONFTYPE_DOUBLE },
+	[CFG_TROPICS_PERCENT] = { "tropics_percent", CONFTYPE_DOUBLE },
+	[CFG_OCEAN_POOL_SIZE] = { "ocean_pool_size", CONFTYPE_INT },
+	[CFG_DEFAULT_BUILDING_SECT] = { "default_building_sect", CONFTYPE_INT },
+	[CFG_DEFAULT_INSIDE_SECT] = { "default_inside_sect", CONFTYPE_INT },
+	[CFG_DEFAULT_ADVENTURE_SECT] = { "default_adventure_sect", CONFTYPE_INT },
 };
 
 
@@ -357,6 +576,7 @@ struct config_type {
 	
 	union config_data_union data;	// whatever type of data is stored here (based on type)
 	int data_size;	// for array data
+	int handle;	// CFG_x, if any (set by resolve_config_handles)
 	
 	// for types with their own handlers
 	CONFIG_HANDLER(*show_func);
@@ -367,6 +587,7 @@ struct config_type {
 };
 
 struct config_type *config_table = NULL;	// hash table of configs
+union config_data_union *config_handles[NUM_CONFIG_HANDLES];	// CFG_x: pointers directly to config data
 
 
  //////////////////////////////////////////////////////////////////////////////
@@ -1441,6 +1662,52 @@ bool remove_int_from_int_array(int to_remove, int **array, int *size) {
 }
 
 
+/**
+* Points each CFG_x handle directly at its config's data, so that frequently-
+* read configs (CONFIG_INT() etc) don't need a hash lookup by string key. This
+* must be called after all configs are set up with init_config(). Any handle
+* that can't be resolved is logged and pointed at blank data instead. Every
+* config except CONFTYPE_INT_ARRAY ones must have a handle.
+*/
+void resolve_config_handles(void) {
+	static union config_data_union blank_config_data;
+	struct config_type *cnf, *next_cnf;
+	int iter;
+	
+	HASH_ITER(hh, config_table, cnf, next_cnf) {
+		cnf->handle = NOTHING;
+	}
+	
+	for (iter = 0; iter < NUM_CONFIG_HANDLES; ++iter) {
+		config_handles[iter] = &blank_config_data;
+		
+		if (!config_handle_list[iter].key) {
+			log("SYSERR: resolve_config_handles: handle %d has no entry in config_handle_list", iter);
+			continue;
+		}
+		if (!(cnf = get_config_by_key(config_handle_list[iter].key))) {
+			log("SYSERR: resolve_config_handles: no config for handle %d '%s'", iter, config_handle_list[iter].key);
+			continue;
+		}
+		if (cnf->type != config_handle_list[iter].type) {
+			log("SYSERR: resolve_config_handles: handle %d '%s' expects type %s but config is type %s", iter, cnf->key, config_types[config_handle_list[iter].type], config_types[cnf->type]);
+			continue;
+		}
+		
+		cnf->handle = iter;
+		config_handles[iter] = &cnf->data;
+	}
+	
+	// and the reverse: any config without a handle
+	HASH_ITER(hh, config_table, cnf, next_cnf) {
+		// int arrays are exempt: they also need their data_size, so they are always read with config_get_int_array()
+		if (cnf->handle == NOTHING && cnf->type != CONFTYPE_INT_ARRAY) {
+			log("SYSERR: resolve_config_handles: config '%s' has no CFG_ handle", cnf->key);
+		}
+	}
+}
+
+
 /**
 * Simple sorter for the configs hash
 *
@@ -1752,6 +2019,7 @@ void init_config_system(void) {
 	init_config(CONFIG_SYSTEM, "nameserver_is_slow", CONFTYPE_BOOL, "if enabled, system will not resolve numeric IPs");
 	init_config(CONFIG_SYSTEM, "max_filesize", CONFTYPE_INT, "maximum size of bug, typo and idea files in bytes (to prevent bombing)");
 	init_config(CONFIG_SYSTEM, "max_bad_pws", CONFTYPE_INT, "maximum number of password attempts before disconnection");
+	init_config(CONFIG_SYSTEM, "mccp_compression_level", CONFTYPE_INT, "zlib level 1-9 for MCCP compression (0 for zlib's default)");
 	init_config(CONFIG_SYSTEM, "use_autowiz", CONFTYPE_BOOL, "if on, automatically generates the wizlist");
 	init_config(CONFIG_SYSTEM, "siteok_everyone", CONFTYPE_BOOL, "flags players siteok on creation, essentially inverting ban logic");
 	init_config(CONFIG_SYSTEM, "log_losing_descriptor_without_char", CONFTYPE_BOOL, "somewhat spammy disconnect logs");
@@ -1809,6 +2077,7 @@ void init_config_system(void) {
 
 
 	// last
+	resolve_config_handles();
 	load_config_system_from_file();
 }
 
@@ -84,6 +84,7 @@ augment_data *sorted_augments = NULL;	// alphabetic version // sorted_hh
 
 // buildings
 bld_data *building_table = NULL;	// building hash table
+struct building_index_type *building_index = NULL;	// live rooms by building type
 
 // classes
 class_data *class_table = NULL;	// main hash (hh)
@@ -114,6 +115,7 @@ struct message_list fight_messages[MAX_MESSAGES];	// fighting messages
 time_t boot_time = 0;	// time of mud boot
 int Global_ignore_dark = 0;	// For use in public channels
 int no_auto_deletes = 0;	// skip player deletes on boot?
+bool defer_table_sorts = FALSE;	// TRUE while index_boot() is loading; add_*_to_table() skip their sorts
 struct time_info_data time_info;	// the infomation about the time
 struct weather_data weather_info;	// the infomation about the weather
 int wizlock_level = 0;	// level of game restriction
@@ -167,6 +169,7 @@ struct sector_index_type *sector_index = NULL;	// index lists
 struct map_data *last_evo_tile = NULL;	// for resuming map evolutions
 sector_data *last_evo_sect = NULL;	// for resuming map evolutions
 int evos_per_hour = 1;	// how many map tiles evolve per hour (for load-balancing)
+int evos_behind = 0;	// how many map tile evolutions are due but haven't run yet
 
 // skills
 skill_data *skill_table = NULL;	// main skills hash (hh)
@@ -175,6 +178,8 @@ skill_data *sorted_skills = NULL;	// alpha hash (sorted_hh)
 // socials
 social_data *social_table = NULL;	// master social hash table (hh)
 social_data *sorted_socials = NULL;	// alphabetic version (sorted_hh)
+social_data **social_index = NULL;	// array copy of sorted_socials, for binary search (see sort_socials)
+int social_index_size = 0;	// number of entries in social_index
 
 // strings
 char *credits = NULL;	// game credits
@@ -393,6 +398,7 @@ void boot_db(void) {
 */
 void boot_world(void) {
 	void build_land_map();
+	int update_world_count(bool verify);
 	void build_world_map();
 	void check_abilities();
 	void check_and_link_faction_relations();
@@ -404,6 +410,7 @@ void boot_world(void) {
 	void check_newbie_islands();
 	void check_triggers();
 	void clean_empire_logs();
+	void clear_world_block_saves();
 	void index_boot_world();
 	void init_reputation();
 	void load_daily_quest_file();
@@ -421,7 +428,7 @@ void boot_world(void) {
 	extern int sort_classes_by_data(class_data *a, class_data *b);
 	extern int sort_crafts_by_data(craft_data *a, craft_data *b);
 	extern int sort_skills_by_data(skill_data *a, skill_data *b);
-	extern int sort_socials_by_data(social_data *a, social_data *b);
+	void sort_socials(void);
 
 	// DB_BOOT_x search: boot new types in this function
 	
@@ -463,8 +470,10 @@ void boot_world(void) {
 	log("Loading the world.");
 	load_world_map_from_file();	// get base data
 	index_boot(DB_BOOT_WLD);	// override with live rooms
+	clear_world_block_saves();	// no need to re-save what was just loaded
 	build_world_map();	// ensure full world map
 	build_land_map();	// determine which parts are land
+	update_world_count(FALSE);	// initial sector/crop/building stats (updated live after this)
 	
 	// requires rooms
 	log("Loading empires.");
@@ -543,7 +552,7 @@ void boot_world(void) {
 	HASH_SRT(sorted_hh, sorted_classes, sort_classes_by_data);
 	HASH_SRT(sorted_hh, sorted_crafts, sort_crafts_by_data);
 	HASH_SRT(sorted_hh, sorted_skills, sort_skills_by_data);
-	HASH_SRT(sorted_hh, sorted_socials, sort_socials_by_data);
+	sort_socials();
 	
 	log("Checking newbie islands.");
 	check_newbie_islands();
@@ -2018,7 +2027,8 @@ void b3_2_map_and_gear(void) {
 // fixes some guild-patterend cloth that was accidentally auto-weaved in a previous patch
 // NOTE: the cloth is not storable, so any empire with it in normal storage must have had the bug
 void b3_6_einv_fix(void) {
-	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle, *next_isle;
+	struct empire_storage_data *store;
 	empire_data *emp, *next_emp;
 	obj_data *proto;
 	int total, amt;
@@ -2036,14 +2046,14 @@ void b3_6_einv_fix(void) {
 	
 	HASH_ITER(hh, empire_table, emp, next_emp) {
 		total = 0;
-		LL_FOREACH_SAFE(EMPIRE_STORAGE(emp), store, next_store) {
-			if (store->vnum == vnum) {
+		HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+			HASH_FIND_INT(isle->store, &vnum, store);
+			if (store) {
 				amt = store->amount;
 				total += amt;
-				add_to_empire_storage(emp, store->island, cloth, 4 * amt);
-				add_to_empire_storage(emp, store->island, silver, 2 * amt);
-				LL_DELETE(EMPIRE_STORAGE(emp), store);
-				free(store);
+				add_to_empire_storage(emp, isle->island, cloth, 4 * amt);
+				add_to_empire_storage(emp, isle->island, silver, 2 * amt);
+				add_to_empire_storage(emp, isle->island, vnum, -amt);
 			}
 		}
 		
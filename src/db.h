@@ -66,6 +66,9 @@
 // for file writes to prevent outages by writing temp files first
 #define TEMP_SUFFIX  ".temp"	// for safe filewrites
 
+// empire journals are compacted (full save) once they reach this many entries
+#define EMPIRE_JOURNAL_MAX_ENTRIES  1000
+
 
 // names of various files and directories
 #define INDEX_FILE  "index"	// index of world files
@@ -109,6 +112,7 @@
 #define CRAFT_SUFFIX  ".craft"	// craft file suffix
 #define CROP_SUFFIX  ".crop"	// crop file suffix
 #define EMPIRE_SUFFIX  ".empire"	// empire file suffix
+#define EMPIRE_JOURNAL_SUFFIX  ".journal"	// empire change journal (replayed over the .empire files)
 #define FCT_SUFFIX  ".fct"	// factions
 #define GLB_SUFFIX  ".glb"	// global suffix
 #define MOB_SUFFIX  ".mob"	// mob suffix for file saves
@@ -147,6 +151,7 @@
 
 // etc files (non-user-modifiable libs)
 #define BAN_FILE  LIB_ETC"badsites"	// for the siteban system
+#define PLAYER_INDEX_FILE  LIB_ETC"player_index"	// cached player_index_data, to avoid loading every player at startup
 #define DAILY_QUEST_FILE  LIB_ETC"daily_quests"	// which quests are on/off
 #define INSTANCE_FILE  LIB_ETC"instances"	// instanced adventures
 #define ISLAND_FILE  LIB_ETC"islands"	// island info
@@ -163,9 +168,25 @@
 #define WORLD_BLOCK_SIZE  (MAP_WIDTH * 5)	// number of rooms per .wld file
 #define NUM_WORLD_BLOCK_UPDATES  15	// world is divided into this many updates, and one fires per 30 seconds
 #define GET_WORLD_BLOCK(roomvnum)  (roomvnum == NOWHERE ? NOWHERE : (int)(roomvnum / WORLD_BLOCK_SIZE))
+#define WORLD_BLOCK_SAVES_PER_SEC  3	// how many changed world blocks are saved each second (see save_world_blocks)
+#define OBJPACK_SAVES_PER_SEC  25	// how many changed room objpacks are saved each second (see save_world_blocks)
+
+// sector index: the map is divided into square chunks so distance checks can skip chunks without the sector
+#define SECT_CHUNK_SIZE  10	// width/height of a chunk, in map tiles (counts are stored as bytes, so max 15)
+#define SECT_CHUNKS_X  ((MAP_WIDTH + SECT_CHUNK_SIZE - 1) / SECT_CHUNK_SIZE)
+#define SECT_CHUNKS_Y  ((MAP_HEIGHT + SECT_CHUNK_SIZE - 1) / SECT_CHUNK_SIZE)
+#define SECT_CHUNK(x, y)  (((y) / SECT_CHUNK_SIZE) * SECT_CHUNKS_X + ((x) / SECT_CHUNK_SIZE))
+
+// temporary map rooms used for display (see real_view_room)
+#define NUM_VIEW_ROOMS  64	// how many can be in use at one time
 
 // additional files
-#define WORLD_MAP_FILE  LIB_WORLD"base_map"	// storage for the game's base map
+#define BINARY_MAP_FILE  LIB_WORLD"base_map.bin"	// storage for the game's base map
+#define WORLD_MAP_FILE  LIB_WORLD"base_map"	// text version of the base map: exported on request, and read at boot if there's no binary one or it's newer
+
+// binary map file (BINARY_MAP_FILE): a header, then one record per map tile in vnum order
+#define BINARY_MAP_MAGIC  0x504d4d45	// "EMMP"
+#define BINARY_MAP_VERSION  1	// change this if struct binary_map_record changes
 
 // used for many file reads:
 #define READ_SIZE 256
@@ -199,6 +220,25 @@ struct stored_data_type {
 };
 
 
+// header for the BINARY_MAP_FILE
+struct binary_map_header {
+	int magic;	// BINARY_MAP_MAGIC
+	int version;	// BINARY_MAP_VERSION
+	int width, height;	// must match MAP_WIDTH and MAP_HEIGHT
+	int record_size;	// sizeof(struct binary_map_record)
+};
+
+
+// one tile of the BINARY_MAP_FILE; x/y are determined by its position in the file
+struct binary_map_record {
+	int island;	// island id
+	any_vnum sector_type;	// current sector vnum (or NOTHING)
+	any_vnum base_sector;	// base sector vnum (or NOTHING)
+	any_vnum natural_sector;	// natural sector vnum (or NOTHING)
+	any_vnum crop_type;	// crop vnum (or NOTHING)
+};
+
+
 // for storing data between reboots
 struct stored_data {
 	int key;	// DATA_ const
@@ -218,6 +258,8 @@ char *fread_string(FILE *fl, char *error);
 void boot_db(void);
 
 // global saves
+void request_objpack_save(room_data *room);
+void request_world_save(room_vnum vnum);
 void save_index(int type);
 void save_library_file_for_vnum(int type, any_vnum vnum);
 
@@ -230,6 +272,7 @@ void set_crop_type(room_data *room, crop_data *cp);
 
 
 // various externs
+extern bool defer_table_sorts;
 extern int Global_ignore_dark;
 extern struct time_info_data time_info;
 
@@ -274,8 +317,11 @@ void free_book(book_data *book);
 
 // buildings
 extern bld_data *building_table;
+extern struct building_index_type *building_index;
+extern struct building_index_type *find_building_index(bld_vnum vnum);
 void free_building(bld_data *building);
 extern bld_data *building_proto(bld_vnum vnum);
+void update_building_index(room_data *room, bld_data *old_bld, bld_data *new_bld);
 
 // classes
 extern class_data *class_table;
@@ -320,6 +366,7 @@ void read_empire_members(empire_data *only_empire, bool read_techs);
 void read_empire_territory(empire_data *emp, bool check_tech);
 extern empire_data *real_empire(empire_vnum vnum);
 void reread_empire_tech(empire_data *emp);
+void add_to_empire_journal(empire_data *emp, const char *str, ...) __attribute__((format(printf, 2, 3)));
 void save_empire(empire_data *e);
 void save_all_empires();
 
@@ -409,8 +456,10 @@ extern room_template *room_template_proto(rmt_vnum vnum);
 // sectors
 extern sector_data *sector_table;
 extern struct sector_index_type *sector_index;
+extern int count_adjacent_map_sectors(struct map_data *tile, sector_vnum sect, bool count_base_sect);
 extern struct sector_index_type *find_sector_index(sector_vnum vnum);
 void free_sector(struct sector_data *st);
+extern bool map_sect_within_distance(struct map_data *tile, sector_vnum sect, int distance);
 void perform_change_base_sect(room_data *loc, struct map_data *map, sector_data *sect);
 void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect);
 extern sector_data *sector_proto(sector_vnum vnum);
@@ -428,6 +477,8 @@ extern char *get_skill_name_by_vnum(any_vnum vnum);
 // socials
 extern social_data *social_table;
 extern social_data *sorted_socials;
+extern social_data **social_index;
+extern int social_index_size;
 extern social_data *social_proto(any_vnum vnum);
 void free_social(social_data *soc);
 
@@ -453,6 +504,7 @@ extern struct map_data world_map[MAP_WIDTH][MAP_HEIGHT];
 extern struct map_data *land_map;
 room_data *real_real_room(room_vnum vnum);
 room_data *real_room(room_vnum vnum);
+room_data *real_view_room(room_vnum vnum);
 
 // misc
 extern struct obj_apply *copy_obj_apply_list(struct obj_apply *list);
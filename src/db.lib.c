@@ -69,6 +69,7 @@ void sort_world_table();
 int check_object(obj_data *obj);
 int count_hash_records(FILE *fl);
 empire_vnum find_free_empire_vnum(void);
+void load_empire_journal(empire_data *emp);
 void parse_custom_message(FILE *fl, struct custom_message **list, char *error);
 void parse_extra_desc(FILE *fl, struct extra_descr_data **list, char *error_part);
 void parse_generic_name_file(FILE *fl, char *err_str);
@@ -78,6 +79,7 @@ void parse_resource(FILE *fl, struct resource_data **list, char *error_str);
 int sort_empires(empire_data *a, empire_data *b);
 int sort_room_templates(room_template *a, room_template *b);
 void write_custom_messages_to_file(FILE *fl, char letter, struct custom_message *list);
+void write_empire_journal(empire_data *emp);
 void write_extra_descs_to_file(FILE *fl, struct extra_descr_data *list);
 void write_icons_to_file(FILE *fl, char file_tag, struct icon_data *list);
 void write_interactions_to_file(FILE *fl, struct interaction_item *list);
@@ -104,7 +106,9 @@ void add_adventure_to_table(adv_data *adv) {
 		HASH_FIND_INT(adventure_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(adventure_table, vnum, adv);
-			HASH_SORT(adventure_table, sort_adventures);
+			if (!defer_table_sorts) {
+				HASH_SORT(adventure_table, sort_adventures);
+			}
 		}
 	}
 }
@@ -354,7 +358,9 @@ void add_building_to_table(bld_data *bld) {
 		HASH_FIND_INT(building_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(building_table, vnum, bld);
-			HASH_SORT(building_table, sort_buildings);
+			if (!defer_table_sorts) {
+				HASH_SORT(building_table, sort_buildings);
+			}
 		}
 	}
 }
@@ -701,14 +707,18 @@ void add_craft_to_table(craft_data *craft) {
 		HASH_FIND_INT(craft_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(craft_table, vnum, craft);
-			HASH_SORT(craft_table, sort_crafts_by_vnum);
+			if (!defer_table_sorts) {
+				HASH_SORT(craft_table, sort_crafts_by_vnum);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_crafts, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_crafts, vnum, sizeof(int), craft);
-			HASH_SRT(sorted_hh, sorted_crafts, sort_crafts_by_data);
+			if (!defer_table_sorts) {
+				HASH_SRT(sorted_hh, sorted_crafts, sort_crafts_by_data);
+			}
 		}
 	}
 }
@@ -926,7 +936,9 @@ void add_crop_to_table(crop_data *crop) {
 		HASH_FIND_INT(crop_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(crop_table, vnum, crop);
-			HASH_SORT(crop_table, sort_crops);
+			if (!defer_table_sorts) {
+				HASH_SORT(crop_table, sort_crops);
+			}
 		}
 	}
 }
@@ -1160,7 +1172,9 @@ void add_empire_to_table(empire_data *emp) {
 		HASH_FIND_INT(empire_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(empire_table, vnum, emp);
-			HASH_SORT(empire_table, sort_empires);
+			if (!defer_table_sorts) {
+				HASH_SORT(empire_table, sort_empires);
+			}
 		}
 	}
 }
@@ -1381,7 +1395,7 @@ void delete_empire(empire_data *emp) {
 	// update all vehicles
 	LL_FOREACH_SAFE2(vehicle_list, veh, next_veh, next) {
 		if (VEH_OWNER(veh) == emp) {
-			VEH_OWNER(veh) = NULL;
+			set_vehicle_owner(veh, NULL);
 			VEH_SHIPPING_ID(veh) = -1;
 		}
 		LL_FOREACH(VEH_ANIMALS(veh), vam) {
@@ -1405,6 +1419,8 @@ void delete_empire(empire_data *emp) {
 	unlink(buf);
 	sprintf(buf, "%s%d%s", STORAGE_PREFIX, vnum, EMPIRE_SUFFIX);
 	unlink(buf);
+	sprintf(buf, "%s%d%s", LIB_EMPIRE, vnum, EMPIRE_JOURNAL_SUFFIX);
+	unlink(buf);
 	
 	cleanup_all_coins();
 	
@@ -1486,30 +1502,35 @@ void free_empire(empire_data *emp) {
 	extern struct empire_territory_data *global_next_territory_entry;
 	
 	struct empire_island *isle, *next_isle;
-	struct empire_storage_data *store;
+	struct empire_storage_data *store, *next_store;
+	struct empire_vehicle_index *vidx, *next_vidx;
 	struct empire_unique_storage *eus;
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	struct empire_city_data *city;
 	struct empire_political_data *pol;
 	struct empire_trade_data *trade;
 	struct empire_log_data *elog;
 	struct shipping_data *shipd;
+	vehicle_data *veh, *next_veh;
 	room_data *room;
 	int iter;
 	
-	// free island techs
+	// release any vehicles still owned (this also frees the index)
+	HASH_ITER(hh, EMPIRE_VEHICLE_INDEX(emp), vidx, next_vidx) {
+		DL_FOREACH_SAFE2(vidx->vehicles, veh, next_veh, next_owned) {
+			set_vehicle_owner(veh, NULL);
+		}
+	}
+	
+	// free islands and their storage
 	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		HASH_ITER(hh, isle->store, store, next_store) {
+			HASH_DEL(isle->store, store);
+			free(store);
+		}
 		free(isle);
 	}
 	EMPIRE_ISLANDS(emp) = NULL;
-			
-	// free storage
-	while ((store = emp->store)) {
-		emp->store = store->next;
-		store->next = NULL;
-		free(store);
-	}
-	emp->store = NULL;
 	
 	// free unique storage
 	while ((eus = EMPIRE_UNIQUE_STORAGE(emp))) {
@@ -1557,9 +1578,9 @@ void free_empire(empire_data *emp) {
 	}
 	
 	// free territory
-	while ((ter = emp->territory_list)) {
+	HASH_ITER(hh, emp->territory_list, ter, next_ter) {
 		if (ter == global_next_territory_entry) {
-			global_next_territory_entry = ter->next;
+			global_next_territory_entry = ter->hh.next;
 		}
 		
 		// free npcs
@@ -1567,7 +1588,7 @@ void free_empire(empire_data *emp) {
 			delete_territory_npc(ter, ter->npcs);
 		}
 		
-		emp->territory_list = ter->next;
+		HASH_DEL(emp->territory_list, ter);
 		free(ter);
 	}
 	
@@ -1596,6 +1617,10 @@ void free_empire(empire_data *emp) {
 	}
 	ewt_free_tracker(&EMPIRE_WORKFORCE_TRACKER(emp));
 	
+	if (emp->journal) {
+		free(emp->journal);
+	}
+	
 	free(emp);
 }
 
@@ -1610,8 +1635,9 @@ void load_empire_storage_one(FILE *fl, empire_data *emp) {
 	int t[10], junk;
 	long l_in;
 	char line[1024], str_in[256], buf[MAX_STRING_LENGTH];
-	struct empire_storage_data *store, *last_store = NULL;
 	struct empire_unique_storage *eus, *last_eus = NULL;
+	struct empire_storage_data *store;
+	struct empire_island *isle;
 	struct shipping_data *shipd, *last_shipd = NULL;
 	obj_data *obj, *proto;
 	
@@ -1637,19 +1663,18 @@ void load_empire_storage_one(FILE *fl, empire_data *emp) {
 				// validate vnum
 				proto = obj_proto(t[0]);
 				if (proto && proto->storage) {
-					CREATE(store, struct empire_storage_data, 1);
-					store->vnum = t[0];
-					store->amount = t[1];
-					store->island = t[2];
-
-					// at end
-					if (last_store) {
-						last_store->next = store;
-					}
-					else {
-						emp->store = store;
+					isle = get_empire_island(emp, t[2]);
+					HASH_FIND_INT(isle->store, &t[0], store);
+					if (!store) {
+						CREATE(store, struct empire_storage_data, 1);
+						store->vnum = t[0];
+						store->island = t[2];
+						HASH_ADD_INT(isle->store, vnum, store);
 					}
-					last_store = store;
+					
+					isle->store_total -= store->amount;
+					SAFE_ADD(store->amount, t[1], 0, MAX_STORAGE, FALSE);
+					isle->store_total += store->amount;
 				}
 				else if (proto && !proto->storage) {
 					log("- removing %dx #%d from empire storage for %s: not storable", t[1], t[0], EMPIRE_NAME(emp));
@@ -1751,13 +1776,129 @@ void load_empire_storage(void) {
 		if (!(fl = fopen(fname, "r"))) {
 			// it's not considered critical to lack this file
 			log("Unable to open einv file for empire %d %s", EMPIRE_VNUM(emp), EMPIRE_NAME(emp));
-			continue;
+		}
+		else {
+			load_empire_storage_one(fl, emp);
+			fclose(fl);
 		}
 		
-		load_empire_storage_one(fl, emp);
+		// replay anything that changed since the last full save
+		load_empire_journal(emp);
+	}
+}
+
+
+/**
+* Replays an empire's journal file over its loaded empire and storage data.
+* This must run after storage is loaded. Journal entries are absolute (or
+* de-duplicated) so it's safe to replay one that was already saved, and any
+* incomplete last line (e.g. from a crash mid-write) is ignored.
+*
+* @param empire_data *emp The empire whose journal to replay.
+*/
+void load_empire_journal(empire_data *emp) {
+	char fname[MAX_STRING_LENGTH], line[MAX_STRING_LENGTH], *ptr;
+	struct empire_log_data *elog, *last_log;
+	struct empire_storage_data *store;
+	struct empire_island *isle;
+	int t[3], pos, count = 0;
+	long l_in;
+	obj_data *proto;
+	FILE *fl;
+	
+	sprintf(fname, "%s%d%s", LIB_EMPIRE, EMPIRE_VNUM(emp), EMPIRE_JOURNAL_SUFFIX);
+	if (!(fl = fopen(fname, "r"))) {
+		return;	// no changes since the last full save
+	}
+	
+	while (fgets(line, sizeof(line), fl)) {
+		// incomplete line: only the last line can be cut off
+		if (!*line || line[strlen(line) - 1] != '\n') {
+			log("SYSERR: Ignoring incomplete last line of %s", fname);
+			break;
+		}
+		line[strlen(line) - 1] = '\0';
+		++count;
 		
-		fclose(fl);
+		switch (*line) {
+			case 'L': {	// log: L type timestamp string
+				if (sscanf(line, "L %d %ld%n", &t[0], &l_in, &pos) < 2) {
+					log("SYSERR: Bad L line in %s: %s", fname, line);
+					break;
+				}
+				ptr = line + pos;
+				if (*ptr == ' ') {
+					++ptr;	// exactly one separator: the string itself may start with spaces
+				}
+				
+				// skip it if the last full save already had it
+				last_log = NULL;
+				for (elog = EMPIRE_LOGS(emp); elog; elog = elog->next) {
+					if (elog->type == t[0] && elog->timestamp == (time_t) l_in && !strcmp(elog->string, ptr)) {
+						break;
+					}
+					last_log = elog;
+				}
+				if (elog) {
+					break;
+				}
+				
+				CREATE(elog, struct empire_log_data, 1);
+				elog->type = t[0];
+				elog->timestamp = (time_t) l_in;
+				elog->string = str_dup(ptr);
+				elog->next = NULL;
+				
+				if (last_log) {
+					last_log->next = elog;
+				}
+				else {
+					EMPIRE_LOGS(emp) = elog;
+				}
+				break;
+			}
+			case 'O': {	// storage: O vnum island amount
+				if (sscanf(line, "O %d %d %d", &t[0], &t[1], &t[2]) != 3) {
+					log("SYSERR: Bad O line in %s: %s", fname, line);
+					break;
+				}
+				if (!(proto = obj_proto(t[0])) || !proto->storage) {
+					break;	// load_empire_storage_one() already reported these
+				}
+				
+				isle = get_empire_island(emp, t[1]);
+				HASH_FIND_INT(isle->store, &t[0], store);
+				if (!store && t[2] > 0) {
+					CREATE(store, struct empire_storage_data, 1);
+					store->vnum = t[0];
+					store->island = t[1];
+					HASH_ADD_INT(isle->store, vnum, store);
+				}
+				if (store) {
+					isle->store_total += MAX(0, t[2]) - store->amount;
+					store->amount = MAX(0, t[2]);
+					
+					if (store->amount <= 0) {
+						HASH_DEL(isle->store, store);
+						free(store);
+					}
+				}
+				break;
+			}
+			default: {
+				log("SYSERR: Unknown line in %s: %s", fname, line);
+				break;
+			}
+		}
+	}
+	
+	fclose(fl);
+	
+	if (count > 0) {
+		log("Replayed %d journal entr%s for empire %d %s", count, (count != 1 ? "ies" : "y"), EMPIRE_VNUM(emp), EMPIRE_NAME(emp));
+		EMPIRE_NEEDS_SAVE(emp) = TRUE;	// compact it into the empire files
 	}
+	emp->journal_entries = count;
 }
 
 
@@ -2033,7 +2174,7 @@ void parse_empire(FILE *fl, empire_vnum vnum) {
 void write_empire_to_file(FILE *fl, empire_data *emp) {
 	struct empire_island *isle, *next_isle;
 	struct empire_political_data *emp_pol;
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	struct empire_trade_data *trade;
 	struct empire_city_data *city;
 	struct empire_log_data *elog;
@@ -2110,7 +2251,7 @@ void write_empire_to_file(FILE *fl, empire_data *emp) {
 		fprintf(fl, "R%d\n%s~\n", iter, EMPIRE_RANK(emp, iter));
 
 	// T: territory buildings
-	for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = ter->next) {
+	HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
 		fprintf(fl, "T %d %d\n", GET_ROOM_VNUM(ter->room), ter->population_timer);
 	
 		// npcs who live there
@@ -2144,7 +2285,8 @@ void write_empire_to_file(FILE *fl, empire_data *emp) {
 * @param empire_data *emp The empire whose storage to save.
 */
 void write_empire_storage_to_file(FILE *fl, empire_data *emp) {	
-	struct empire_storage_data *store;
+	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle, *next_isle;
 	struct empire_unique_storage *eus;
 	struct shipping_data *shipd;
 
@@ -2153,8 +2295,10 @@ void write_empire_storage_to_file(FILE *fl, empire_data *emp) {
 	}
 
 	// O: storage
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		fprintf(fl, "O\n%d %d %d\n", store->vnum, store->amount, store->island);
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		HASH_ITER(hh, isle->store, store, next_store) {
+			fprintf(fl, "O\n%d %d %d\n", store->vnum, store->amount, store->island);
+		}
 	}
 
 	// U: unique storage
@@ -2188,6 +2332,10 @@ void save_empire(empire_data *emp) {
 	if (!emp) {
 		return;
 	}
+	
+	// flush pending journal lines first: if we crash before the journal is
+	// deleted below, the last entry for everything in it then matches this save
+	write_empire_journal(emp);
 
 	// main empire file
 	sprintf(fname, "%s%d%s", LIB_EMPIRE, EMPIRE_VNUM(emp), EMPIRE_SUFFIX);
@@ -2215,12 +2363,97 @@ void save_empire(empire_data *emp) {
 		fprintf(fl, "$~\n");
 		fclose(fl);
 		rename(tempname, fname);
+		
+		// the journal is now fully contained in the files above (it can't have been replayed before storage loaded)
+		sprintf(fname, "%s%d%s", LIB_EMPIRE, EMPIRE_VNUM(emp), EMPIRE_JOURNAL_SUFFIX);
+		unlink(fname);
+		emp->journal_entries = 0;
+		if (emp->journal) {
+			free(emp->journal);
+			emp->journal = NULL;
+		}
+		emp->journal_size = 0;
 	}
 	
 	EMPIRE_NEEDS_SAVE(emp) = FALSE;	// done
 }
 
 
+/**
+* Appends one line to an empire's pending journal, to be written to its
+* journal file by save_marked_empires(). This is used for frequent changes
+* (storage, logs) instead of EMPIRE_NEEDS_SAVE, which rewrites the whole empire.
+* Journaled data must also be in the full save; see load_empire_journal().
+*
+* @param empire_data *emp The empire.
+* @param const char *str The va-arg format for one line, which must end in a \n.
+* @param ... Arguments for str.
+*/
+void add_to_empire_journal(empire_data *emp, const char *str, ...) {
+	char line[MAX_STRING_LENGTH];
+	va_list tArgList;
+	size_t len;
+	
+	if (!emp || !str) {
+		return;
+	}
+	
+	va_start(tArgList, str);
+	len = vsnprintf(line, sizeof(line), str, tArgList);
+	va_end(tArgList);
+	
+	if (len >= sizeof(line)) {
+		// too long to journal: fall back to a full save
+		EMPIRE_NEEDS_SAVE(emp) = TRUE;
+		return;
+	}
+	
+	RECREATE(emp->journal, char, emp->journal_size + len + 1);
+	strcpy(emp->journal + emp->journal_size, line);
+	emp->journal_size += len;
+}
+
+
+/**
+* Appends an empire's pending journal lines to its journal file. If the file
+* has grown too large, this marks the empire for a full save, which compacts
+* (deletes) the journal.
+*
+* @param empire_data *emp The empire whose journal to write.
+*/
+void write_empire_journal(empire_data *emp) {
+	char fname[64];
+	const char *ptr;
+	FILE *fl;
+	
+	if (!emp->journal) {
+		return;
+	}
+	
+	sprintf(fname, "%s%d%s", LIB_EMPIRE, EMPIRE_VNUM(emp), EMPIRE_JOURNAL_SUFFIX);
+	if (!(fl = fopen(fname, "a"))) {
+		log("SYSERR: Unable to append %s", fname);
+		EMPIRE_NEEDS_SAVE(emp) = TRUE;	// save it the old-fashioned way
+		return;
+	}
+	
+	fputs(emp->journal, fl);
+	fclose(fl);
+	
+	for (ptr = emp->journal; (ptr = strchr(ptr, '\n')); ++ptr) {
+		++emp->journal_entries;
+	}
+	
+	free(emp->journal);
+	emp->journal = NULL;
+	emp->journal_size = 0;
+	
+	if (emp->journal_entries >= EMPIRE_JOURNAL_MAX_ENTRIES) {
+		EMPIRE_NEEDS_SAVE(emp) = TRUE;	// compact on the next save
+	}
+}
+
+
 /**
 * Saves all empires.
 */
@@ -2234,7 +2467,8 @@ void save_all_empires(void) {
 
 
 /**
-* Delayed empire saves -- things marked EMPIRE_NEEDS_SAVE.
+* Delayed empire saves -- things marked EMPIRE_NEEDS_SAVE get a full save,
+* and anything else with pending journal lines gets those appended.
 */
 void save_marked_empires(void) {
 	empire_data *emp, *next_emp;
@@ -2243,6 +2477,9 @@ void save_marked_empires(void) {
 		if (EMPIRE_NEEDS_SAVE(emp)) {
 			save_empire(emp);
 		}
+		else if (emp->journal) {
+			write_empire_journal(emp);
+		}
 	}
 }
 
@@ -2413,9 +2650,7 @@ void update_empire_npc_data(void) {
 		}
 		
 		// each territory spot
-		for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = next_ter) {
-			next_ter = ter->next;
-			
+		HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
 			if (--ter->population_timer <= 0) {
 				populate_npc(ter->room, ter);
 			}
@@ -2481,8 +2716,10 @@ void kill_empire_npc(char_data *ch) {
 	}
 	
 	// find and remove the entry
-	for (ter = EMPIRE_TERRITORY_LIST(emp); ter && !found; ter = ter_next) {
-		ter_next = ter->next;
+	HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, ter_next) {
+		if (found) {
+			break;
+		}
 		
 		for (npc = ter->npcs; npc && !found; npc = npc_next) {
 			npc_next = npc->next;
@@ -2698,7 +2935,9 @@ void add_global_to_table(struct global_data *glb) {
 		HASH_FIND_INT(globals_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(globals_table, vnum, glb);
-			HASH_SORT(globals_table, sort_globals);
+			if (!defer_table_sorts) {
+				HASH_SORT(globals_table, sort_globals);
+			}
 		}
 	}
 }
@@ -3345,7 +3584,9 @@ void add_mobile_to_table(char_data *mob) {
 		HASH_FIND_INT(mobile_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(mobile_table, vnum, mob);
-			HASH_SORT(mobile_table, sort_mobiles);
+			if (!defer_table_sorts) {
+				HASH_SORT(mobile_table, sort_mobiles);
+			}
 		}
 	}
 }
@@ -3553,7 +3794,9 @@ void add_object_to_table(obj_data *obj) {
 		HASH_FIND_INT(object_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(object_table, vnum, obj);
-			HASH_SORT(object_table, sort_objects);
+			if (!defer_table_sorts) {
+				HASH_SORT(object_table, sort_objects);
+			}
 		}
 	}
 }
@@ -4072,7 +4315,10 @@ void write_resources_to_file(FILE *fl, char letter, struct resource_data *list)
 * @param room_data *room The room to add.
 */
 void add_room_to_world_tables(room_data *room) {	
+	void add_room_to_world_block(room_data *room);
+	
 	HASH_ADD_INT(world_table, vnum, room);
+	add_room_to_world_block(room);
 	
 	// interior linked list
 	if (GET_ROOM_VNUM(room) >= MAP_SIZE) {
@@ -4090,9 +4336,12 @@ void add_room_to_world_tables(room_data *room) {
 * @param room_data *room The room to remove.
 */
 void remove_room_from_world_tables(room_data *room) {
+	void remove_room_from_world_block(room_data *room);
+	
 	room_data *temp;
 	
 	HASH_DEL(world_table, room);
+	remove_room_from_world_block(room);
 	
 	if (room->vnum >= MAP_SIZE) {
 		REMOVE_FROM_LIST(room, interior_room_list, next_interior);
@@ -4628,7 +4877,9 @@ void add_room_template_to_table(room_template *rmt) {
 		HASH_FIND_INT(room_template_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(room_template_table, vnum, rmt);
-			HASH_SORT(room_template_table, sort_room_templates);
+			if (!defer_table_sorts) {
+				HASH_SORT(room_template_table, sort_room_templates);
+			}
 		}
 	}
 }
@@ -4914,7 +5165,9 @@ void add_sector_to_table(sector_data *sect) {
 		HASH_FIND_INT(sector_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(sector_table, vnum, sect);
-			HASH_SORT(sector_table, sort_sectors);
+			if (!defer_table_sorts) {
+				HASH_SORT(sector_table, sort_sectors);
+			}
 		}
 	}
 }
@@ -5208,7 +5461,9 @@ void add_trigger_to_table(trig_data *trig) {
 		HASH_FIND_INT(trigger_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(trigger_table, vnum, trig);
-			HASH_SORT(trigger_table, sort_triggers);
+			if (!defer_table_sorts) {
+				HASH_SORT(trigger_table, sort_triggers);
+			}
 		}
 	}
 }
@@ -5437,6 +5692,153 @@ void discrete_load(FILE *fl, int mode, char *filename) {
 }
 
 
+/**
+* Sorts the table(s) for one DB_BOOT_ type. During index_boot(), the
+* add_*_to_table() functions skip their sorts (which would otherwise re-sort
+* the whole table for every record loaded) and this sorts them once at the end.
+*
+* @param int mode Any DB_BOOT_ const.
+*/
+void sort_tables_for_boot_mode(int mode) {
+	extern int sort_abilities(ability_data *a, ability_data *b);
+	extern int sort_abilities_by_data(ability_data *a, ability_data *b);
+	extern int sort_accounts(account_data *a, account_data *b);
+	extern int sort_adventures(adv_data *a, adv_data *b);
+	extern int sort_archetypes(archetype_data *a, archetype_data *b);
+	extern int sort_archetypes_by_data(archetype_data *a, archetype_data *b);
+	extern int sort_augments(augment_data *a, augment_data *b);
+	extern int sort_augments_by_data(augment_data *a, augment_data *b);
+	extern int sort_book_table(book_data *a, book_data *b);
+	extern int sort_buildings(bld_data *a, bld_data *b);
+	extern int sort_classes(class_data *a, class_data *b);
+	extern int sort_classes_by_data(class_data *a, class_data *b);
+	extern int sort_crafts_by_data(craft_data *a, craft_data *b);
+	extern int sort_crafts_by_vnum(craft_data *a, craft_data *b);
+	extern int sort_crops(crop_data *a, crop_data *b);
+	extern int sort_factions(faction_data *a, faction_data *b);
+	extern int sort_factions_by_data(faction_data *a, faction_data *b);
+	extern int sort_globals(struct global_data *a, struct global_data *b);
+	extern int sort_mobiles(char_data *a, char_data *b);
+	extern int sort_morphs(morph_data *a, morph_data *b);
+	extern int sort_morphs_by_data(morph_data *a, morph_data *b);
+	extern int sort_objects(obj_data *a, obj_data *b);
+	extern int sort_quests(quest_data *a, quest_data *b);
+	extern int sort_sectors(void *a, void *b);
+	extern int sort_skills(skill_data *a, skill_data *b);
+	extern int sort_skills_by_data(skill_data *a, skill_data *b);
+	void sort_socials(void);
+	extern int sort_socials_by_vnum(social_data *a, social_data *b);
+	extern int sort_triggers(trig_data *a, trig_data *b);
+	extern int sort_vehicles(vehicle_data *a, vehicle_data *b);
+	
+	// DB_BOOT_x: any type whose add_*_to_table() sorts
+	switch (mode) {
+		case DB_BOOT_ABIL: {
+			HASH_SORT(ability_table, sort_abilities);
+			HASH_SRT(sorted_hh, sorted_abilities, sort_abilities_by_data);
+			break;
+		}
+		case DB_BOOT_ACCT: {
+			HASH_SORT(account_table, sort_accounts);
+			break;
+		}
+		case DB_BOOT_ADV: {
+			HASH_SORT(adventure_table, sort_adventures);
+			break;
+		}
+		case DB_BOOT_ARCH: {
+			HASH_SORT(archetype_table, sort_archetypes);
+			HASH_SRT(sorted_hh, sorted_archetypes, sort_archetypes_by_data);
+			break;
+		}
+		case DB_BOOT_AUG: {
+			HASH_SORT(augment_table, sort_augments);
+			HASH_SRT(sorted_hh, sorted_augments, sort_augments_by_data);
+			break;
+		}
+		case DB_BOOT_BLD: {
+			HASH_SORT(building_table, sort_buildings);
+			break;
+		}
+		case DB_BOOT_BOOKS: {
+			HASH_SORT(book_table, sort_book_table);
+			break;
+		}
+		case DB_BOOT_CLASS: {
+			HASH_SORT(class_table, sort_classes);
+			HASH_SRT(sorted_hh, sorted_classes, sort_classes_by_data);
+			break;
+		}
+		case DB_BOOT_CRAFT: {
+			HASH_SORT(craft_table, sort_crafts_by_vnum);
+			HASH_SRT(sorted_hh, sorted_crafts, sort_crafts_by_data);
+			break;
+		}
+		case DB_BOOT_CROP: {
+			HASH_SORT(crop_table, sort_crops);
+			break;
+		}
+		case DB_BOOT_EMP: {
+			HASH_SORT(empire_table, sort_empires);
+			break;
+		}
+		case DB_BOOT_FCT: {
+			HASH_SORT(faction_table, sort_factions);
+			HASH_SRT(sorted_hh, sorted_factions, sort_factions_by_data);
+			break;
+		}
+		case DB_BOOT_GLB: {
+			HASH_SORT(globals_table, sort_globals);
+			break;
+		}
+		case DB_BOOT_MOB: {
+			HASH_SORT(mobile_table, sort_mobiles);
+			break;
+		}
+		case DB_BOOT_MORPH: {
+			HASH_SORT(morph_table, sort_morphs);
+			HASH_SRT(sorted_hh, sorted_morphs, sort_morphs_by_data);
+			break;
+		}
+		case DB_BOOT_OBJ: {
+			HASH_SORT(object_table, sort_objects);
+			break;
+		}
+		case DB_BOOT_QST: {
+			HASH_SORT(quest_table, sort_quests);
+			break;
+		}
+		case DB_BOOT_RMT: {
+			HASH_SORT(room_template_table, sort_room_templates);
+			break;
+		}
+		case DB_BOOT_SECTOR: {
+			HASH_SORT(sector_table, sort_sectors);
+			break;
+		}
+		case DB_BOOT_SKILL: {
+			HASH_SORT(skill_table, sort_skills);
+			HASH_SRT(sorted_hh, sorted_skills, sort_skills_by_data);
+			break;
+		}
+		case DB_BOOT_SOC: {
+			HASH_SORT(social_table, sort_socials_by_vnum);
+			sort_socials();
+			break;
+		}
+		case DB_BOOT_TRG: {
+			HASH_SORT(trigger_table, sort_triggers);
+			break;
+		}
+		case DB_BOOT_VEH: {
+			HASH_SORT(vehicle_table, sort_vehicles);
+			break;
+		}
+		// DB_BOOT_WLD is sorted on demand by sort_world_table()
+	}
+}
+
+
 /**
 * index_boot: Loads an index file for a given type, and loads each entry from
 * the index using discrete_load.
@@ -5625,6 +6027,7 @@ void index_boot(int mode) {
 		}
 	}
 	rewind(index);
+	defer_table_sorts = TRUE;	// sorted once below
 	fscanf(index, "%s\n", buf1);
 	while (*buf1 != '$') {
 		sprintf(buf2, "%s%s", prefix, buf1);
@@ -5671,6 +6074,9 @@ void index_boot(int mode) {
 		fscanf(index, "%s\n", buf1);
 	}
 	fclose(index);
+	
+	defer_table_sorts = FALSE;
+	sort_tables_for_boot_mode(mode);
 }
 
 
@@ -6443,6 +6849,51 @@ room_data *real_room(room_vnum vnum) {
 }
 
 
+/**
+* Fetches a room by vnum for display purposes only. If a map room is not in
+* memory, this does NOT load it (real_room() would add it to the world_table
+* until update_world() unloads it again). Instead, it returns a temporary copy
+* built from the world_map, which is all an unloaded map tile has anyway.
+*
+* WARNING: Temporary rooms are recycled after NUM_VIEW_ROOMS more calls. Never
+* modify, store, or put anything into the result; use real_room() for that.
+*
+* @param room_vnum vnum The vnum to look up.
+* @return room_data* A pointer to the room (maybe temporary), or NULL.
+*/
+room_data *real_view_room(room_vnum vnum) {
+	static room_data view_rooms[NUM_VIEW_ROOMS];
+	static int last_view_room = 0;
+	
+	struct map_data *map;
+	room_data *room;
+	
+	// sheer sanity
+	if (vnum < 0 || vnum == NOWHERE) {
+		return NULL;
+	}
+	
+	// real rooms (and non-map rooms) are returned as-is
+	if ((room = real_real_room(vnum)) || vnum >= MAP_SIZE) {
+		return room;
+	}
+	
+	map = &(world_map[MAP_X_COORD(vnum)][MAP_Y_COORD(vnum)]);
+	
+	last_view_room = (last_view_room + 1) % NUM_VIEW_ROOMS;
+	room = &view_rooms[last_view_room];
+	memset((char *) room, 0, sizeof(room_data));
+	
+	// same data load_map_room() would set
+	room->vnum = vnum;
+	SECT(room) = map->sector_type;
+	BASE_SECT(room) = map->base_sector;
+	ROOM_CROP(room) = map->crop_type;
+	
+	return room;
+}
+
+
 /**
 * @param rmt_vnum vnum Any room template vnum
 * @return room_template* The template, or NULL if it doesn't exist
@@ -7011,82 +7462,51 @@ int sort_sectors(void *a, void *b) {
 }
 
 
-// for sort_storage: quick-switch of linked list positions
-static struct empire_storage_data *switch_storage_pos(struct empire_storage_data *l1, struct empire_storage_data *l2) {
-    l1->next = l2->next;
-    l2->next = l1;
-    return l2;
+/**
+* Sorter for empire storage: by storage location, then alphabetically.
+*
+* @param struct empire_storage_data *a One element
+* @param struct empire_storage_data *b Another element
+* @return int Sort instruction of <0, 0, or >0
+*/
+int sort_storage_by_name(struct empire_storage_data *a, struct empire_storage_data *b) {
+	obj_data *obj_a = obj_proto(a->vnum), *obj_b = obj_proto(b->vnum);
+	char *a_name, *b_name;
+	int a_store, b_store;
+	
+	// [hopefully] quick macro to skip past a/an/the before comparing names
+	#define FIND_NAME_START(str)  (!strn_cmp((str), "the ", 4) ? ((str)+4) : (!strn_cmp((str), "an ", 3) ? ((str) + 3) : (!strn_cmp((str), "a ", 2) ? ((str) + 2) : (str))))
+	
+	// only bother if the item is real (this accommodates deleted items)
+	if (!obj_a || !obj_b) {
+		return 0;
+	}
+	
+	a_store = find_lowest_storage_loc(obj_a);
+	b_store = find_lowest_storage_loc(obj_b);
+	if (a_store != b_store) {
+		return (a_store < b_store) ? -1 : 1;
+	}
+	
+	// skip a/an/the
+	a_name = GET_OBJ_SHORT_DESC(obj_a);
+	b_name = GET_OBJ_SHORT_DESC(obj_b);
+	return str_cmp(FIND_NAME_START(a_name), FIND_NAME_START(b_name));
 }
 
 
 /**
-* This alpha-sorts an empire's storage.
+* This alpha-sorts an empire's storage on one island. Storage is otherwise
+* kept in the order it was added, so this is only done when it's displayed or
+* picked from by position.
 *
-* @param empire_data *emp The empire to sort.
+* @param struct empire_island *isle The empire island whose storage to sort.
 */
-void sort_storage(empire_data *emp) {
-	struct empire_storage_data *start, *p, *q, *top;
-	char *a_name = NULL, *b_name = NULL;
-	obj_data *obj_a, *obj_b;
-	int a_store, b_store;
-    bool changed = TRUE;
-    
-    // [hopefully] quick macro to skip past a/an/the before comparing names
-    #define FIND_NAME_START(str)  (!strn_cmp((str), "the ", 4) ? ((str)+4) : (!strn_cmp((str), "an ", 3) ? ((str) + 3) : (!strn_cmp((str), "a ", 2) ? ((str) + 2) : (str))))
-    
-    // safety first
-    if (!emp) {
-    	return;
-    }
-    
-    start = EMPIRE_STORAGE(emp);
-
-	CREATE(top, struct empire_storage_data, 1);
-
-    top->next = start;
-    if (start && start->next) {
-    	// q is always one item behind p
-
-        while (changed) {
-            changed = FALSE;
-            q = top;
-            p = top->next;
-            while (p->next != NULL) {
-            	// determine items
-            	obj_a = obj_proto(p->vnum);
-            	obj_b = obj_proto(p->next->vnum);
-            	
-            	// only bother if the item is real (this accommodates deleted items)
-            	if (obj_a && obj_b) {
-					a_store = find_lowest_storage_loc(obj_a);
-					b_store = find_lowest_storage_loc(obj_b);
-				
-					// prepare for alpha-sorting ...
-					if (a_store == b_store) {
-						a_name = GET_OBJ_SHORT_DESC(obj_a);
-						b_name = GET_OBJ_SHORT_DESC(obj_b);
-				
-						// skip a/an/the
-						a_name = FIND_NAME_START(a_name);
-						b_name = FIND_NAME_START(b_name);
-					}
-				
-					if (a_store > b_store || (a_store == b_store && str_cmp(a_name, b_name) > 0)) {
-						q->next = switch_storage_pos(p, p->next);
-						changed = TRUE;
-					}
-				}
-				
-                q = p;
-                if (p->next) {
-                    p = p->next;
-                }
-            }
-        }
-    }
-    
-    EMPIRE_STORAGE(emp) = top->next;
-    free(top);
+void sort_storage(struct empire_island *isle) {
+	// safety first
+	if (isle) {
+		HASH_SORT(isle->store, sort_storage_by_name);
+	}
 }
 
 
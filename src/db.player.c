@@ -10,6 +10,8 @@
 *  CircleMUD is based on DikuMUD, Copyright (C) 1990, 1991.               *
 ************************************************************************ */
 
+#define __DB_PLAYER_C__
+
 #include "conf.h"
 #include "sysdep.h"
 
@@ -51,7 +53,12 @@ extern int top_idnum;
 ACMD(do_slash_channel);
 void update_class(char_data *ch);
 
+// local vars
+bool player_index_needs_save = FALSE;	// triggers save_player_index_file()
+
 // local protos
+static void add_player_to_table_unsorted(player_index_data *plr);
+void free_player_index_data(player_index_data *index);
 void clear_player(char_data *ch);
 void delete_player_character(char_data *ch);
 static bool member_is_timed_out(time_t created, time_t last_login, double played_hours);
@@ -209,7 +216,9 @@ void add_account_to_table(account_data *acct) {
 		HASH_FIND_INT(account_table, &id, find);
 		if (!find) {
 			HASH_ADD_INT(account_table, id, acct);
-			HASH_SORT(account_table, sort_accounts);
+			if (!defer_table_sorts) {
+				HASH_SORT(account_table, sort_accounts);
+			}
 		}
 	}
 }
@@ -587,6 +596,19 @@ void write_account_to_file(FILE *fl, account_data *acct) {
 * @param player_index_data *plr The player to add.
 */
 void add_player_to_table(player_index_data *plr) {
+	add_player_to_table_unsorted(plr);
+	HASH_SRT(idnum_hh, player_table_by_idnum, sort_players_by_idnum);
+	HASH_SRT(name_hh, player_table_by_name, sort_players_by_name);
+}
+
+
+/**
+* Adds a player to the player tables (by_name and by_idnum) without sorting
+* them, for bulk loads. The caller must sort both tables afterwards.
+*
+* @param player_index_data *plr The player to add.
+*/
+static void add_player_to_table_unsorted(player_index_data *plr) {
 	player_index_data *find;
 	int idnum = plr->idnum;
 	
@@ -595,7 +617,6 @@ void add_player_to_table(player_index_data *plr) {
 	HASH_FIND(idnum_hh, player_table_by_idnum, &idnum, sizeof(int), find);
 	if (!find) {
 		HASH_ADD(idnum_hh, player_table_by_idnum, idnum, sizeof(int), plr);
-		HASH_SRT(idnum_hh, player_table_by_idnum, sort_players_by_idnum);
 	}
 	
 	// by name: ensure name is lowercase
@@ -604,8 +625,109 @@ void add_player_to_table(player_index_data *plr) {
 	HASH_FIND(name_hh, player_table_by_name, plr->name, strlen(plr->name), find);
 	if (!find) {
 		HASH_ADD(name_hh, player_table_by_name, name[0], strlen(plr->name), plr);
-		HASH_SRT(name_hh, player_table_by_name, sort_players_by_name);
 	}
+	
+	player_index_needs_save = TRUE;
+}
+
+
+/**
+* Reads the cached player index (PLAYER_INDEX_FILE) into a temporary hash by
+* name, for build_player_index(). Entries are only used if the player's file
+* hasn't been saved since the cache was written.
+*
+* @param time_t *cache_time A variable to store the time the cache was written (0 if none).
+* @return player_index_data* A hash (name_hh) of cached entries, or NULL if there's no cache.
+*/
+static player_index_data *load_player_index_file(time_t *cache_time) {
+	char line[MAX_INPUT_LENGTH], name[MAX_INPUT_LENGTH], flags[MAX_INPUT_LENGTH], error[MAX_STRING_LENGTH];
+	player_index_data *hash = NULL, *index, *find;
+	long long_in[4];
+	int int_in[7];
+	struct stat st;
+	FILE *fl;
+	
+	*cache_time = 0;
+	if (!(fl = fopen(PLAYER_INDEX_FILE, "r"))) {
+		return NULL;	// no cache: everyone will be loaded from file
+	}
+	if (fstat(fileno(fl), &st) == 0) {
+		*cache_time = st.st_mtime;
+	}
+	
+	while (get_line(fl, line) && *line == 'P') {
+		if (sscanf(line, "P %d %s %d %ld %ld %ld %d %s %d %d %d", &int_in[0], name, &int_in[1], &long_in[0], &long_in[1], &long_in[2], &int_in[2], flags, &int_in[3], &int_in[4], &int_in[5]) != 11) {
+			log("SYSERR: Bad line in player index cache, ignoring the rest: %s", line);
+			break;
+		}
+		
+		CREATE(index, player_index_data, 1);
+		index->idnum = int_in[0];
+		index->name = str_dup(name);
+		index->account_id = int_in[1];
+		index->last_logon = long_in[0];
+		index->birth = long_in[1];
+		index->played = long_in[2];
+		index->access_level = int_in[2];
+		index->plr_flags = asciiflag_conv(flags);
+		index->loyalty = (int_in[3] != NOTHING) ? real_empire(int_in[3]) : NULL;
+		index->rank = int_in[4];
+		index->greatness = int_in[5];
+		
+		snprintf(error, sizeof(error), "player index cache entry for %s", name);
+		index->fullname = fread_string(fl, error);
+		index->last_host = fread_string(fl, error);
+		if (!*index->last_host) {
+			free(index->last_host);
+			index->last_host = NULL;
+		}
+		
+		HASH_FIND(name_hh, hash, index->name, strlen(index->name), find);
+		if (find) {	// should never happen
+			free_player_index_data(index);
+			continue;
+		}
+		HASH_ADD(name_hh, hash, name[0], strlen(index->name), index);
+	}
+	
+	fclose(fl);
+	return hash;
+}
+
+
+/**
+* Writes the player index to PLAYER_INDEX_FILE so the next startup doesn't
+* have to load every player file. This is cheap to skip: any player saved
+* after the last write is re-read from their own file at startup.
+*
+* @param bool force If TRUE, saves even if nothing changed.
+*/
+void save_player_index_file(bool force) {
+	player_index_data *index, *next_index;
+	char temp[MAX_STRING_LENGTH];
+	FILE *fl;
+	
+	if (!force && !player_index_needs_save) {
+		return;
+	}
+	
+	if (!(fl = fopen(PLAYER_INDEX_FILE TEMP_SUFFIX, "w"))) {
+		log("SYSERR: Unable to write %s", PLAYER_INDEX_FILE TEMP_SUFFIX);
+		return;
+	}
+	
+	HASH_ITER(idnum_hh, player_table_by_idnum, index, next_index) {
+		strcpy(temp, bitv_to_alpha(index->plr_flags));
+		fprintf(fl, "P %d %s %d %ld %ld %ld %d %s %d %d %d\n", index->idnum, index->name, index->account_id, (long)index->last_logon, (long)index->birth, (long)index->played, index->access_level, temp, index->loyalty ? EMPIRE_VNUM(index->loyalty) : NOTHING, index->rank, index->greatness);
+		fprintf(fl, "%s~\n", NULLSAFE(index->fullname));
+		fprintf(fl, "%s~\n", NULLSAFE(index->last_host));
+	}
+	
+	fprintf(fl, "$\n");
+	fclose(fl);
+	rename(PLAYER_INDEX_FILE TEMP_SUFFIX, PLAYER_INDEX_FILE);
+	
+	player_index_needs_save = FALSE;
 }
 
 
@@ -619,11 +741,17 @@ void add_player_to_table(player_index_data *plr) {
 */
 void build_player_index(void) {
 	struct account_player *plr, *next_plr, *temp;
+	player_index_data *index, *cache, *next_cache;
+	char filename[256];
 	account_data *acct, *next_acct;
-	player_index_data *index;
+	int from_cache = 0, from_file = 0;
+	time_t cache_time;
+	struct stat st;
 	bool has_players;
 	char_data *ch;
 	
+	cache = load_player_index_file(&cache_time);
+	
 	HASH_ITER(hh, account_table, acct, next_acct) {
 		acct->last_logon = 0;	// reset
 		
@@ -634,6 +762,21 @@ void build_player_index(void) {
 		for (plr = acct->players; plr; plr = next_plr) {
 			next_plr = plr->next;
 			
+			// try the cache first: only if the player file is older than the cache
+			if (!plr->player && cache && plr->name && *plr->name) {
+				strcpy(filename, plr->name);
+				strtolower(filename);
+				HASH_FIND(name_hh, cache, filename, strlen(filename), index);
+				
+				if (index && index->account_id == acct->id && get_filename(plr->name, filename, PLR_FILE) && stat(filename, &st) == 0 && st.st_mtime < cache_time) {
+					HASH_DELETE(name_hh, cache, index);
+					add_player_to_table_unsorted(index);
+					plr->player = index;
+					top_idnum = MAX(top_idnum, index->idnum);
+					++from_cache;
+				}
+			}
+			
 			if (!plr->player) {
 				// load the character
 				ch = NULL;
@@ -657,9 +800,11 @@ void build_player_index(void) {
 				GET_ACCOUNT(ch) = acct;	// not set by load_player
 				
 				CREATE(index, player_index_data, 1);
+				index->greatness = -1;	// not known until they're in-game or read_empire_members() loads them
 				update_player_index(index, ch);
-				add_player_to_table(index);
+				add_player_to_table_unsorted(index);
 				plr->player = index;
+				++from_file;
 				
 				// detect top idnum
 				top_idnum = MAX(top_idnum, GET_IDNUM(ch));
@@ -667,6 +812,9 @@ void build_player_index(void) {
 				// unload character
 				free_char(ch);
 			}
+			else {
+				has_players = TRUE;
+			}
 			
 			// update last logon
 			acct->last_logon = MAX(acct->last_logon, plr->player->last_logon);
@@ -680,6 +828,21 @@ void build_player_index(void) {
 			free_account(acct);
 		}
 	}
+	
+	// sort once at the end instead of on every add
+	HASH_SRT(idnum_hh, player_table_by_idnum, sort_players_by_idnum);
+	HASH_SRT(name_hh, player_table_by_name, sort_players_by_name);
+	
+	// anything left in the cache is stale (deleted or renamed players)
+	HASH_ITER(name_hh, cache, index, next_cache) {
+		HASH_DELETE(name_hh, cache, index);
+		free_player_index_data(index);
+	}
+	
+	log("Indexed %d player%s (%d from cache, %d from file)", from_cache + from_file, PLURAL(from_cache + from_file), from_cache, from_file);
+	
+	// rewrite the cache if anything had to be loaded from file
+	save_player_index_file(from_file > 0);
 }
 
 
@@ -1927,6 +2090,7 @@ char_data *read_player_from_file(FILE *fl, char *name, bool normal, char_data *c
 void remove_player_from_table(player_index_data *plr) {
 	HASH_DELETE(idnum_hh, player_table_by_idnum, plr);
 	HASH_DELETE(name_hh, player_table_by_name, plr);
+	player_index_needs_save = TRUE;
 }
 
 
@@ -2075,12 +2239,19 @@ void update_player_index(player_index_data *index, char_data *ch) {
 	index->loyalty = GET_LOYALTY(ch);
 	index->rank = GET_RANK(ch);
 	
+	// greatness is only accurate once their gear/affects are applied (in-game)
+	if (IN_ROOM(ch)) {
+		index->greatness = GET_GREATNESS(ch);
+	}
+	
 	if (ch->desc || ch->prev_host) {
 		if (index->last_host) {
 			free(index->last_host);
 		}
 		index->last_host = str_dup(ch->desc ? ch->desc->host : ch->prev_host);
 	}
+	
+	player_index_needs_save = TRUE;
 }
 
 
@@ -3232,6 +3403,7 @@ void enter_player_game(descriptor_data *d, int dolog, bool fresh) {
 	}
 	if (!(index = find_player_index_by_idnum(GET_IDNUM(ch)))) {
 		CREATE(index, player_index_data, 1);
+		index->greatness = -1;
 		update_player_index(index, ch);
 		add_player_to_table(index);
 	}
@@ -3590,6 +3762,7 @@ void init_player(char_data *ch) {
 	// ensure in index
 	if (!(index = find_player_index_by_idnum(GET_IDNUM(ch)))) {
 		CREATE(index, player_index_data, 1);
+		index->greatness = -1;
 		update_player_index(index, ch);
 		add_player_to_table(index);
 	}
@@ -4055,7 +4228,26 @@ void read_empire_members(empire_data *only_empire, bool read_techs) {
 	}
 	
 	HASH_ITER(idnum_hh, player_table_by_idnum, index, next_index) {
-		if (only_empire && index->loyalty != only_empire) {
+		if (!index->loyalty || (only_empire && index->loyalty != only_empire)) {
+			continue;
+		}
+		
+		// offline members can be counted from the index alone, unless techs are needed
+		if (!is_playing(index->idnum) && (member_is_timed_out_index(index) || (!read_techs && index->greatness >= 0))) {
+			e = index->loyalty;
+			if (index->last_logon > EMPIRE_LAST_LOGON(e)) {
+				EMPIRE_LAST_LOGON(e) = index->last_logon;
+			}
+			if (index->access_level >= LVL_GOD) {
+				EMPIRE_IMM_ONLY(e) = 1;
+			}
+			
+			EMPIRE_TOTAL_MEMBER_COUNT(e) += 1;
+			
+			if (!member_is_timed_out_index(index)) {
+				add_to_account_list(&account_list, e, index->account_id, index->greatness);
+				EMPIRE_TOTAL_PLAYTIME(e) += (index->played / SECS_PER_REAL_HOUR);
+			}
 			continue;
 		}
 		
@@ -4063,6 +4255,12 @@ void read_empire_members(empire_data *only_empire, bool read_techs) {
 		if ((ch = find_or_load_player(index->name, &is_file))) {
 			check_delayed_load(ch);
 			affect_total(ch);
+			
+			// remember greatness so the next re-read can skip loading them
+			if (index->greatness != GET_GREATNESS(ch)) {
+				index->greatness = GET_GREATNESS(ch);
+				player_index_needs_save = TRUE;
+			}
 		}
 		
 		// check ch for empire traits
@@ -10,6 +10,8 @@
 *  CircleMUD is based on DikuMUD, Copyright (C) 1990, 1991.               *
 ************************************************************************ */
 
+#define __DB_WORLD_C__
+
 #include <math.h>
 
 #include "conf.h"
@@ -48,6 +50,7 @@ extern bool world_map_needs_save;
 extern struct map_data *last_evo_tile;
 extern sector_data *last_evo_sect;
 extern int evos_per_hour;
+extern int evos_behind;
 
 
 // external funcs
@@ -63,6 +66,9 @@ void save_and_close_world_file(FILE *fl, int block);
 void setup_start_locations();
 void sort_exits(struct room_direction_data **list);
 void sort_world_table();
+void stats_adjust_building_count(bld_data *bdg, int amount);
+void stats_adjust_crop_count(crop_data *cp, int amount);
+void stats_adjust_sector_count(sector_data *sect, int amount);
 void write_room_to_file(FILE *fl, room_data *room);
 
 // locals
@@ -75,6 +81,7 @@ void grow_crop(room_data *room);
 void init_room(room_data *room, room_vnum vnum);
 void naturalize_newbie_islands();
 void ruin_one_building(room_data *room);
+void save_world_index();
 void save_world_map_to_file();
 extern int sort_empire_islands(struct empire_island *a, struct empire_island *b);
 void update_island_names();
@@ -321,7 +328,7 @@ room_data *create_room(void) {
 	
 	// only if saveable
 	if (!CAN_UNLOAD_MAP_ROOM(room)) {
-		need_world_index = TRUE;
+		request_world_save(GET_ROOM_VNUM(room));
 	}
 	
 	return room;
@@ -347,7 +354,7 @@ void delete_room(room_data *room, bool check_exits) {
 
 	struct room_direction_data *ex, *next_ex, *temp;
 	struct room_extra_data *room_ex, *next_room_ex;
-	struct empire_territory_data *ter, *next_ter;
+	struct empire_territory_data *ter;
 	struct empire_city_data *city, *next_city;
 	room_data *rm_iter, *next_rm, *home;
 	vehicle_data *veh, *next_veh;
@@ -450,6 +457,10 @@ void delete_room(room_data *room, bool check_exits) {
 		free(track);
 	}
 	if (COMPLEX_DATA(room)) {
+		if (GET_ROOM_VNUM(room) < MAP_SIZE) {
+			stats_adjust_building_count(GET_BUILDING(room), -1);
+		}
+		update_building_index(room, GET_BUILDING(room), NULL);
 		free_complex_data(COMPLEX_DATA(room));
 		COMPLEX_DATA(room) = NULL;
 	}
@@ -545,12 +556,8 @@ void delete_room(room_data *room, bool check_exits) {
 	// update empires
 	HASH_ITER(hh, empire_table, emp, next_emp) {
 		// update empire territory
-		for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = next_ter) {
-			next_ter = ter->next;
-			
-			if (ter->room == room) {
-				delete_territory_entry(emp, ter);
-			}
+		if ((ter = find_territory_entry(emp, room))) {
+			delete_territory_entry(emp, ter);
 		}
 		
 		// update all empire cities
@@ -568,12 +575,16 @@ void delete_room(room_data *room, bool check_exits) {
 		setup_start_locations();
 	}
 	
+	// interiors must be removed from their .wld file (unloaded map rooms aren't in it)
+	if (GET_ROOM_VNUM(room) >= MAP_SIZE) {
+		request_world_save(GET_ROOM_VNUM(room));
+	}
+	
 	// free the room
 	free(room);
 		
 	// maybe
 	// world_is_sorted = FALSE;
-	need_world_index = TRUE;
 }
 
 
@@ -751,9 +762,13 @@ void set_crop_type(room_data *room, crop_data *cp) {
 	}
 	
 	ROOM_CROP(room) = cp;
+	request_world_save(GET_ROOM_VNUM(room));
 	if (GET_ROOM_VNUM(room) < MAP_SIZE) {
+		stats_adjust_crop_count(world_map[FLAT_X_COORD(room)][FLAT_Y_COORD(room)].crop_type, -1);
+		stats_adjust_crop_count(cp, 1);
 		world_map[FLAT_X_COORD(room)][FLAT_Y_COORD(room)].crop_type = cp;
 		world_map_needs_save = TRUE;
+		clear_map_render_cache(GET_ROOM_VNUM(room));
 	}
 }
 
@@ -761,23 +776,263 @@ void set_crop_type(room_data *room, crop_data *cp) {
  //////////////////////////////////////////////////////////////////////////////
 //// MANAGEMENT //////////////////////////////////////////////////////////////
 
+// world blocks that have rooms in them, and whether or not their .wld files need saving
+struct world_block_data {
+	int rooms;	// number of rooms in the world_table that are in this block
+	bool needs_save;	// block's .wld file is out of date
+	bool new_block;	// block's .wld file may not exist yet (must save before the world index lists it)
+};
+
+static struct world_block_data *world_blocks = NULL;	// indexed by GET_WORLD_BLOCK()
+static int num_world_blocks = 0;	// size of the world_blocks array
+static int next_world_block_save = 0;	// where save_world_blocks() resumes
+
+// rooms whose objpacks need saving, without saving their whole world block
+struct objpack_save_data {
+	room_vnum vnum;	// the room
+	UT_hash_handle hh;	// objpack_saves hash
+};
+
+static struct objpack_save_data *objpack_saves = NULL;	// hash of rooms by vnum
+
+
+/**
+* Finds the save data for a world block, expanding the world_blocks array if
+* necessary.
+*
+* @param int block Which world block (see GET_WORLD_BLOCK).
+* @return struct world_block_data* The block's data, or NULL if the block is invalid.
+*/
+static struct world_block_data *get_world_block(int block) {
+	int old_size;
+	
+	if (block < 0) {
+		return NULL;
+	}
+	
+	if (block >= num_world_blocks) {
+		old_size = num_world_blocks;
+		num_world_blocks = MAX(block + 1, num_world_blocks * 2);
+		RECREATE(world_blocks, struct world_block_data, num_world_blocks);
+		memset(world_blocks + old_size, 0, (num_world_blocks - old_size) * sizeof(struct world_block_data));
+	}
+	
+	return &world_blocks[block];
+}
+
+
+/**
+* Writes one world block's .wld file from the rooms currently in the world.
+* Unlike save_whole_world(), this does not need a sorted world_table.
+*
+* @param int block Which world block to save.
+*/
+static void save_world_block(int block) {
+	struct world_block_data *wb;
+	room_vnum vnum;
+	room_data *room;
+	FILE *fl;
+	
+	if (!(wb = get_world_block(block))) {
+		return;
+	}
+	
+	fl = open_world_file(block);
+	for (vnum = block * WORLD_BLOCK_SIZE; vnum < (block + 1) * WORLD_BLOCK_SIZE; ++vnum) {
+		// only save a room at all if it couldn't be unloaded
+		if ((room = real_real_room(vnum)) && !CAN_UNLOAD_MAP_ROOM(room)) {
+			write_room_to_file(fl, room);
+		}
+	}
+	save_and_close_world_file(fl, block);
+	
+	wb->needs_save = wb->new_block = FALSE;
+}
+
+
+/**
+* Tracks a room entering the world_table, for the world index and block saves.
+* Called by add_room_to_world_tables().
+*
+* @param room_data *room The room being added.
+*/
+void add_room_to_world_block(room_data *room) {
+	struct world_block_data *wb = get_world_block(GET_WORLD_BLOCK(GET_ROOM_VNUM(room)));
+	
+	if (wb && ++wb->rooms == 1) {
+		// block membership changed
+		need_world_index = TRUE;
+		wb->needs_save = wb->new_block = TRUE;
+	}
+}
+
+
+/**
+* Tracks a room leaving the world_table, for the world index and block saves.
+* Called by remove_room_from_world_tables().
+*
+* @param room_data *room The room being removed.
+*/
+void remove_room_from_world_block(room_data *room) {
+	struct world_block_data *wb = get_world_block(GET_WORLD_BLOCK(GET_ROOM_VNUM(room)));
+	
+	if (wb && wb->rooms > 0 && --wb->rooms == 0) {
+		// block membership changed
+		need_world_index = TRUE;
+	}
+}
+
+
+/**
+* Marks every world block as already saved. This is called at startup, once
+* the world has been loaded from its own files.
+*/
+void clear_world_block_saves(void) {
+	struct objpack_save_data *ops, *next_ops;
+	int iter;
+	
+	for (iter = 0; iter < num_world_blocks; ++iter) {
+		world_blocks[iter].needs_save = world_blocks[iter].new_block = FALSE;
+	}
+	
+	HASH_ITER(hh, objpack_saves, ops, next_ops) {
+		HASH_DEL(objpack_saves, ops);
+		free(ops);
+	}
+}
+
+
+/**
+* Marks only a room's objpack as needing to be saved; save_world_blocks() will
+* write it out within a few seconds. This is for changes to the objects in a
+* room that don't change its .wld file (which only needs to know whether or
+* not the room has an objpack at all).
+*
+* @param room_data *room The room whose objects changed.
+*/
+void request_objpack_save(room_data *room) {
+	struct objpack_save_data *ops;
+	room_vnum vnum = GET_ROOM_VNUM(room);
+	
+	HASH_FIND_INT(objpack_saves, &vnum, ops);
+	if (!ops) {
+		CREATE(ops, struct objpack_save_data, 1);
+		ops->vnum = vnum;
+		HASH_ADD_INT(objpack_saves, vnum, ops);
+	}
+}
+
+
+/**
+* Marks a room's world block as needing to be saved; save_world_blocks() will
+* write it out within a few seconds. This should be called when something
+* that's stored in the .wld file changes.
+*
+* @param room_vnum vnum The room that changed.
+*/
+void request_world_save(room_vnum vnum) {
+	struct world_block_data *wb;
+	
+	if (vnum != NOWHERE && (wb = get_world_block(GET_WORLD_BLOCK(vnum)))) {
+		wb->needs_save = TRUE;
+	}
+}
+
+
+/**
+* Queues a save of every block in the world, to be written out gradually by
+* save_world_blocks() instead of all at once. The instance and world map
+* files, which are single files, are saved immediately.
+*/
+void request_whole_world_save(void) {
+	void save_instances();
+	
+	int iter;
+	
+	for (iter = 0; iter < num_world_blocks; ++iter) {
+		if (world_blocks[iter].rooms > 0) {
+			world_blocks[iter].needs_save = TRUE;
+		}
+	}
+	
+	save_instances();
+	save_world_map_to_file();
+}
+
+
+/**
+* Saves up to a few world blocks that need it (see request_world_save), so
+* that world saves are spread out rather than done all at once. Also saves the
+* world index if the set of blocks in the world has changed, and up to
+* OBJPACK_SAVES_PER_SEC room objpacks (see request_objpack_save).
+*
+* @param int max_blocks The most blocks to save this time (not counting brand-new ones needed by the index).
+*/
+void save_world_blocks(int max_blocks) {
+	extern bool objpack_save_room(room_data *room);
+	
+	struct objpack_save_data *ops, *next_ops;
+	int iter, block, count = 0;
+	room_data *room;
+	
+	if (need_world_index) {
+		// new blocks' files must exist before the index can list them
+		for (iter = 0; iter < num_world_blocks; ++iter) {
+			if (world_blocks[iter].rooms > 0 && world_blocks[iter].new_block) {
+				save_world_block(iter);
+			}
+		}
+		save_world_index();
+	}
+	
+	for (iter = 0; iter < num_world_blocks && count < max_blocks; ++iter) {
+		block = (next_world_block_save + iter) % num_world_blocks;
+		
+		if (world_blocks[block].needs_save) {
+			if (world_blocks[block].rooms > 0) {
+				save_world_block(block);
+				++count;
+			}
+			else {
+				// not in the index: nothing to save
+				world_blocks[block].needs_save = FALSE;
+			}
+		}
+	}
+	
+	if (num_world_blocks > 0) {
+		next_world_block_save = (next_world_block_save + iter) % num_world_blocks;
+	}
+	
+	// and single-room objpacks
+	count = 0;
+	HASH_ITER(hh, objpack_saves, ops, next_ops) {
+		if (count++ >= OBJPACK_SAVES_PER_SEC) {
+			break;
+		}
+		
+		if ((room = real_real_room(ops->vnum))) {
+			objpack_save_room(room);
+		}
+		HASH_DEL(objpack_saves, ops);
+		free(ops);
+	}
+}
+
+
 /**
 * Save a fresh index file for the world.
 */
 void save_world_index(void) {
 	char filename[64], tempfile[64];
-	room_data *iter, *next_iter;
-	room_vnum vnum;
-	int this, last;
+	int iter;
 	FILE *fl;
 	
-	// we only need this if the size of the world changed
+	// we only need this if the set of world blocks changed
 	if (!need_world_index) {
 		return;
 	}
 	
-	sort_world_table();
-	
 	sprintf(filename, "%s%s", WLD_PREFIX, INDEX_FILE);
 	strcpy(tempfile, filename);
 	strcat(tempfile, TEMP_SUFFIX);
@@ -787,14 +1042,9 @@ void save_world_index(void) {
 		return;
 	}
 	
-	last = -1;
-	HASH_ITER(hh, world_table, iter, next_iter) {
-		vnum = GET_ROOM_VNUM(iter);
-		this = GET_WORLD_BLOCK(vnum);
-		
-		if (this != last) {
-			fprintf(fl, "%d%s\n", this, WLD_SUFFIX);
-			last = this;
+	for (iter = 0; iter < num_world_blocks; ++iter) {
+		if (world_blocks[iter].rooms > 0) {
+			fprintf(fl, "%d%s\n", iter, WLD_SUFFIX);
 		}
 	}
 	
@@ -808,11 +1058,13 @@ void save_world_index(void) {
 
 
 /**
-* Executes a full-world save.
+* Executes a full-world save, all at once. Normally the world is saved
+* gradually by save_world_blocks(); this is for shutdowns and commands.
 */
 void save_whole_world(void) {
 	void save_instances();
 	
+	struct world_block_data *wb;
 	room_data *iter, *next_iter;
 	room_vnum vnum;
 	int block, last;
@@ -834,6 +1086,10 @@ void save_whole_world(void) {
 			}
 			fl = open_world_file(block);
 			last = block;
+			
+			if ((wb = get_world_block(block))) {
+				wb->needs_save = wb->new_block = FALSE;
+			}
 		}
 		
 		// only save a room at all if it couldn't be unloaded
@@ -936,10 +1192,10 @@ void annual_update_map_tile(room_data *room) {
 		
 		// determine damage to do each year
 		if (IS_COMPLETE(room)) {
-			dmg = (double) GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) / (double) config_get_int("disrepair_limit");
+			dmg = (double) GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) / (double) CONFIG_INT(CFG_DISREPAIR_LIMIT);
 		}
 		else {
-			dmg = (double) GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) / (double) config_get_int("disrepair_limit_unfinished");
+			dmg = (double) GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) / (double) CONFIG_INT(CFG_DISREPAIR_LIMIT_UNFINISHED);
 		}
 		dmg = MAX(1.0, dmg);
 		
@@ -974,9 +1230,9 @@ void annual_update_map_tile(room_data *room) {
 	// fill in trenches slightly
 	if (ROOM_SECT_FLAGGED(room, SECTF_IS_TRENCH) && !ROOM_OWNER(room) && (trenched = get_room_extra_data(room, ROOM_EXTRA_TRENCH_PROGRESS)) < 0) {
 		// move halfway toward initial: remember initial value is negative
-		amount = (config_get_int("trench_initial_value") - trenched) / 2;
+		amount = (CONFIG_INT(CFG_TRENCH_INITIAL_VALUE) - trenched) / 2;
 		trenched += amount;
-		if (trenched > config_get_int("trench_initial_value") + 10) {
+		if (trenched > CONFIG_INT(CFG_TRENCH_INITIAL_VALUE) + 10) {
 			set_room_extra_data(room, ROOM_EXTRA_TRENCH_PROGRESS, trenched);
 		}
 		else {
@@ -1082,7 +1338,7 @@ void annual_world_update(void) {
 	// MESSAGE TO ALL
 	for (d = descriptor_list; d; d = d->next) {
 		if (STATE(d) == CON_PLAYING && d->character) {
-			write_to_descriptor(d->descriptor, message);
+			write_to_client(d, message);
 			d->has_prompt = FALSE;
 			
 			if (!IS_IMMORTAL(d->character)) {
@@ -1090,7 +1346,7 @@ void annual_world_update(void) {
 					if (IS_RIDING(d->character)) {
 						perform_dismount(d->character);
 					}
-					write_to_descriptor(d->descriptor, "You're knocked to the ground!\r\n");
+					write_to_client(d, "You're knocked to the ground!\r\n");
 					act("$n is knocked to the ground!", TRUE, d->character, NULL, NULL, TO_ROOM);
 					GET_POS(d->character) = POS_SITTING;
 				}
@@ -1136,11 +1392,11 @@ void naturalize_newbie_islands(void) {
 	room_data *room;
 	bool do_unclaim;
 	
-	if (!config_get_bool("naturalize_newbie_islands")) {
+	if (!CONFIG_BOOL(CFG_NATURALIZE_NEWBIE_ISLANDS)) {
 		return;
 	}
 	
-	do_unclaim = config_get_bool("naturalize_unclaimable");
+	do_unclaim = CONFIG_BOOL(CFG_NATURALIZE_UNCLAIMABLE);
 	
 	LL_FOREACH(land_map, map) {
 		// simple checks
@@ -1186,6 +1442,7 @@ void naturalize_newbie_islands(void) {
 				set_crop_type(room, get_potential_crop_for_location(room));
 			}
 			else {
+				stats_adjust_crop_count(map->crop_type, -1);
 				map->crop_type = NULL;
 			}
 		}
@@ -1276,9 +1533,9 @@ int city_points_available(empire_data *emp) {
 	if (emp) {
 		points = 1;
 		points += (EMPIRE_HAS_TECH(emp, TECH_PROMINENCE) ? 1 : 0);
-		points += ((EMPIRE_MEMBERS(emp) - 1) / config_get_int("players_per_city_point"));
-		points += (GET_TOTAL_WEALTH(emp) >= config_get_int("bonus_city_point_wealth")) ? 1 : 0;
-		points += (count_tech(emp) >= config_get_int("bonus_city_point_techs")) ? 1 : 0;
+		points += ((EMPIRE_MEMBERS(emp) - 1) / CONFIG_INT(CFG_PLAYERS_PER_CITY_POINT));
+		points += (GET_TOTAL_WEALTH(emp) >= CONFIG_INT(CFG_BONUS_CITY_POINT_WEALTH)) ? 1 : 0;
+		points += (count_tech(emp) >= CONFIG_INT(CFG_BONUS_CITY_POINT_TECHS)) ? 1 : 0;
 
 		// minus any used points
 		points -= count_city_points_used(emp);
@@ -1358,6 +1615,19 @@ struct empire_city_data *create_city_entry(empire_data *emp, char *name, room_da
 
 	city->next = NULL;
 	
+	// check building exists
+	if (!IS_CITY_CENTER(location)) {
+		construct_building(location, BUILDING_CITY_CENTER);
+		set_room_extra_data(location, ROOM_EXTRA_FOUND_TIME, time(0));
+		complete_building(location);
+	}
+	
+	// verify ownership
+	claim_room(location, emp);
+	
+	// adding the city moves nearby territory into the city count (done last so
+	// the claim above doesn't count the center twice)
+	update_city_area_territory(emp, location, city_type[type].radius, FALSE);
 	if ((cc = EMPIRE_CITY_LIST(emp))) {
 		// append to end
 		while (cc->next) {
@@ -1368,16 +1638,7 @@ struct empire_city_data *create_city_entry(empire_data *emp, char *name, room_da
 	else {
 		EMPIRE_CITY_LIST(emp) = city;
 	}
-	
-	// check building exists
-	if (!IS_CITY_CENTER(location)) {
-		construct_building(location, BUILDING_CITY_CENTER);
-		set_room_extra_data(location, ROOM_EXTRA_FOUND_TIME, time(0));
-		complete_building(location);
-	}
-	
-	// verify ownership
-	claim_room(location, emp);
+	update_city_area_territory(emp, location, city_type[type].radius, TRUE);
 	
 	return city;
 }
@@ -1562,6 +1823,169 @@ struct sector_index_type *find_sector_index(sector_vnum vnum) {
 }
 
 
+/**
+* Finds the index entry for a building type; adds a blank entry if it doesn't
+* exist.
+*
+* @param bld_vnum vnum Which building.
+* @return struct building_index_type* The index entry (guaranteed).
+*/
+struct building_index_type *find_building_index(bld_vnum vnum) {
+	struct building_index_type *idx;
+	HASH_FIND_INT(building_index, &vnum, idx);
+	if (!idx) {
+		CREATE(idx, struct building_index_type, 1);
+		idx->vnum = vnum;
+		HASH_ADD_INT(building_index, vnum, idx);
+	}
+	return idx;
+}
+
+
+/**
+* Moves a room from one building type's index to another's. ALL changes to a
+* room's building (attach, detach, delete) must call this.
+*
+* @param room_data *room The room that's changing.
+* @param bld_data *old_bld The building it had (may be NULL).
+* @param bld_data *new_bld The building it will have (may be NULL).
+*/
+void update_building_index(room_data *room, bld_data *old_bld, bld_data *new_bld) {
+	struct building_index_room *entry;
+	struct building_index_type *idx;
+	
+	if (!room || old_bld == new_bld) {
+		return;
+	}
+	
+	if (old_bld) {
+		idx = find_building_index(GET_BLD_VNUM(old_bld));
+		HASH_FIND_PTR(idx->rooms, &room, entry);
+		if (entry) {
+			HASH_DEL(idx->rooms, entry);
+			free(entry);
+			--idx->count;
+		}
+	}
+	
+	if (new_bld) {
+		idx = find_building_index(GET_BLD_VNUM(new_bld));
+		HASH_FIND_PTR(idx->rooms, &room, entry);
+		if (!entry) {
+			CREATE(entry, struct building_index_room, 1);
+			entry->room = room;
+			HASH_ADD_PTR(idx->rooms, room, entry);
+			++idx->count;
+		}
+	}
+}
+
+
+/**
+* Updates the chunk counts (used by map_sect_within_distance) when a map tile
+* gains or loses a sector.
+*
+* @param struct sector_index_type *idx The sector's index entry.
+* @param room_vnum vnum The map tile.
+* @param int amount 1 to add the tile, -1 to remove it.
+*/
+static void update_sector_chunk(struct sector_index_type *idx, room_vnum vnum, int amount) {
+	if (vnum < 0 || vnum >= MAP_SIZE) {
+		return;	// only the map is indexed
+	}
+	
+	if (!idx->chunk_count) {
+		CREATE(idx->chunk_count, unsigned char, SECT_CHUNKS_X * SECT_CHUNKS_Y);
+	}
+	idx->chunk_count[SECT_CHUNK(MAP_X_COORD(vnum), MAP_Y_COORD(vnum))] += amount;
+}
+
+
+/**
+* Counts how many tiles adjacent to a map tile have the given sector type,
+* using only the world_map (no rooms are loaded).
+*
+* @param struct map_data *tile The map tile to check around.
+* @param sector_vnum sect The sector vnum to find.
+* @param bool count_base_sect If TRUE, also checks the base sector.
+* @return int The number of matching adjacent tiles.
+*/
+int count_adjacent_map_sectors(struct map_data *tile, sector_vnum sect, bool count_base_sect) {
+	sector_data *find = sector_proto(sect);
+	struct map_data *to_tile;
+	int iter, x, y, count = 0;
+	
+	for (iter = 0; iter < NUM_2D_DIRS; ++iter) {
+		if (get_coord_shift(MAP_X_COORD(tile->vnum), MAP_Y_COORD(tile->vnum), shift_dir[iter][0], shift_dir[iter][1], &x, &y)) {
+			to_tile = &(world_map[x][y]);
+			if (to_tile->sector_type == find || (count_base_sect && to_tile->base_sector == find)) {
+				++count;
+			}
+		}
+	}
+	
+	return count;
+}
+
+
+/**
+* Determines if there's a map tile of the given sector within a distance of
+* another tile. This uses the sector's chunk counts to skip parts of the map
+* that don't have it, and never loads rooms.
+*
+* @param struct map_data *tile The map tile to check around.
+* @param sector_vnum sect The sector vnum to find.
+* @param int distance How far away to check (as with compute_distance).
+* @return bool TRUE if the sect is found, FALSE if not.
+*/
+bool map_sect_within_distance(struct map_data *tile, sector_vnum sect, int distance) {
+	int x = MAP_X_COORD(tile->vnum), y = MAP_Y_COORD(tile->vnum);
+	int x_off, y_off, x_next, y_next, x_iter, y_iter, chunk_x, chunk_y, junk;
+	int max_dist_sq = (distance + 1) * (distance + 1);	// compute_distance rounds down
+	struct sector_index_type *idx;
+	sector_data *find;
+	
+	HASH_FIND_INT(sector_index, &sect, idx);
+	if (!idx || !idx->chunk_count || !(find = sector_proto(sect))) {
+		return FALSE;	// none on the map
+	}
+	
+	// work through the square one chunk-sized piece at a time
+	for (y_off = -distance; y_off <= distance; y_off = y_next) {
+		if (!get_coord_shift(x, y, 0, y_off, &junk, &chunk_y)) {
+			y_next = y_off + 1;	// off the edge of the map
+			continue;
+		}
+		y_next = y_off + MIN(SECT_CHUNK_SIZE - (chunk_y % SECT_CHUNK_SIZE), MAP_HEIGHT - chunk_y);
+		y_next = MIN(y_next, distance + 1);
+		
+		for (x_off = -distance; x_off <= distance; x_off = x_next) {
+			if (!get_coord_shift(x, y, x_off, 0, &chunk_x, &junk)) {
+				x_next = x_off + 1;	// off the edge of the map
+				continue;
+			}
+			x_next = x_off + MIN(SECT_CHUNK_SIZE - (chunk_x % SECT_CHUNK_SIZE), MAP_WIDTH - chunk_x);
+			x_next = MIN(x_next, distance + 1);
+			
+			if (!idx->chunk_count[SECT_CHUNK(chunk_x, chunk_y)]) {
+				continue;	// none in this chunk
+			}
+			
+			// check the part of the chunk that's in range
+			for (y_iter = y_off; y_iter < y_next; ++y_iter) {
+				for (x_iter = x_off; x_iter < x_next; ++x_iter) {
+					if (x_iter * x_iter + y_iter * y_iter < max_dist_sq && world_map[chunk_x + x_iter - x_off][chunk_y + y_iter - y_off].sector_type == find) {
+						return TRUE;
+					}
+				}
+			}
+		}
+	}
+	
+	return FALSE;
+}
+
+
 /**
 * Change a room's base sector (and the world_map) from one type to another, and
 * update counts. ALL base sector changes should be done through this function.
@@ -1589,12 +2013,14 @@ void perform_change_base_sect(room_data *loc, struct map_data *map, sector_data
 	// update room
 	if (loc || (loc = real_real_room(map->vnum))) {
 		BASE_SECT(loc) = sect;
+		request_world_save(GET_ROOM_VNUM(loc));
 	}
 	
 	// update the world map
 	if (map || (GET_ROOM_VNUM(loc) < MAP_SIZE && (map = &(world_map[FLAT_X_COORD(loc)][FLAT_Y_COORD(loc)])))) {
 		map->base_sector = sect;
 		world_map_needs_save = TRUE;
+		clear_map_render_cache(map->vnum);
 	}
 	
 	// old index
@@ -1654,12 +2080,16 @@ void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect
 	// update room
 	if (loc) {
 		SECT(loc) = sect;
+		request_world_save(GET_ROOM_VNUM(loc));
 	}
 	
 	// update the world map
 	if (map || (GET_ROOM_VNUM(loc) < MAP_SIZE && (map = &(world_map[FLAT_X_COORD(loc)][FLAT_Y_COORD(loc)])))) {
+		stats_adjust_sector_count(map->sector_type, -1);
+		stats_adjust_sector_count(sect, 1);
 		map->sector_type = sect;
 		world_map_needs_save = TRUE;
+		clear_map_render_cache(map->vnum);
 	}
 	
 	// old index
@@ -1667,6 +2097,7 @@ void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect
 		idx = find_sector_index(GET_SECT_VNUM(old_sect));
 		--idx->sect_count;
 		if (map) {
+			update_sector_chunk(idx, map->vnum, -1);
 			if (last_evo_tile == map) {
 				last_evo_tile = map->next_in_sect;
 			}
@@ -1679,6 +2110,7 @@ void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect
 	++idx->sect_count;
 	if (map) {
 		LL_PREPEND2(idx->sect_rooms, map, next_in_sect);
+		update_sector_chunk(idx, map->vnum, 1);
 	}
 	
 	// check for territory updates
@@ -1695,9 +2127,9 @@ void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect
 			else if (ROOM_SECT_FLAGGED(loc, SECTF_LARGE_CITY_RADIUS) && !was_in_city && is_in_city_for_empire(loc, ROOM_OWNER(loc), FALSE, &junk)) {
 				// changing from outside-territory to in-city
 				EMPIRE_CITY_TERRITORY(ROOM_OWNER(loc)) += 1;
-				eisle->city_terr -= 1;
+				eisle->city_terr += 1;
 				EMPIRE_OUTSIDE_TERRITORY(ROOM_OWNER(loc)) -= 1;
-				eisle->outside_terr += 1;
+				eisle->outside_terr -= 1;
 			}
 			else {
 				// no relevant change
@@ -1812,13 +2244,14 @@ struct empire_territory_data *create_territory_entry(empire_data *emp, room_data
 	struct empire_territory_data *ter;
 	
 	CREATE(ter, struct empire_territory_data, 1);
+	ter->vnum = GET_ROOM_VNUM(room);
 	ter->room = room;
-	ter->population_timer = config_get_int("building_population_timer");
+	ter->population_timer = CONFIG_INT(CFG_BUILDING_POPULATION_TIMER);
 	ter->npcs = NULL;
 	ter->marked = FALSE;
 	
-	// put it at the end
-	LL_APPEND(EMPIRE_TERRITORY_LIST(emp), ter);
+	// hash iteration keeps insertion order, so this still goes at the end
+	HASH_ADD_INT(EMPIRE_TERRITORY_LIST(emp), vnum, ter);
 	
 	return ter;
 }
@@ -1836,13 +2269,13 @@ void delete_territory_entry(empire_data *emp, struct empire_territory_data *ter)
 	
 	// prevent loss
 	if (ter == global_next_territory_entry) {
-		global_next_territory_entry = ter->next;
+		global_next_territory_entry = ter->hh.next;
 	}
 
 	delete_room_npcs(NULL, ter);
 	ter->npcs = NULL;
 	
-	LL_DELETE(EMPIRE_TERRITORY_LIST(emp), ter);
+	HASH_DEL(EMPIRE_TERRITORY_LIST(emp), ter);
 	free(ter);
 }
 
@@ -1851,6 +2284,11 @@ void delete_territory_entry(empire_data *emp, struct empire_territory_data *ter)
 * This function sets up empire territory. It is called rarely after startup.
 * It can be called on one specific empire, or it can be used for ALL empires.
 *
+* Only the "all" version scans the whole world and recounts territory from
+* scratch (at startup, or as a consistency check). Territory counts are kept
+* up to date as rooms are claimed, abandoned, built, and as cities change, so
+* a single empire only needs a pass over its own territory list.
+*
 * @param empire_data *emp The empire to read, or NULL for "all".
 * @param bool check_tech If TRUE, also does techs (you should almost never do this)
 */
@@ -1863,38 +2301,75 @@ void read_empire_territory(empire_data *emp, bool check_tech) {
 	room_data *iter, *next_iter;
 	empire_data *e, *next_e;
 	bool junk;
+	
+	if (emp) {
+		EMPIRE_POPULATION(emp) = 0;
+		if (check_tech) {	// this will only be re-read if we check tech
+			EMPIRE_MILITARY(emp) = 0;
+			EMPIRE_FAME(emp) = 0;
+		}
+		
+		read_vault(emp);
+		
+		HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+			isle->population = 0;
+		}
+		
+		HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
+			// remove any territory that no longer belongs ... in case there is any
+			if (ROOM_OWNER(ter->room) != emp || !BELONGS_IN_TERRITORY_LIST(ter->room)) {
+				delete_territory_entry(emp, ter);
+				continue;
+			}
+			
+			// techs only come from buildings, which are all in the list
+			if (check_tech) {
+				adjust_building_tech(emp, ter->room, TRUE);
+			}
+			
+			if (IS_COMPLETE(ter->room)) {
+				isle = GET_ROOM_VEHICLE(ter->room) ? NULL : get_empire_island(emp, GET_ISLAND_ID(ter->room));
+				for (npc = ter->npcs; npc; npc = npc->next) {
+					EMPIRE_POPULATION(emp) += 1;
+					if (isle) {
+						isle->population += 1;
+					}
+				}
+			}
+		}
+		
+		return;
+	}
 
 	/* Init empires */
 	HASH_ITER(hh, empire_table, e, next_e) {
-		if (e == emp || !emp) {
-			EMPIRE_CITY_TERRITORY(e) = 0;
-			EMPIRE_OUTSIDE_TERRITORY(e) = 0;
-			EMPIRE_POPULATION(e) = 0;
-			
-			if (check_tech) {	// this will only be re-read if we check tech
-				EMPIRE_MILITARY(e) = 0;
-				EMPIRE_FAME(e) = 0;
-			}
+		EMPIRE_CITY_TERRITORY(e) = 0;
+		EMPIRE_OUTSIDE_TERRITORY(e) = 0;
+		EMPIRE_POPULATION(e) = 0;
 		
-			read_vault(e);
+		if (check_tech) {	// this will only be re-read if we check tech
+			EMPIRE_MILITARY(e) = 0;
+			EMPIRE_FAME(e) = 0;
+		}
+	
+		read_vault(e);
 
-			// reset marks to check for dead territory
-			for (ter = EMPIRE_TERRITORY_LIST(e); ter; ter = ter->next) {
-				ter->marked = FALSE;
-			}
-			
-			// reset counters
-			HASH_ITER(hh, EMPIRE_ISLANDS(e), isle, next_isle) {
-				isle->population = 0;
-				isle->city_terr = 0;
-				isle->outside_terr = 0;
-			}
+		// reset marks to check for dead territory
+		HASH_ITER(hh, EMPIRE_TERRITORY_LIST(e), ter, next_ter) {
+			ter->marked = FALSE;
+		}
+		
+		// reset counters
+		HASH_ITER(hh, EMPIRE_ISLANDS(e), isle, next_isle) {
+			isle->population = 0;
+			isle->city_terr = 0;
+			isle->outside_terr = 0;
 		}
 	}
 
 	// scan the whole world
 	HASH_ITER(hh, world_table, iter, next_iter) {
-		if ((e = ROOM_OWNER(iter)) && (!emp || e == emp)) {
+		if ((e = ROOM_OWNER(iter))) {
 			// only count each building as 1
 			if (COUNTS_AS_TERRITORY(iter)) {
 				isle = get_empire_island(e, GET_ISLAND_ID(iter));
@@ -1941,11 +2416,9 @@ void read_empire_territory(empire_data *emp, bool check_tech) {
 	
 	// remove any territory that wasn't marked ... in case there is any
 	HASH_ITER(hh, empire_table, e, next_e) {
-		if (e == emp || !emp) {
-			LL_FOREACH_SAFE(EMPIRE_TERRITORY_LIST(e), ter, next_ter) {
-				if (!ter->marked) {
-					delete_territory_entry(e, ter);
-				}
+		HASH_ITER(hh, EMPIRE_TERRITORY_LIST(e), ter, next_ter) {
+			if (!ter->marked) {
+				delete_territory_entry(e, ter);
 			}
 		}
 	}
@@ -2085,36 +2558,31 @@ static void evolve_one_map_tile(struct map_data *tile) {
 	}
 	
 	if (become == NOTHING && (evo = get_evolution_by_type(tile->sector_type, EVO_ADJACENT_ONE))) {
-		room = room ? room : real_room(tile->vnum);
-		if (count_adjacent_sectors(room, evo->value, TRUE) >= 1) {
+		if (count_adjacent_map_sectors(tile, evo->value, TRUE) >= 1) {
 			become = evo->becomes;
 		}
 	}
 	
 	if (become == NOTHING && (evo = get_evolution_by_type(tile->sector_type, EVO_NOT_ADJACENT))) {
-		room = room ? room : real_room(tile->vnum);
-		if (count_adjacent_sectors(room, evo->value, TRUE) < 1) {
+		if (count_adjacent_map_sectors(tile, evo->value, TRUE) < 1) {
 			become = evo->becomes;
 		}
 	}
 	
 	if (become == NOTHING && (evo = get_evolution_by_type(tile->sector_type, EVO_ADJACENT_MANY))) {
-		room = room ? room : real_room(tile->vnum);
-		if (count_adjacent_sectors(room, evo->value, TRUE) >= 6) {
+		if (count_adjacent_map_sectors(tile, evo->value, TRUE) >= 6) {
 			become = evo->becomes;
 		}
 	}
 	
 	if (become == NOTHING && (evo = get_evolution_by_type(tile->sector_type, EVO_NEAR_SECTOR))) {
-		room = room ? room : real_room(tile->vnum);
-		if (find_sect_within_distance_from_room(room, evo->value, config_get_int("nearby_sector_distance"))) {
+		if (map_sect_within_distance(tile, evo->value, CONFIG_INT(CFG_NEARBY_SECTOR_DISTANCE))) {
 			become = evo->becomes;
 		}
 	}
 	
 	if (become == NOTHING && (evo = get_evolution_by_type(tile->sector_type, EVO_NOT_NEAR_SECTOR))) {
-		room = room ? room : real_room(tile->vnum);
-		if (!find_sect_within_distance_from_room(room, evo->value, config_get_int("nearby_sector_distance"))) {
+		if (!map_sect_within_distance(tile, evo->value, CONFIG_INT(CFG_NEARBY_SECTOR_DISTANCE))) {
 			become = evo->becomes;
 		}
 	}
@@ -2144,16 +2612,21 @@ static void evolve_one_map_tile(struct map_data *tile) {
 
 
 /**
-* Runs evolutions on 1/24 of evolvable map tiles per hour.
+* Runs evolutions on up to a number of map tiles, resuming from wherever it
+* left off last time (last_evo_sect/last_evo_tile).
+*
+* @param int max_tiles The most tiles to evolve.
+* @param unsigned long long end_time Stop early if microtime() passes this.
+* @return int The number of tiles processed.
 */
-void run_map_evolutions(void) {
+int run_map_evolutions(int max_tiles, unsigned long long end_time) {
 	struct map_data *map, *next_map, *map_start;
 	struct sector_index_type *idx;
 	sector_data *sect, *next_sect;
 	bool found_start;
-	int try, to_do;
+	int try, to_do, done = 0;
 	
-	to_do = evos_per_hour;	// how many tiles to evolve before we quit
+	to_do = max_tiles;	// how many tiles to evolve before we quit
 	
 	// going to loop through sectors twice: once to find the last starting pos, and a second time if we have to wrap around
 	found_start = FALSE;
@@ -2204,14 +2677,56 @@ void run_map_evolutions(void) {
 				last_evo_tile = map;	// update this NOW
 				
 				evolve_one_map_tile(map);
+				++done;
 				
-				// end if done
-				if (--to_do <= 0) {
+				// end if done or out of time
+				if (--to_do <= 0 || microtime() >= end_time) {
+					to_do = 0;
 					break;
 				}
 			}
 		}
 	}
+	
+	return done;
+}
+
+
+/**
+* Runs map evolutions a little at a time, every pulse, rather than all at once
+* at the top of the mud hour. Each pulse adds its share of evos_per_hour to
+* evos_behind, then works that off for up to EVO_USEC_PER_PULSE.
+*/
+void update_map_evolutions(void) {
+	static int partial = 0;	// share of evos_per_hour carried over between pulses
+	static time_t last_warning = 0;
+	int pulses_per_hour = SECS_PER_MUD_HOUR * PASSES_PER_SEC;
+	int done;
+	
+	partial += evos_per_hour;
+	evos_behind += partial / pulses_per_hour;
+	partial %= pulses_per_hour;
+	
+	if (evos_behind <= 0) {
+		return;
+	}
+	
+	done = run_map_evolutions(evos_behind, microtime() + EVO_USEC_PER_PULSE);
+	if (done > 0) {
+		evos_behind -= done;
+	}
+	else {
+		evos_behind = 0;	// nothing on the map can evolve
+	}
+	
+	// more than an hour behind: report it, and drop the excess rather than letting it pile up
+	if (evos_behind > evos_per_hour) {
+		if (last_warning + SECS_PER_REAL_HOUR < time(0)) {
+			syslog(SYS_SYSTEM, LVL_START_IMM, TRUE, "Map evolutions are %d tiles behind schedule (%d per hour)", evos_behind, evos_per_hour);
+			last_warning = time(0);
+		}
+		evos_behind = evos_per_hour;
+	}
 }
 
 
@@ -2366,7 +2881,7 @@ room_data *load_map_room(room_vnum vnum) {
 	
 	// only if saveable
 	if (!CAN_UNLOAD_MAP_ROOM(room)) {
-		need_world_index = TRUE;
+		request_world_save(GET_ROOM_VNUM(room));
 	}
 	
 	return room;
@@ -2457,7 +2972,7 @@ int get_main_island(empire_data *emp) {
 */
 crop_data *get_potential_crop_for_location(room_data *location) {
 	int x = X_COORD(location), y = Y_COORD(location);
-	bool water = find_flagged_sect_within_distance_from_room(location, SECTF_FRESH_WATER, NOBITS, config_get_int("water_crop_distance"));
+	bool water = find_flagged_sect_within_distance_from_room(location, SECTF_FRESH_WATER, NOBITS, CONFIG_INT(CFG_WATER_CROP_DISTANCE));
 	bool x_min_ok, x_max_ok, y_min_ok, y_max_ok;
 	struct island_info *isle = NULL;
 	int climate;
@@ -2591,7 +3106,7 @@ void grow_crop(room_data *room) {
 
 
 void init_room(room_data *room, room_vnum vnum) {
-	sector_data *inside = sector_proto(config_get_int("default_inside_sect"));
+	sector_data *inside = sector_proto(CONFIG_INT(CFG_DEFAULT_INSIDE_SECT));
 	
 	if (!inside) {
 		log("SYSERR: default_inside_sect does not exist");
@@ -2704,7 +3219,7 @@ void update_tavern(room_data *room) {
 		add_to_room_extra_data(room, ROOM_EXTRA_TAVERN_BREWING_TIME, -1);
 		if (get_room_extra_data(room, ROOM_EXTRA_TAVERN_BREWING_TIME) == 0) {
 			// brew's ready!
-			set_room_extra_data(room, ROOM_EXTRA_TAVERN_AVAILABLE_TIME, config_get_int("tavern_timer"));
+			set_room_extra_data(room, ROOM_EXTRA_TAVERN_AVAILABLE_TIME, CONFIG_INT(CFG_TAVERN_TIMER));
 		}
 	}
 	else if (get_room_extra_data(room, ROOM_EXTRA_TAVERN_AVAILABLE_TIME) >= 0) {
@@ -2714,12 +3229,12 @@ void update_tavern(room_data *room) {
 		if (get_room_extra_data(room, ROOM_EXTRA_TAVERN_AVAILABLE_TIME) <= 0) {
 			// enough to go again?
 			if (extract_tavern_resources(room)) {
-				set_room_extra_data(room, ROOM_EXTRA_TAVERN_AVAILABLE_TIME, config_get_int("tavern_timer"));
+				set_room_extra_data(room, ROOM_EXTRA_TAVERN_AVAILABLE_TIME, CONFIG_INT(CFG_TAVERN_TIMER));
 			}
 			else {
 				// can't afford to keep brewing
 				set_room_extra_data(room, ROOM_EXTRA_TAVERN_TYPE, BREW_NONE);
-				set_room_extra_data(room, ROOM_EXTRA_TAVERN_BREWING_TIME, config_get_int("tavern_brew_time"));
+				set_room_extra_data(room, ROOM_EXTRA_TAVERN_BREWING_TIME, CONFIG_INT(CFG_TAVERN_BREW_TIME));
 			}
 		}
 	}
@@ -2892,6 +3407,7 @@ void build_land_map(void) {
 			idx = find_sector_index(GET_SECT_VNUM(map->sector_type));
 			++idx->sect_count;
 			LL_PREPEND2(idx->sect_rooms, map, next_in_sect);
+			update_sector_chunk(idx, map->vnum, 1);
 			
 			// index base
 			if (map->base_sector != map->sector_type) {
@@ -2951,13 +3467,96 @@ void build_world_map(void) {
 }
 
 
+/**
+* Loads the world_map array from the BINARY_MAP_FILE, which is mmapped (where
+* supported) and copied in one pass. The world_map must already have been
+* initialized.
+*
+* @return bool TRUE if the binary file was loaded, FALSE if it's missing or unusable.
+*/
+static bool load_binary_world_map(void) {
+	struct binary_map_header *header;
+	struct binary_map_record *rec;
+	struct map_data *map;
+	size_t size = sizeof(struct binary_map_header) + MAP_SIZE * sizeof(struct binary_map_record);
+	struct stat st;
+	room_vnum vnum;
+	bool ok = TRUE;
+	char *data;
+	FILE *fl;
+	
+	if (!(fl = fopen(BINARY_MAP_FILE, "rb"))) {
+		return FALSE;
+	}
+	if (fstat(fileno(fl), &st) != 0 || (size_t)st.st_size != size) {
+		log("SYSERR: %s is the wrong size (expected %ld bytes) and will not be loaded", BINARY_MAP_FILE, (long)size);
+		fclose(fl);
+		return FALSE;
+	}
+	
+#ifdef HAVE_SYS_MMAN_H
+	if ((data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(fl), 0)) == MAP_FAILED) {
+		log("SYSERR: Unable to mmap %s: %s", BINARY_MAP_FILE, strerror(errno));
+		fclose(fl);
+		return FALSE;
+	}
+#else
+	CREATE(data, char, size);
+	if (fread(data, size, 1, fl) != 1) {
+		log("SYSERR: Unable to read %s: %s", BINARY_MAP_FILE, strerror(errno));
+		free(data);
+		fclose(fl);
+		return FALSE;
+	}
+#endif
+	
+	header = (struct binary_map_header*)data;
+	if (header->magic != BINARY_MAP_MAGIC || header->version != BINARY_MAP_VERSION || header->record_size != sizeof(struct binary_map_record)) {
+		log("SYSERR: %s is not a version %d binary map file and will not be loaded", BINARY_MAP_FILE, BINARY_MAP_VERSION);
+		ok = FALSE;
+	}
+	else if (header->width != MAP_WIDTH || header->height != MAP_HEIGHT) {
+		log("SYSERR: %s is for a %dx%d map and will not be loaded", BINARY_MAP_FILE, header->width, header->height);
+		ok = FALSE;
+	}
+	else {
+		rec = (struct binary_map_record*)(data + sizeof(struct binary_map_header));
+		for (vnum = 0; vnum < MAP_SIZE; ++vnum, ++rec) {
+			map = &(world_map[MAP_X_COORD(vnum)][MAP_Y_COORD(vnum)]);
+			map->island = rec->island;
+			
+			// these will be validated later
+			map->sector_type = sector_proto(rec->sector_type);
+			map->base_sector = sector_proto(rec->base_sector);
+			map->natural_sector = sector_proto(rec->natural_sector);
+			map->crop_type = crop_proto(rec->crop_type);
+		}
+	}
+	
+#ifdef HAVE_SYS_MMAN_H
+	munmap(data, size);
+#else
+	free(data);
+#endif
+	fclose(fl);
+	return ok;
+}
+
+
 /**
 * This loads the world_map array from file. This is optional, and this data
 * can be overwritten by the actual rooms from the .wld files. This should be
 * run after sectors are loaded, and before the .wld files are read in.
+*
+* The BINARY_MAP_FILE is preferred; the text WORLD_MAP_FILE is only read if
+* there's no usable binary one (e.g. on the first boot after upgrading), or if
+* the text file is newer (e.g. it was edited by hand). In that case, the binary
+* file is rewritten from it on the next map save.
 */
 void load_world_map_from_file(void) {
 	struct map_data *map;
+	struct stat bin_st, text_st;
+	bool has_bin, has_text;
 	int var[7], x, y;
 	char line[256];
 	FILE *fl;
@@ -2976,11 +3575,27 @@ void load_world_map_from_file(void) {
 		}
 	}
 	
-	if (!(fl = fopen(WORLD_MAP_FILE, "r"))) {
-		log(" - no %s file, booting without one", WORLD_MAP_FILE);
+	has_bin = (stat(BINARY_MAP_FILE, &bin_st) == 0);
+	has_text = (stat(WORLD_MAP_FILE, &text_st) == 0);
+	
+	if (has_bin && has_text && text_st.st_mtime > bin_st.st_mtime) {
+		log(" - %s is newer than %s, loading it instead", WORLD_MAP_FILE, BINARY_MAP_FILE);
+	}
+	else if (has_bin && load_binary_world_map()) {
+		return;
+	}
+	else if (has_text) {
+		log(" - no usable %s file, loading %s instead", BINARY_MAP_FILE, WORLD_MAP_FILE);
+	}
+	
+	if (!has_text || !(fl = fopen(WORLD_MAP_FILE, "r"))) {
+		log(" - no usable %s or %s file, booting without one", BINARY_MAP_FILE, WORLD_MAP_FILE);
 		return;
 	}
 	
+	// ensure the binary file catches up with the text one
+	world_map_needs_save = TRUE;
+	
 	// optionals
 	while (get_line(fl, line)) {
 		if (*line == '$') {
@@ -3013,10 +3628,18 @@ void load_world_map_from_file(void) {
 
 
 /**
-* Outputs the land portion of the world map to the map file.
+* Writes the whole world map to the BINARY_MAP_FILE: the records are filled
+* in directly in an mmapped temp file (where supported) or in one buffer that
+* is written all at once, then the temp file is renamed over the old one.
 */
-void save_world_map_to_file(void) {	
-	struct map_data *iter;
+void save_world_map_to_file(void) {
+	struct binary_map_header *header;
+	struct binary_map_record *rec;
+	struct map_data *map;
+	size_t size = sizeof(struct binary_map_header) + MAP_SIZE * sizeof(struct binary_map_record);
+	room_vnum vnum;
+	bool ok = TRUE;
+	char *data;
 	FILE *fl;
 	
 	// shortcut
@@ -3024,6 +3647,77 @@ void save_world_map_to_file(void) {
 		return;
 	}
 	
+	if (!(fl = fopen(BINARY_MAP_FILE TEMP_SUFFIX, "w+b"))) {
+		log("Unable to open %s for writing", BINARY_MAP_FILE TEMP_SUFFIX);
+		return;
+	}
+	
+#ifdef HAVE_SYS_MMAN_H
+	if (ftruncate(fileno(fl), size) != 0 || (data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(fl), 0)) == MAP_FAILED) {
+		log("SYSERR: Unable to map %s for writing: %s", BINARY_MAP_FILE TEMP_SUFFIX, strerror(errno));
+		fclose(fl);
+		return;
+	}
+#else
+	CREATE(data, char, size);
+#endif
+	
+	header = (struct binary_map_header*)data;
+	header->magic = BINARY_MAP_MAGIC;
+	header->version = BINARY_MAP_VERSION;
+	header->width = MAP_WIDTH;
+	header->height = MAP_HEIGHT;
+	header->record_size = sizeof(struct binary_map_record);
+	
+	rec = (struct binary_map_record*)(data + sizeof(struct binary_map_header));
+	for (vnum = 0; vnum < MAP_SIZE; ++vnum, ++rec) {
+		map = &(world_map[MAP_X_COORD(vnum)][MAP_Y_COORD(vnum)]);
+		rec->island = map->island;
+		rec->sector_type = map->sector_type ? GET_SECT_VNUM(map->sector_type) : NOTHING;
+		rec->base_sector = map->base_sector ? GET_SECT_VNUM(map->base_sector) : NOTHING;
+		rec->natural_sector = map->natural_sector ? GET_SECT_VNUM(map->natural_sector) : NOTHING;
+		rec->crop_type = map->crop_type ? GET_CROP_VNUM(map->crop_type) : NOTHING;
+	}
+	
+#ifdef HAVE_SYS_MMAN_H
+	// the data must be on disk before the rename makes it live
+	if (msync(data, size, MS_SYNC) != 0) {
+		log("SYSERR: Unable to sync %s: %s", BINARY_MAP_FILE TEMP_SUFFIX, strerror(errno));
+		ok = FALSE;
+	}
+	munmap(data, size);
+#else
+	if (fwrite(data, size, 1, fl) != 1 || fflush(fl) != 0) {
+		log("SYSERR: Unable to write %s: %s", BINARY_MAP_FILE TEMP_SUFFIX, strerror(errno));
+		ok = FALSE;
+	}
+	free(data);
+#endif
+	
+	if (ok && fsync(fileno(fl)) != 0) {
+		log("SYSERR: Unable to sync %s: %s", BINARY_MAP_FILE TEMP_SUFFIX, strerror(errno));
+		ok = FALSE;
+	}
+	
+	fclose(fl);
+	
+	if (ok) {
+		rename(BINARY_MAP_FILE TEMP_SUFFIX, BINARY_MAP_FILE);
+		world_map_needs_save = FALSE;
+	}
+}
+
+
+/**
+* Exports the land portion of the world map to the text WORLD_MAP_FILE, so it
+* can be inspected or edited by hand. The game reads this file at boot if there
+* is no usable BINARY_MAP_FILE or if this one is newer, so the binary file is
+* re-saved after an export to keep an unedited export from being preferred.
+*/
+void write_world_map_text_file(void) {
+	struct map_data *iter;
+	FILE *fl;
+	
 	if (!(fl = fopen(WORLD_MAP_FILE TEMP_SUFFIX, "w"))) {
 		log("Unable to open %s for writing", WORLD_MAP_FILE TEMP_SUFFIX);
 		return;
@@ -3037,5 +3731,5 @@ void save_world_map_to_file(void) {
 	
 	fclose(fl);
 	rename(WORLD_MAP_FILE TEMP_SUFFIX, WORLD_MAP_FILE);
-	world_map_needs_save = FALSE;
+	world_map_needs_save = TRUE;
 }
@@ -66,7 +66,8 @@ struct cmdlist_element *compile_command_list(char *input) {
 	else {
 		list->cmd = strdup("* No Script");
 	}
-
+	
+	precompile_cmdlist(list);
 	return list;
 }
 
@@ -75,8 +76,7 @@ void parse_trigger(FILE *trig_f, int nr) {
 	void add_trigger_to_table(trig_data *trig);
 
 	int t[2], k, attach_type;
-	char line[256], *cmds, *s, flags[256], errors[MAX_INPUT_LENGTH];
-	struct cmdlist_element *cle;
+	char line[256], *cmds, flags[256], errors[MAX_INPUT_LENGTH];
 	trig_data *trig;
 
 	CREATE(trig, trig_data, 1);
@@ -95,18 +95,8 @@ void parse_trigger(FILE *trig_f, int nr) {
 
 	trig->arglist = fread_string(trig_f, errors);
 
-	cmds = s = fread_string(trig_f, errors);
-
-	CREATE(trig->cmdlist, struct cmdlist_element, 1);
-	trig->cmdlist->cmd = strdup(strtok(s, "\n\r"));
-	cle = trig->cmdlist;
-
-	while ((s = strtok(NULL, "\n\r"))) {
-		CREATE(cle->next, struct cmdlist_element, 1);
-		cle = cle->next;
-		cle->cmd = strdup(s);
-	}
-
+	cmds = fread_string(trig_f, errors);
+	trig->cmdlist = compile_command_list(cmds);
 	free(cmds);
 }
 
@@ -141,49 +141,101 @@ struct queue *queue_init(void) {
 	struct queue *q;
 
 	CREATE(q, struct queue, 1);
+	q->max = EVENT_QUEUE_START_SIZE;
+	CREATE(q->heap, struct q_element*, q->max);
 
 	return q;
 }
 
 
-/* add data into the priority queue q with key */
-struct q_element *queue_enq(struct queue *q, void *data, long key) {
-	struct q_element *qe, *i;
-	int bucket;
+/**
+* @param struct q_element *a One queue element.
+* @param struct q_element *b Another.
+* @return bool TRUE if a is due before b.
+*/
+static inline bool queue_before(struct q_element *a, struct q_element *b) {
+	if (a->key != b->key) {
+		return (a->key < b->key);
+	}
+	return (a->seq > b->seq);	// newest first, as the old sorted lists did
+}
 
-	CREATE(qe, struct q_element, 1);
-	qe->data = data;
-	qe->key = key;
 
-	bucket = key % NUM_EVENT_QUEUES;   /* which queue does this go in */
+/**
+* Puts an element at a position in the heap and updates its stored index.
+*
+* @param struct queue *q The queue.
+* @param int pos The heap index.
+* @param struct q_element *qe The element to store there.
+*/
+static inline void queue_set(struct queue *q, int pos, struct q_element *qe) {
+	q->heap[pos] = qe;
+	qe->pos = pos;
+}
 
-	if (!q->head[bucket]) { /* queue is empty */
-		q->head[bucket] = qe;
-		q->tail[bucket] = qe;
-	}
 
-	else {
-		for (i = q->tail[bucket]; i; i = i->prev) {
-			if (i->key < key) { /* found insertion point */
-				if (i == q->tail[bucket])
-					q->tail[bucket] = qe;
-				else {
-					qe->next = i->next;
-					i->next->prev = qe;
-				}
-
-				qe->prev = i;
-				i->next = qe;
-				break;
-			}
+/**
+* Moves the element at pos up the heap until its parent is due first.
+*
+* @param struct queue *q The queue.
+* @param int pos The heap index to sift up from.
+*/
+static void queue_sift_up(struct queue *q, int pos) {
+	struct q_element *qe = q->heap[pos];
+	int parent;
+	
+	while (pos > 0) {
+		parent = (pos - 1) / 2;
+		if (!queue_before(qe, q->heap[parent])) {
+			break;
 		}
+		queue_set(q, pos, q->heap[parent]);
+		pos = parent;
+	}
+	queue_set(q, pos, qe);
+}
 
-		if (i == NULL) { /* insertion point is front of list */
-			qe->next = q->head[bucket];
-			q->head[bucket] = qe;
-			qe->next->prev = qe;
+
+/**
+* Moves the element at pos down the heap until both children are due later.
+*
+* @param struct queue *q The queue.
+* @param int pos The heap index to sift down from.
+*/
+static void queue_sift_down(struct queue *q, int pos) {
+	struct q_element *qe = q->heap[pos];
+	int child;
+	
+	while ((child = pos * 2 + 1) < q->size) {
+		if (child + 1 < q->size && queue_before(q->heap[child + 1], q->heap[child])) {
+			++child;
+		}
+		if (!queue_before(q->heap[child], qe)) {
+			break;
 		}
+		queue_set(q, pos, q->heap[child]);
+		pos = child;
 	}
+	queue_set(q, pos, qe);
+}
+
+
+/* add data into the priority queue q with key */
+struct q_element *queue_enq(struct queue *q, void *data, long key) {
+	struct q_element *qe;
+
+	CREATE(qe, struct q_element, 1);
+	qe->data = data;
+	qe->key = key;
+	qe->seq = q->next_seq++;
+	
+	if (q->size >= q->max) {
+		q->max *= 2;
+		RECREATE(q->heap, struct q_element*, q->max);
+	}
+	
+	queue_set(q, q->size++, qe);
+	queue_sift_up(q, qe->pos);
 
 	return qe;
 }
@@ -191,21 +243,24 @@ struct q_element *queue_enq(struct queue *q, void *data, long key) {
 
 /* remove queue element qe from the priority queue q */
 void queue_deq(struct queue *q, struct q_element *qe) {
-	int i;
+	struct q_element *last;
+	int pos;
 
 	assert(qe);
-
-	i = qe->key % NUM_EVENT_QUEUES;
-
-	if (qe->prev == NULL)
-		q->head[i] = qe->next;
-	else
-		qe->prev->next = qe->next;
-
-	if (qe->next == NULL)
-		q->tail[i] = qe->prev;
-	else
-		qe->next->prev = qe->prev;
+	
+	pos = qe->pos;
+	last = q->heap[--q->size];
+	
+	// move the last element into the hole, then restore the heap
+	if (last != qe) {
+		queue_set(q, pos, last);
+		if (pos > 0 && queue_before(last, q->heap[(pos - 1) / 2])) {
+			queue_sift_up(q, pos);
+		}
+		else {
+			queue_sift_down(q, pos);
+		}
+	}
 
 	free(qe);
 }
@@ -217,15 +272,12 @@ void queue_deq(struct queue *q, struct q_element *qe) {
 */
 void *queue_head(struct queue *q) {
 	void *data;
-	int i;
 
-	i = pulse % NUM_EVENT_QUEUES;
-
-	if (!q->head[i])
+	if (!q->size)
 		return NULL;
 
-	data = q->head[i]->data;
-	queue_deq(q, q->head[i]);
+	data = q->heap[0]->data;
+	queue_deq(q, q->heap[0]);
 	return data;
 }
 
@@ -235,12 +287,8 @@ void *queue_head(struct queue *q) {
 * if q is NULL, then return the largest unsigned number
 */
 long queue_key(struct queue *q) {
-	int i;
-
-	i = pulse % NUM_EVENT_QUEUES;
-
-	if (q->head[i])
-		return q->head[i]->key;
+	if (q->size)
+		return q->heap[0]->key;
 	else
 		return LONG_MAX;
 }
@@ -255,13 +303,10 @@ long queue_elmt_key(struct q_element *qe) {
 /* free q and contents */
 void queue_free(struct queue *q) {
 	int i;
-	struct q_element *qe, *next_qe;
 
-	for (i = 0; i < NUM_EVENT_QUEUES; i++)
-		for (qe = q->head[i]; qe; qe = next_qe) {
-			next_qe = qe->next;
-			free(qe);
-		}
+	for (i = 0; i < q->size; i++)
+		free(q->heap[i]);
 
+	free(q->heap);
 	free(q);
 }
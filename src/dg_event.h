@@ -36,17 +36,22 @@ struct event {
 
 /***** Queue related info ******/
 
-/* number of queues to use (reduces enqueue cost) */
-#define NUM_EVENT_QUEUES    10
+/* starting size of the heap (it doubles as needed) */
+#define EVENT_QUEUE_START_SIZE  1024
 
+// binary min-heap ordered by key; ties run newest-first like the old lists
 struct queue {
-	struct q_element *head[NUM_EVENT_QUEUES], *tail[NUM_EVENT_QUEUES];
+	struct q_element **heap;	// heap[0] is the next element due
+	int size;	// number of elements in the heap
+	int max;	// allocated size of heap
+	unsigned long next_seq;	// order of insertion, for ties
 };
 
 struct q_element {
 	void *data;
 	long key;
-	struct q_element *prev, *next;
+	unsigned long seq;	// when it was added (higher = newer)
+	int pos;	// current index in the heap
 };
 /****** End of Queue related info ********/
 
@@ -88,7 +88,13 @@ struct script_data *create_script_data(void *attach_to, int type) {
 
 /* release memory allocated for a variable list */
 void free_varlist(struct trig_var_data *vd) {
-	struct trig_var_data *i, *j;
+	struct trig_var_data *i, *j, *head;
+	
+	// free the name index (any var in it will do)
+	for (head = vd; head && !head->hashed; head = head->next);
+	if (head) {
+		HASH_CLEAR(hh, head);
+	}
 
 	for (i = vd; i;) {
 		j = i;
@@ -97,6 +103,8 @@ void free_varlist(struct trig_var_data *vd) {
 			free(j->name);
 		if (j->value)
 			free(j->value);
+		if (j->key)
+			free(j->key);
 		free(j);
 	}
 }
@@ -374,7 +374,7 @@ void do_dg_own(empire_data *emp, char_data *vict, obj_data *obj, room_data *room
 				abandon_room(VEH_INTERIOR_HOME_ROOM(veh));
 			}
 		}
-		VEH_OWNER(veh) = emp;
+		set_vehicle_owner(veh, emp);
 		if (emp && VEH_INTERIOR_HOME_ROOM(veh)) {
 			claim_room(VEH_INTERIOR_HOME_ROOM(veh), emp);
 		}
@@ -387,7 +387,7 @@ void do_dg_own(empire_data *emp, char_data *vict, obj_data *obj, room_data *room
 			claim_room(room, emp);
 		}
 		if (GET_ROOM_VEHICLE(room)) {
-			VEH_OWNER(GET_ROOM_VEHICLE(room)) = emp;
+			set_vehicle_owner(GET_ROOM_VEHICLE(room), emp);
 		}
 	}
 }
@@ -76,6 +76,7 @@ int eval_lhs_op_rhs(char *expr, char *result, void *go, struct script_data *sc,
 void extract_value(struct script_data *sc, trig_data *trig, char *cmd);
 struct cmdlist_element *find_done(struct cmdlist_element *cl);
 struct cmdlist_element *find_case(trig_data *trig, struct cmdlist_element *cl, void *go, struct script_data *sc, int type, char *cond);
+void free_var_el(struct trig_var_data *var);
 void process_eval(void *go, struct script_data *sc, trig_data *trig, int type, char *cmd);
 
 
@@ -1538,20 +1539,81 @@ ACMD(do_tattach) {
 		msg_to_char(ch, "Please specify 'mob', 'obj', or 'room'.\r\n");
 }
 
+/**
+* Var names are case-insensitive, so the name index is keyed on a lowercase
+* copy of the name.
+*
+* @param char *name The var name.
+* @param char *to A buffer to save the key in.
+* @param size_t size The size of the buffer.
+*/
+static void var_key(char *name, char *to, size_t size) {
+	size_t pos;
+	
+	for (pos = 0; name[pos] && pos < size - 1; ++pos) {
+		to[pos] = LOWER(name[pos]);
+	}
+	to[pos] = '\0';
+}
+
+
+/**
+* Finds any var in the list that's in the name index, which is needed to get
+* at the hash table (normally this is the first var in the list).
+*
+* @param struct trig_var_data *var_list The list of vars.
+* @return struct trig_var_data* Any hashed var in that list, or NULL.
+*/
+static struct trig_var_data *var_hash_head(struct trig_var_data *var_list) {
+	for (; var_list && !var_list->hashed; var_list = var_list->next);
+	return var_list;
+}
+
+
+/**
+* Looks up a var by name using the list's name index.
+*
+* @param struct trig_var_data *var_list The list of vars to search.
+* @param char *name The name of the var (case-insensitive).
+* @param int context Only find vars with this context or context 0...
+* @param bool any_context ...unless this is TRUE, which returns the newest var with that name.
+* @return struct trig_var_data* The var, or NULL if there isn't one.
+*/
+struct trig_var_data *find_var(struct trig_var_data *var_list, char *name, int context, bool any_context) {
+	struct trig_var_data *head, *vd = NULL;
+	char key[MAX_INPUT_LENGTH];
+	
+	if ((head = var_hash_head(var_list))) {
+		var_key(name, key, sizeof(key));
+		HASH_FIND_STR(head, key, vd);
+	}
+	
+	// newer vars come first, same as the list itself
+	for (; vd && !any_context; vd = vd->next_same) {
+		if (!vd->context || vd->context == context) {
+			break;
+		}
+	}
+	
+	return vd;
+}
+
+
 /*
 * Thanks to James Long for his assistance in plugging the memory leak 
 * that used to be here.   -- Welcor
 */
 /* adds a variable with given name and value to trigger */
 void add_var(struct trig_var_data **var_list, char *name, char *value, int id) {
-	struct trig_var_data *vd;
+	struct trig_var_data *vd, *older, *head;
+	char key[MAX_INPUT_LENGTH];
 
 	if (strchr(name, '.')) {
 		log("add_var() : Attempt to add illegal var: %s", name);
 		return;
 	}
 
-	for (vd = *var_list; vd && str_cmp(vd->name, name); vd = vd->next);
+	vd = older = find_var(*var_list, name, id, TRUE);
 
 	if (vd && (!vd->context || vd->context==id)) {
 		free(vd->value);
@@ -1562,18 +1624,68 @@ void add_var(struct trig_var_data **var_list, char *name, char *value, int id) {
 
 		CREATE(vd->name, char, strlen(name) + 1);
 		strcpy(vd->name, name);                            /* strcpy: ok*/
+		
+		var_key(name, key, sizeof(key));
+		vd->key = str_dup(key);
 
 		CREATE(vd->value, char, strlen(value) + 1);
 
 		vd->next = *var_list;
 		vd->context = id;
 		*var_list = vd;
+		
+		// the new var replaces any older one of the same name in the index
+		head = var_hash_head(vd->next);
+		if (older) {
+			HASH_DELETE(hh, head, older);
+			older->hashed = FALSE;
+			vd->next_same = older;
+		}
+		HASH_ADD_KEYPTR(hh, head, vd->key, strlen(vd->key), vd);
+		vd->hashed = TRUE;
 	}
 
 	strcpy(vd->value, value);                            /* strcpy: ok*/
 }
 
 
+/**
+* Removes one var from a var list (and its name index) and frees it.
+*
+* @param struct trig_var_data **var_list The list the var is in.
+* @param struct trig_var_data *vd The var to delete.
+*/
+void delete_var(struct trig_var_data **var_list, struct trig_var_data *vd) {
+	struct trig_var_data *head, *iter;
+	
+	LL_DELETE(*var_list, vd);
+	
+	if (vd->hashed) {
+		if (!(head = var_hash_head(*var_list))) {
+			head = vd;	// it was the only one
+		}
+		HASH_DELETE(hh, head, vd);
+		
+		// the next-newest var with this name takes its place
+		if (vd->next_same) {
+			HASH_ADD_KEYPTR(hh, head, vd->next_same->key, strlen(vd->next_same->key), vd->next_same);
+			vd->next_same->hashed = TRUE;
+		}
+	}
+	else {
+		// unlink it from its newer namesake's chain
+		for (iter = find_var(*var_list, vd->name, 0, TRUE); iter; iter = iter->next_same) {
+			if (iter->next_same == vd) {
+				iter->next_same = vd->next_same;
+				break;
+			}
+		}
+	}
+	
+	free_var_el(vd);
+}
+
+
 /*
 *  removes the trigger specified by name, and the script of o if
 *  it removes the last trigger.  name can either be a number, or
@@ -1880,6 +1992,9 @@ ACMD(do_tdetach) {
 void free_var_el(struct trig_var_data *var) {
 	free(var->name);
 	free(var->value);
+	if (var->key) {
+		free(var->key);
+	}
 	free(var);
 }
 
@@ -1896,10 +2011,10 @@ int remove_var(struct trig_var_data **var_list, char *name, int context) {
 	struct trig_var_data *iter, *next_iter;
 	bool any = FALSE;
 	
-	LL_FOREACH_SAFE(*var_list, iter, next_iter) {
-		if (!str_cmp(name, iter->name) && (iter->context == context || iter->context == 0)) {
-			LL_DELETE(*var_list, iter);
-			free_var_el(iter);
+	for (iter = find_var(*var_list, name, context, TRUE); iter; iter = next_iter) {
+		next_iter = iter->next_same;
+		if (iter->context == context || iter->context == 0) {
+			delete_var(var_list, iter);
 			any = TRUE;
 		}
 	}
@@ -2177,20 +2292,12 @@ void find_replacement(void *go, struct script_data *sc, trig_data *trig, int typ
 	
 	/* X.global() will have a NULL trig */
 	if (trig) {
-		for (vd = GET_TRIG_VARS(trig); vd; vd = vd->next) {
-			if (!str_cmp(vd->name, var)) {
-				break;
-			}
-		}
+		vd = find_var(GET_TRIG_VARS(trig), var, 0, TRUE);
 	}
 
 	/* some evil waitstates could crash the mud if sent here with sc==NULL*/
 	if (!vd && sc) {
-		for (vd = sc->global_vars; vd; vd = vd->next) {
-			if (!str_cmp(vd->name, var) && (vd->context==0 || vd->context==sc->context)) {
-				break;
-			}
-		}
+		vd = find_var(sc->global_vars, var, sc->context, FALSE);
 	}
 
 	if (!*field) {
@@ -3604,13 +3711,9 @@ void find_replacement(void *go, struct script_data *sc, trig_data *trig, int typ
 					}    
 
 					else if (!str_cmp(field, "varexists")) {
-						struct trig_var_data *remote_vd;
 						snprintf(str, slen, "0");
 						if (SCRIPT(c)) {
-							for (remote_vd = SCRIPT(c)->global_vars; remote_vd; remote_vd = remote_vd->next) {
-								if (!str_cmp(remote_vd->name, subfield)) break;
-							}
-							if (remote_vd)
+							if (find_var(SCRIPT(c)->global_vars, subfield, 0, TRUE))
 								snprintf(str, slen, "1");
 						}
 					}
@@ -3627,9 +3730,7 @@ void find_replacement(void *go, struct script_data *sc, trig_data *trig, int typ
 
 			if (*str == '\x1') { /* no match found in switch */
 				if (SCRIPT(c)) {
-					for (vd = (SCRIPT(c))->global_vars; vd; vd = vd->next)
-						if (!str_cmp(vd->name, field))
-							break;
+					vd = find_var(SCRIPT(c)->global_vars, field, 0, TRUE);
 					if (vd)
 						snprintf(str, slen, "%s", vd->value);
 					else {
@@ -3896,9 +3997,7 @@ void find_replacement(void *go, struct script_data *sc, trig_data *trig, int typ
 
 			if (*str == '\x1') { /* no match in switch */
 				if (SCRIPT(o)) { /* check for global var */
-					for (vd = (SCRIPT(o))->global_vars; vd; vd = vd->next)
-						if (!str_cmp(vd->name, field))
-							break;
+					vd = find_var(SCRIPT(o)->global_vars, field, 0, TRUE);
 					if (vd)
 						snprintf(str, slen, "%s", vd->value);
 					else {
@@ -4271,9 +4370,7 @@ void find_replacement(void *go, struct script_data *sc, trig_data *trig, int typ
 			
 			if (*str == '\x1') { /* no match in switch */
 				if (SCRIPT(r)) { /* check for global var */
-					for (vd = (SCRIPT(r))->global_vars; vd; vd = vd->next)
-						if (!str_cmp(vd->name, field))
-							break;
+					vd = find_var(SCRIPT(r)->global_vars, field, 0, TRUE);
 					if (vd)
 						snprintf(str, slen, "%s", vd->value);
 					else {
@@ -4585,11 +4682,7 @@ void find_replacement(void *go, struct script_data *sc, trig_data *trig, int typ
 			
 			if (*str == '\x1') { /* no match in switch */
 				if (SCRIPT(v)) { /* check for global var */
-					for (vd = (SCRIPT(v))->global_vars; vd; vd = vd->next) {
-						if (!str_cmp(vd->name, field)) {
-							break;
-						}
-					}
+					vd = find_var(SCRIPT(v)->global_vars, field, 0, TRUE);
 					if (vd) {
 						snprintf(str, slen, "%s", vd->value);
 					}
@@ -5177,8 +5270,12 @@ struct cmdlist_element *find_end(struct cmdlist_element *cl) {
 	for (c = cl->next; c->next; c = c->next) {
 		for (p = c->cmd; *p && isspace(*p); p++);
 
-		if (!strn_cmp("if ", p, 3))
-			c = find_end(c); /* may return NULL ? */
+		if (!strn_cmp("if ", p, 3)) {
+			c = find_end(c);
+			if (!c->next) {
+				break;	// nested if ran off the end of the trigger
+			}
+		}
 		else if (!strn_cmp("end", p, 3))
 			return c;
 	}
@@ -5193,31 +5290,52 @@ struct cmdlist_element *find_end(struct cmdlist_element *cl) {
 */
 struct cmdlist_element *find_else_end(trig_data *trig, struct cmdlist_element *cl, void *go, struct script_data *sc, int type) {
 	struct cmdlist_element *c;
-	char *p;
 
 	if (!(cl->next))
 		return cl;
 
-	for (c = cl->next; c && c->next; c = c ? c->next : NULL) {
-		for (p = c->cmd; *p && isspace(*p); p++); /* skip spaces */
-
-		if (!strn_cmp("if ", p, 3))
-			c = find_end(c);
-
-		else if (!strn_cmp("elseif ", p, 7)) {
-			if (process_if(p + 7, go, sc, trig, type)) {
+	// next_branch already skips nested if-blocks (see precompile_cmdlist)
+	for (c = cl->next_branch; c && c->next; c = c->next_branch) {
+		if (c->type == DG_LINE_ELSEIF) {
+			if (process_if(c->arg, go, sc, trig, type)) {
 				GET_TRIG_DEPTH(trig)++;
 				return c;
 			}
 		}
-
-		else if (!strn_cmp("else", p, 4)) {
+		else if (c->type == DG_LINE_ELSE) {
 			GET_TRIG_DEPTH(trig)++;
 			return c;
 		}
+		else {	// end
+			return c;
+		}
+	}
 
-		else if (!strn_cmp("end", p, 3))
+	return c;
+}
+
+
+/**
+* Compile-time half of find_else_end(): finds the next elseif, else, or end
+* at the same depth as cl, skipping nested if-blocks. Returns the last line
+* of the trigger if there isn't one, or NULL for some malformed scripts.
+*
+* @param struct cmdlist_element *cl An if or elseif line.
+* @return struct cmdlist_element* The next line find_else_end() should look at.
+*/
+static struct cmdlist_element *scan_else_end(struct cmdlist_element *cl) {
+	struct cmdlist_element *c;
+
+	if (!(cl->next))
+		return cl;
+
+	for (c = cl->next; c && c->next; c = c ? c->next : NULL) {
+		if (c->type == DG_LINE_IF) {
+			c = c->jump;
+		}
+		else if (c->type == DG_LINE_ELSEIF || c->type == DG_LINE_ELSE || c->type == DG_LINE_END) {
 			return c;
+		}
 	}
 
 	return c;
@@ -5728,14 +5846,10 @@ void process_remote(struct script_data *sc, trig_data *trig, char *cmd) {
 	}
 
 	/* find the locally owned variable */
-	for (vd = GET_TRIG_VARS(trig); vd; vd = vd->next)
-		if (!str_cmp(vd->name, buf))
-			break;
+	vd = find_var(GET_TRIG_VARS(trig), buf, 0, TRUE);
 
 	if (!vd)
-		for (vd = sc->global_vars; vd; vd = vd->next)
-			if (!str_cmp(vd->name, var) && (vd->context==0 || vd->context==sc->context))
-				break; 
+		vd = find_var(sc->global_vars, var, sc->context, FALSE);
 
 	if (!vd) {
 		script_log("Trigger: %s, VNum %d. local var '%s' not found in remote call", GET_TRIG_NAME(trig), GET_TRIG_VNUM(trig), buf);
@@ -5781,7 +5895,7 @@ void process_remote(struct script_data *sc, trig_data *trig, char *cmd) {
 * named vdelete so people didn't think it was to delete rooms
 */
 ACMD(do_vdelete) {
-	struct trig_var_data *vd, *vd_prev=NULL;
+	struct trig_var_data *vd;
 	struct script_data *sc_remote=NULL;
 	char *var, *uid_p;
 	char buf[MAX_INPUT_LENGTH], buf2[MAX_INPUT_LENGTH];
@@ -5840,25 +5954,13 @@ ACMD(do_vdelete) {
 	}
 
 	/* find the global */
-	for (vd = sc_remote->global_vars; vd; vd_prev = vd, vd = vd->next)
-		if (!str_cmp(vd->name, var))
-			break;
-
-	if (!vd) {
+	if (!(vd = find_var(sc_remote->global_vars, var, 0, TRUE))) {
 		msg_to_char(ch, "That variable cannot be located.\r\n");
 		return;
 	}
 
 	/* ok, delete the variable */
-	if (vd_prev)
-		vd_prev->next = vd->next;
-	else
-		sc_remote->global_vars = vd->next;
-
-	/* and free up the space */
-	free(vd->value);
-	free(vd->name);
-	free(vd);
+	delete_var(&sc_remote->global_vars, vd);
 
 	msg_to_char(ch, "Deleted.\r\n");
 }
@@ -5868,7 +5970,7 @@ ACMD(do_vdelete) {
 *     'rdelete <variable_name> <uid>'
 */
 void process_rdelete(struct script_data *sc, trig_data *trig, char *cmd) {
-	struct trig_var_data *vd, *vd_prev=NULL;
+	struct trig_var_data *vd;
 	struct script_data *sc_remote=NULL;
 	char *line, *var, *uid_p;
 	char arg[MAX_INPUT_LENGTH], buf[MAX_STRING_LENGTH], buf2[MAX_STRING_LENGTH];
@@ -5923,23 +6025,11 @@ void process_rdelete(struct script_data *sc, trig_data *trig, char *cmd) {
 		return; /* no script globals */
 
 	/* find the global */
-	for (vd = sc_remote->global_vars; vd; vd_prev = vd, vd = vd->next)
-		if (!str_cmp(vd->name, var) && (vd->context==0 || vd->context==sc->context))
-			break;
-
-	if (!vd)
+	if (!(vd = find_var(sc_remote->global_vars, var, sc->context, FALSE)))
 		return; /* the variable doesn't exist, or is the wrong context */
 
 	/* ok, delete the variable */
-	if (vd_prev)
-		vd_prev->next = vd->next;
-	else
-		sc_remote->global_vars = vd->next;
-
-	/* and free up the space */
-	free(vd->value);
-	free(vd->name);
-	free(vd);
+	delete_var(&sc_remote->global_vars, vd);
 }
 
 
@@ -5959,9 +6049,7 @@ void process_global(struct script_data *sc, trig_data *trig, char *cmd, int id)
 		return;
 	}
 
-	for (vd = GET_TRIG_VARS(trig); vd; vd = vd->next)
-		if (!str_cmp(vd->name, var))
-			break;
+	vd = find_var(GET_TRIG_VARS(trig), var, 0, TRUE);
 
 	if (!vd) {
 		script_log("Trigger: %s, VNum %d. local var '%s' not found in global call", GET_TRIG_NAME(trig), GET_TRIG_VNUM(trig), var);
@@ -6021,7 +6109,7 @@ int script_driver(union script_driver_data_u *sdd, trig_data *trig, int type, in
 	static int depth = 0;
 	int ret_val = 1;
 	struct cmdlist_element *cl;
-	char cmd[MAX_INPUT_LENGTH], *p;
+	char cmd[MAX_INPUT_LENGTH];
 	struct script_data *sc = 0;
 	struct cmdlist_element *temp;
 	unsigned long loops = 0;
@@ -6079,19 +6167,17 @@ int script_driver(union script_driver_data_u *sdd, trig_data *trig, int type, in
 	}
 
 	for (cl = (mode == TRIG_NEW) ? trig->cmdlist : trig->curr_state; cl && GET_TRIG_DEPTH(trig); cl = cl ? cl->next : NULL) {
-		for (p = cl->cmd; *p && isspace(*p); p++);
-
-		if (*p == '*') /* comment */
+		if (cl->type == DG_LINE_COMMENT)
 			continue;
 
-		else if (!strn_cmp(p, "if ", 3)) {
-			if (process_if(p + 3, go, sc, trig, type))
+		else if (cl->type == DG_LINE_IF) {
+			if (process_if(cl->arg, go, sc, trig, type))
 				GET_TRIG_DEPTH(trig)++;
 			else
 				cl = find_else_end(trig, cl, go, sc, type);
 		}
 
-		else if (!strn_cmp("elseif ", p, 7) || !strn_cmp("else", p, 4)) {
+		else if (cl->type == DG_LINE_ELSEIF || cl->type == DG_LINE_ELSE) {
 			/*
 			* if not in an if-block, ignore the extra 'else[if]' and warn about it
 			*/
@@ -6100,16 +6186,16 @@ int script_driver(union script_driver_data_u *sdd, trig_data *trig, int type, in
 				GET_TRIG_VNUM(trig));
 				continue; 
 			}
-			cl = find_end(cl);
+			cl = cl->jump;
 			GET_TRIG_DEPTH(trig)--;
 		}
-		else if (!strn_cmp("while ", p, 6)) {
-			temp = find_done(cl);  
+		else if (cl->type == DG_LINE_WHILE) {
+			temp = cl->jump;
 			if (!temp) {
 				script_log("Trigger VNum %d has 'while' without 'done'.", GET_TRIG_VNUM(trig));
 				return ret_val;
 			}
-			if (process_if(p + 6, go, sc, trig, type)) {
+			if (process_if(cl->arg, go, sc, trig, type)) {
 				temp->original = cl;
 			}
 			else {
@@ -6117,10 +6203,10 @@ int script_driver(union script_driver_data_u *sdd, trig_data *trig, int type, in
 				loops = 0;
 			}
 		}
-		else if (!strn_cmp("switch ", p, 7)) {
-			cl = find_case(trig, cl, go, sc, type, p + 7);
+		else if (cl->type == DG_LINE_SWITCH) {
+			cl = find_case(trig, cl, go, sc, type, cl->arg);
 		}
-		else if (!strn_cmp("end", p, 3)) {   
+		else if (cl->type == DG_LINE_END) {
 			/*
 			* if not in an if-block, ignore the extra 'end' and warn about it.
 			*/
@@ -6130,13 +6216,10 @@ int script_driver(union script_driver_data_u *sdd, trig_data *trig, int type, in
 			}
 			GET_TRIG_DEPTH(trig)--;
 		}
-		else if (!strn_cmp("done", p, 4)) {
+		else if (cl->type == DG_LINE_DONE) {
 			/* if in a while loop, cl->original is non-NULL */
 			if (cl->original) {
-				char *orig_cmd = cl->original->cmd;
-				while (*orig_cmd && isspace(*orig_cmd))
-					orig_cmd++;
-				if (cl->original && process_if(orig_cmd + 6, go, sc, trig, type)) {
+				if (process_if(cl->original->arg, go, sc, trig, type)) {
 					cl = cl->original;
 					loops++;   
 					GET_TRIG_LOOPS(trig)++;
@@ -6156,15 +6239,15 @@ int script_driver(union script_driver_data_u *sdd, trig_data *trig, int type, in
 				}
 			}
 		}
-		else if (!strn_cmp("break", p, 5)) {
-			cl = find_done(cl);
+		else if (cl->type == DG_LINE_BREAK) {
+			cl = cl->jump;
 		}
-		else if (!strn_cmp("case", p, 4)) { 
+		else if (cl->type == DG_LINE_CASE) { 
 			/* Do nothing, this allows multiple cases to a single instance */
 		}
 
 		else {
-			var_subst(go, sc, trig, type, p, cmd);
+			var_subst(go, sc, trig, type, cl->arg, cmd);
 
 			if (!strn_cmp(cmd, "eval ", 5))
 				process_eval(go, sc, trig, type, cmd);
@@ -6299,34 +6382,61 @@ trig_data *real_trigger(trig_vnum vnum) {
 struct cmdlist_element *find_case(trig_data *trig, struct cmdlist_element *cl, void *go, struct script_data *sc, int type, char *cond) {
 	char result[MAX_INPUT_LENGTH];
 	struct cmdlist_element *c;
-	char *p, *buf;
+	char *buf;
 
 	eval_expr(cond, result, go, sc, trig, type);
 
 	if (!(cl->next))
 		return cl;  
 
-	for (c = cl->next; c->next; c = c->next) {
-		for (p = c->cmd; *p && isspace(*p); p++);
-
-		if (!strn_cmp("while ", p, 6) || !strn_cmp("switch", p, 6))
-			c = find_done(c);
-		else if (!strn_cmp("case ", p, 5)) {
+	// next_branch already skips nested while/switch blocks (see precompile_cmdlist)
+	for (c = cl->next_branch; c && c->next; c = c->next_branch) {
+		if (c->type == DG_LINE_CASE) {
 			buf = (char*)malloc(MAX_STRING_LENGTH);
-			eval_op("==", result, p + 5, buf, go, sc, trig);
+			eval_op("==", result, c->arg, buf, go, sc, trig);
 			if (*buf && *buf!='0') {
 				free(buf);
 				return c;
 			}
 			free(buf);
 		}
+		else {	// default or done
+			return c;
+		}
+	}
+	return c;
+}
+
+
+/**
+* Compile-time half of find_case(): finds the next case, default, or done at
+* the same depth as cl, skipping nested while/switch blocks. Returns the last
+* line of the trigger if there isn't one, or NULL for some malformed scripts.
+*
+* @param struct cmdlist_element *cl A switch or case line.
+* @return struct cmdlist_element* The next line find_case() should look at.
+*/
+static struct cmdlist_element *scan_case(struct cmdlist_element *cl) {
+	struct cmdlist_element *c;
+	char *p;
+
+	if (!(cl->next))
+		return cl;
+
+	for (c = cl->next; c && c->next; c = c ? c->next : NULL) {
+		for (p = c->cmd; *p && isspace(*p); p++);
+
+		if (!strn_cmp("while ", p, 6) || !strn_cmp("switch", p, 6))
+			c = find_done(c);
+		else if (!strn_cmp("case ", p, 5))
+			return c;
 		else if (!strn_cmp("default", p, 7))
 			return c;
 		else if (!strn_cmp("done", p, 3))   
 			return c;
 	}
 	return c;
-}        
+}
 
 /*
 * scans for end of while/switch-blocks.   
@@ -6354,6 +6464,101 @@ struct cmdlist_element *find_done(struct cmdlist_element *cl) {
 }
 
 
+/**
+* Parses a trigger's command list once, when it's loaded or saved, so that
+* script_driver() can dispatch on each line's type and jump straight to the
+* matching end/done instead of re-reading the script text every time it runs.
+* Instances share their prototype's list, so this only runs per prototype.
+*
+* @param struct cmdlist_element *list The first line of the trigger.
+*/
+void precompile_cmdlist(struct cmdlist_element *list) {
+	struct cmdlist_element *cl;
+	char *p;
+	
+	// classify every line first: the jumps below depend on it
+	LL_FOREACH(list, cl) {
+		for (p = cl->cmd; *p && isspace(*p); p++);
+		
+		cl->arg = p;
+		cl->jump = cl->next_branch = NULL;
+		
+		if (*p == '*') {
+			cl->type = DG_LINE_COMMENT;
+		}
+		else if (!strn_cmp(p, "if ", 3)) {
+			cl->type = DG_LINE_IF;
+			cl->arg = p + 3;
+		}
+		else if (!strn_cmp("elseif ", p, 7)) {
+			cl->type = DG_LINE_ELSEIF;
+			cl->arg = p + 7;
+		}
+		else if (!strn_cmp("else", p, 4)) {
+			cl->type = DG_LINE_ELSE;
+		}
+		else if (!strn_cmp("while ", p, 6)) {
+			cl->type = DG_LINE_WHILE;
+			cl->arg = p + 6;
+		}
+		else if (!strn_cmp("switch ", p, 7)) {
+			cl->type = DG_LINE_SWITCH;
+			cl->arg = p + 7;
+		}
+		else if (!strn_cmp("end", p, 3)) {
+			cl->type = DG_LINE_END;
+		}
+		else if (!strn_cmp("done", p, 4)) {
+			cl->type = DG_LINE_DONE;
+		}
+		else if (!strn_cmp("break", p, 5)) {
+			cl->type = DG_LINE_BREAK;
+		}
+		else if (!strn_cmp("case", p, 4)) {
+			cl->type = DG_LINE_CASE;
+			cl->arg = (p[4] ? p + 5 : p + 4);
+		}
+		else {
+			cl->type = DG_LINE_COMMAND;
+		}
+	}
+	
+	// resolve block ends (all of these scan forward only)
+	LL_FOREACH(list, cl) {
+		switch (cl->type) {
+			case DG_LINE_IF:
+			case DG_LINE_ELSEIF:
+			case DG_LINE_ELSE: {
+				cl->jump = find_end(cl);
+				break;
+			}
+			case DG_LINE_WHILE:
+			case DG_LINE_SWITCH:
+			case DG_LINE_BREAK: {
+				cl->jump = find_done(cl);
+				break;
+			}
+		}
+	}
+	
+	// resolve where find_else_end/find_case continue from each line
+	LL_FOREACH(list, cl) {
+		switch (cl->type) {
+			case DG_LINE_IF:
+			case DG_LINE_ELSEIF: {
+				cl->next_branch = scan_else_end(cl);
+				break;
+			}
+			case DG_LINE_SWITCH:
+			case DG_LINE_CASE: {
+				cl->next_branch = scan_case(cl);
+				break;
+			}
+		}
+	}
+}
+
+
 /* read a line in from a file, return the number of chars read */
 int fgetline(FILE *file, char *p) {
 	int count = 0;
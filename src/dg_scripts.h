@@ -162,17 +162,44 @@
 #define CMDTRG_ABBREV  1
 
 
+// DG_LINE_x: what a trigger line does, set once by precompile_cmdlist()
+#define DG_LINE_COMMAND  0	// anything else: substituted and run
+#define DG_LINE_COMMENT  1	// * comment
+#define DG_LINE_IF  2	// if <cond>
+#define DG_LINE_ELSEIF  3	// elseif <cond>
+#define DG_LINE_ELSE  4	// else
+#define DG_LINE_WHILE  5	// while <cond>
+#define DG_LINE_SWITCH  6	// switch <expr>
+#define DG_LINE_END  7	// end
+#define DG_LINE_DONE  8	// done
+#define DG_LINE_BREAK  9	// break
+#define DG_LINE_CASE  10	// case <value>
+
+
 /* one line of the trigger */
 struct cmdlist_element {
 	char *cmd;				/* one line of a trigger */
 	struct cmdlist_element *original;
 	struct cmdlist_element *next;
+	
+	// precompiled by precompile_cmdlist() so the driver doesn't re-parse lines
+	int type;	// DG_LINE_x
+	char *arg;	// points into cmd: past the keyword, or the start of a command
+	struct cmdlist_element *jump;	// if/elseif/else: matching 'end'; while/switch/break: matching 'done'
+	struct cmdlist_element *next_branch;	// if/elseif: next elseif/else/end; switch/case: next case/default/done
 };
 
 struct trig_var_data {
 	char *name;				/* name of variable  */
 	char *value;				/* value of variable */
 	long context;				/* 0: global context */
+	
+	// name index: only the newest var of each name is in its list's hash;
+	// older vars with the same name (other contexts) hang off next_same
+	char *key;	// lowercased name, for the hash
+	bool hashed;	// TRUE if this var is in the hash (not just next_same)
+	struct trig_var_data *next_same;	// next-newest var with the same name
+	UT_hash_handle hh;	// hashed by key, within one var list
 
 	struct trig_var_data *next;
 };
@@ -330,6 +357,8 @@ void trig_data_copy(trig_data *this_data, const trig_data *trg);
 
 trig_data *read_trigger(int nr);
 void add_var(struct trig_var_data **var_list, char *name, char *value, int id);
+void delete_var(struct trig_var_data **var_list, struct trig_var_data *vd);
+struct trig_var_data *find_var(struct trig_var_data *var_list, char *name, int context, bool any_context);
 room_data *dg_room_of_obj(obj_data *obj);
 room_data *do_dg_add_room_dir(room_data *from, int dir, bld_data *bld);
 void do_dg_affect(void *go, struct script_data *sc, trig_data *trig, int type, char *cmd);
@@ -351,6 +380,7 @@ int script_driver(union script_driver_data_u *sdd, trig_data *trig, int type, in
 //int script_driver(void *go, trig_data *trig, int type, int mode);
 
 int trgvar_in_room(room_vnum vnum);
+void precompile_cmdlist(struct cmdlist_element *list);
 struct cmdlist_element *find_done(struct cmdlist_element *cl);
 struct cmdlist_element * find_case(trig_data *trig, struct cmdlist_element *cl, void *go, struct script_data *sc, int type, char *cond);
 int find_eq_pos_script(char *arg);
@@ -360,14 +360,18 @@ void add_faction_to_table(faction_data *fct) {
 		HASH_FIND_INT(faction_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(faction_table, vnum, fct);
-			HASH_SORT(faction_table, sort_factions);
+			if (!defer_table_sorts) {
+				HASH_SORT(faction_table, sort_factions);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_factions, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_factions, vnum, sizeof(int), fct);
-			HASH_SRT(sorted_hh, sorted_factions, sort_factions_by_data);
+			if (!defer_table_sorts) {
+				HASH_SRT(sorted_hh, sorted_factions, sort_factions_by_data);
+			}
 		}
 	}
 }
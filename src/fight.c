@@ -1177,7 +1177,7 @@ obj_data *die(char_data *ch, char_data *killer) {
 	
 	// for players, die() ends here, until they respawn or quit
 	if (!IS_NPC(ch)) {
-		add_cooldown(ch, COOLDOWN_DEATH_RESPAWN, config_get_int("death_release_minutes") * SECS_PER_REAL_MIN);
+		add_cooldown(ch, COOLDOWN_DEATH_RESPAWN, CONFIG_INT(CFG_DEATH_RELEASE_MINUTES) * SECS_PER_REAL_MIN);
 		msg_to_char(ch, "Type 'respawn' to come back at your tomb.\r\n");
 		GET_HEALTH(ch) = MIN(GET_HEALTH(ch), -10);	// ensure negative health
 		GET_POS(ch) = POS_DEAD;	// ensure pos
@@ -1562,8 +1562,8 @@ obj_data *player_death(char_data *ch) {
 	}
 	
 	// penalize after so many deaths
-	if (GET_RECENT_DEATH_COUNT(ch) >= config_get_int("deaths_before_penalty") || (is_at_war(GET_LOYALTY(ch)) && GET_RECENT_DEATH_COUNT(ch) >= config_get_int("deaths_before_penalty_war"))) {
-		int duration = config_get_int("seconds_per_death") * (GET_RECENT_DEATH_COUNT(ch) + 1 - config_get_int("deaths_before_penalty")) / SECS_PER_REAL_UPDATE;
+	if (GET_RECENT_DEATH_COUNT(ch) >= CONFIG_INT(CFG_DEATHS_BEFORE_PENALTY) || (is_at_war(GET_LOYALTY(ch)) && GET_RECENT_DEATH_COUNT(ch) >= CONFIG_INT(CFG_DEATHS_BEFORE_PENALTY_WAR))) {
+		int duration = CONFIG_INT(CFG_SECONDS_PER_DEATH) * (GET_RECENT_DEATH_COUNT(ch) + 1 - CONFIG_INT(CFG_DEATHS_BEFORE_PENALTY)) / SECS_PER_REAL_UPDATE;
 		struct affected_type *af = create_flag_aff(ATYPE_DEATH_PENALTY, duration, AFF_IMMUNE_PHYSICAL | AFF_NO_ATTACK | AFF_STUNNED, ch);
 		affect_join(ch, af, ADD_DURATION);
 	}
@@ -1824,12 +1824,12 @@ void process_tower(room_data *room) {
 * Iterates over empires, finds guard towers, and tries to shoot with them.
 */
 void update_guard_towers(void) {
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	room_data *tower;
 	empire_data *emp, *next_emp;
 	
 	HASH_ITER(hh, empire_table, emp, next_emp) {
-		for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = ter->next) {
+		HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
 			tower = ter->room;
 			
 			if (room_has_function_and_city_ok(tower, FNC_GUARD_TOWER)) {
@@ -3495,11 +3495,11 @@ void trigger_distrust_from_hostile(char_data *ch, empire_data *emp) {
 		return;
 	}
 	
-	add_cooldown(ch, COOLDOWN_HOSTILE_FLAG, config_get_int("hostile_flag_time") * SECS_PER_REAL_MIN);
+	add_cooldown(ch, COOLDOWN_HOSTILE_FLAG, CONFIG_INT(CFG_HOSTILE_FLAG_TIME) * SECS_PER_REAL_MIN);
 	
 	// no player empire? mark rogue and done
 	if (!chemp) {
-		add_cooldown(ch, COOLDOWN_ROGUE_FLAG, config_get_int("rogue_flag_time") * SECS_PER_REAL_MIN);
+		add_cooldown(ch, COOLDOWN_ROGUE_FLAG, CONFIG_INT(CFG_ROGUE_FLAG_TIME) * SECS_PER_REAL_MIN);
 		return;
 	}
 	
@@ -77,6 +77,7 @@ void adjust_building_tech(empire_data *emp, room_data *room, bool add);
 void check_delayed_load(char_data *ch);
 void extract_trigger(trig_data *trig);
 void scale_item_to_level(obj_data *obj, int level);
+void stats_adjust_building_count(bld_data *bdg, int amount);
 
 // locals
 static void add_obj_binding(int idnum, struct obj_binding **list);
@@ -548,6 +549,9 @@ void affect_remove_room(room_data *room, struct affected_type *af) {
 
 	REMOVE_FROM_LIST(af, ROOM_AFFECTS(room), next);
 	free(af);
+	
+	clear_map_render_cache(GET_ROOM_VNUM(room));
+	request_world_save(GET_ROOM_VNUM(room));
 }
 
 
@@ -592,6 +596,8 @@ void affect_to_room(room_data *room, struct affected_type *af) {
 	ROOM_AFFECTS(room) = affected_alloc;
 
 	SET_BIT(ROOM_AFF_FLAGS(room), af->bitvector);
+	clear_map_render_cache(GET_ROOM_VNUM(room));
+	request_world_save(GET_ROOM_VNUM(room));
 }
 
 
@@ -2429,14 +2435,12 @@ struct empire_political_data *find_relation(empire_data *from, empire_data *to)
 * @return struct empire_territory_data* the territory data, or NULL if not found
 */
 struct empire_territory_data *find_territory_entry(empire_data *emp, room_data *room) {
-	struct empire_territory_data *found = NULL, *ter_iter;
+	struct empire_territory_data *found = NULL;
+	room_vnum vnum;
 	
-	if (emp) {
-		for (ter_iter = EMPIRE_TERRITORY_LIST(emp); ter_iter && !found; ter_iter = ter_iter->next) {
-			if (ter_iter->room == room) {
-				found = ter_iter;
-			}
-		}
+	if (emp && room) {
+		vnum = GET_ROOM_VNUM(room);
+		HASH_FIND_INT(EMPIRE_TERRITORY_LIST(emp), &vnum, found);
 	}
 	
 	return found;
@@ -2536,6 +2540,8 @@ void perform_abandon_room(room_data *room) {
 	}
 	
 	ROOM_OWNER(room) = NULL;
+	clear_map_render_cache(GET_ROOM_VNUM(room));
+	request_world_save(GET_ROOM_VNUM(room));
 
 	REMOVE_BIT(ROOM_BASE_FLAGS(room), ROOM_AFF_PUBLIC | ROOM_AFF_NO_WORK);
 	REMOVE_BIT(ROOM_AFF_FLAGS(room), ROOM_AFF_PUBLIC | ROOM_AFF_NO_WORK);
@@ -2565,6 +2571,8 @@ void perform_claim_room(room_data *room, empire_data *emp) {
 	
 	ROOM_OWNER(room) = emp;
 	remove_room_extra_data(room, ROOM_EXTRA_CEDED);	// not ceded if just claimed
+	clear_map_render_cache(GET_ROOM_VNUM(room));
+	request_world_save(GET_ROOM_VNUM(room));
 	
 	adjust_building_tech(emp, room, TRUE);
 	
@@ -4541,6 +4549,15 @@ void obj_from_room(obj_data *object) {
 		}
 
 		REMOVE_FROM_LIST(object, ROOM_CONTENTS(IN_ROOM(object)), next_content);
+		
+		// the .wld file only changes if the room no longer has an objpack
+		if (!ROOM_CONTENTS(IN_ROOM(object)) && !ROOM_VEHICLES(IN_ROOM(object))) {
+			request_world_save(GET_ROOM_VNUM(IN_ROOM(object)));
+		}
+		else {
+			request_objpack_save(IN_ROOM(object));
+		}
+		
 		IN_ROOM(object) = NULL;
 		object->next_content = NULL;
 	}
@@ -4760,6 +4777,14 @@ void obj_to_room(obj_data *object, room_data *room) {
 		IN_ROOM(object) = room;
 		object->carried_by = NULL;
 		
+		// the .wld file only changes if the room didn't have an objpack yet
+		if (!object->next_content && !ROOM_VEHICLES(room)) {
+			request_world_save(GET_ROOM_VNUM(room));
+		}
+		else {
+			request_objpack_save(room);
+		}
+		
 		// check light
 		if (OBJ_FLAGGED(object, OBJ_LIGHT)) {
 			ROOM_LIGHTS(IN_ROOM(object))++;
@@ -6017,7 +6042,14 @@ void attach_building_to_room(bld_data *bld, room_data *room, bool with_triggers)
 	if (!COMPLEX_DATA(room)) {
 		COMPLEX_DATA(room) = init_complex_data();
 	}
+	if (GET_ROOM_VNUM(room) < MAP_SIZE) {	// world stats only count map tiles
+		stats_adjust_building_count(COMPLEX_DATA(room)->bld_ptr, -1);
+		stats_adjust_building_count(bld, 1);
+	}
+	update_building_index(room, COMPLEX_DATA(room)->bld_ptr, bld);
 	COMPLEX_DATA(room)->bld_ptr = bld;
+	clear_map_render_cache(GET_ROOM_VNUM(room));
+	request_world_save(GET_ROOM_VNUM(room));
 
 	// copy proto script
 	if (with_triggers) {
@@ -6072,7 +6104,13 @@ void detach_building_from_room(room_data *room) {
 		return;	// nothing to do
 	}
 	
+	if (GET_ROOM_VNUM(room) < MAP_SIZE) {
+		stats_adjust_building_count(bld, -1);
+	}
+	update_building_index(room, bld, NULL);
 	COMPLEX_DATA(room)->bld_ptr = NULL;
+	clear_map_render_cache(GET_ROOM_VNUM(room));
+	request_world_save(GET_ROOM_VNUM(room));
 	LL_FOREACH_SAFE(room->proto_script, tpl, next_tpl) {
 		LL_SEARCH_SCALAR(GET_BLD_SCRIPTS(bld), search, vnum, tpl->vnum);
 		if (search) {	// matching vnum on the proto
@@ -6496,8 +6534,8 @@ void sort_evolutions(sector_data *sect) {
 * @param int amount How much to add
 */
 void add_to_empire_storage(empire_data *emp, int island, obj_vnum vnum, int amount) {
-	struct empire_storage_data *temp, *store = find_stored_resource(emp, island, vnum);
-	
+	struct empire_storage_data *store = find_stored_resource(emp, island, vnum);
+	struct empire_island *isle;
 	int old;
 	
 	// nothing to do
@@ -6512,37 +6550,44 @@ void add_to_empire_storage(empire_data *emp, int island, obj_vnum vnum, int amou
 		return;
 	}
 	
+	isle = get_empire_island(emp, island);
+	
 	if (!store) {
 		CREATE(store, struct empire_storage_data, 1);
-		store->next = EMPIRE_STORAGE(emp);
-		EMPIRE_STORAGE(emp) = store;
-
 		store->vnum = vnum;
 		store->island = island;
+		HASH_ADD_INT(isle->store, vnum, store);
 	}
 	
 	old = store->amount;
+	store->amount += amount;
 	if (amount > 0) {
-		store->amount += amount;
 		if (store->amount > MAX_STORAGE || store->amount < old) {
 			// check wrapping
 			store->amount = MAX_STORAGE;
 		}
 	}
 	else if (amount < 0) {
-		store->amount -= amount;
 		if (store->amount < 0 || store->amount > old) {
 			// check wrapping
 			store->amount = 0;
 		}
 	}
 	
-	if (store && store->amount <= 0) {
-		REMOVE_FROM_LIST(store, EMPIRE_STORAGE(emp), next);
-		free(store);
+	isle->store_total += store->amount - old;
+	
+	// journal the new amount rather than re-saving the whole empire
+	if (emp->storage_loaded) {
+		add_to_empire_journal(emp, "O %d %d %d\n", vnum, island, MAX(0, store->amount));
+	}
+	else {
+		EMPIRE_NEEDS_SAVE(emp) = TRUE;
 	}
 	
-	EMPIRE_NEEDS_SAVE(emp) = TRUE;
+	if (store->amount <= 0) {
+		HASH_DEL(isle->store, store);
+		free(store);
+	}
 }
 
 
@@ -6559,6 +6604,7 @@ void add_to_empire_storage(empire_data *emp, int island, obj_vnum vnum, int amou
 */
 bool charge_stored_component(empire_data *emp, int island, int cmp_type, int cmp_flags, int amount, struct resource_data **build_used_list) {
 	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle, *next_isle;
 	int this, found = 0;
 	obj_data *proto;
 	
@@ -6567,42 +6613,44 @@ bool charge_stored_component(empire_data *emp, int island, int cmp_type, int cmp
 		return TRUE;
 	}
 	
-	LL_FOREACH_SAFE(EMPIRE_STORAGE(emp), store, next_store) {
-		if (island != ANY_ISLAND && island != store->island) {
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		if (island != ANY_ISLAND && island != isle->island) {
 			continue;
 		}
 		
-		// need obj
-		if (!(proto = obj_proto(store->vnum))) {
-			continue;
-		}
+		HASH_ITER(hh, isle->store, store, next_store) {
+			// need obj
+			if (!(proto = obj_proto(store->vnum))) {
+				continue;
+			}
 		
-		// matching component?
-		if (GET_OBJ_CMP_TYPE(proto) != cmp_type || (GET_OBJ_CMP_FLAGS(proto) & cmp_flags) != cmp_flags) {
-			continue;
-		}
+			// matching component?
+			if (GET_OBJ_CMP_TYPE(proto) != cmp_type || (GET_OBJ_CMP_FLAGS(proto) & cmp_flags) != cmp_flags) {
+				continue;
+			}
 		
-		// ok make it so
-		this = MIN(amount, store->amount);
-		found += this;
-		SAFE_ADD(store->amount, -this, 0, INT_MAX, FALSE);
+			// ok make it so
+			this = MIN(amount - found, store->amount);
+			found += this;
 		
-		if (build_used_list) {
-			add_to_resource_list(build_used_list, RES_OBJECT, store->vnum, this, 0);
-		}
+			if (build_used_list) {
+				add_to_resource_list(build_used_list, RES_OBJECT, store->vnum, this, 0);
+			}
+			
+			// may free store
+			add_to_empire_storage(emp, isle->island, store->vnum, -this);
 		
-		if (store->amount <= 0) {
-			LL_DELETE(EMPIRE_STORAGE(emp), store);
-			free(store);
+			// done?
+			if (found >= amount) {
+				break;
+			}
 		}
 		
-		// done?
 		if (found >= amount) {
 			break;
 		}
 	}
 	
-	EMPIRE_NEEDS_SAVE(emp) = TRUE;
 	return (found >= amount);
 }
 
@@ -6617,49 +6665,31 @@ bool charge_stored_component(empire_data *emp, int island, int cmp_type, int cmp
 * @return bool TRUE if it was able to charge enough, FALSE if not
 */
 bool charge_stored_resource(empire_data *emp, int island, obj_vnum vnum, int amount) {
-	struct empire_storage_data *store, *next_store, *temp;
-	int old;
+	struct empire_island *isle, *next_isle;
+	struct empire_storage_data *store;
+	int this;
 	
 	// can't charge a negative amount
 	if (amount < 0) {
 		return TRUE;
 	}
 	
-	for (store = EMPIRE_STORAGE(emp); store; store = next_store) {
-		next_store = store->next;
-		
-		if (island != ANY_ISLAND && island != store->island) {
-			continue;
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		if (amount <= 0) {
+			break;	// done
 		}
-		if (vnum != store->vnum) {
+		if (island != ANY_ISLAND && island != isle->island) {
 			continue;
 		}
 		
-		// ok?
-		old = store->amount;
-		store->amount -= amount;
-		
-		// bounds check
-		if (store->amount > old) {
-			store->amount = 0;
-		}
-		
-		if (store->amount >= 0) {
-			// success
-			amount = 0;
-		}
-		else if (store->amount < 0) {
-			// if it went negative, credit it back to amount
-			amount -= store->amount;
-		}
-	
-		if (store->amount <= 0) {
-			REMOVE_FROM_LIST(store, EMPIRE_STORAGE(emp), next);
-			free(store);
+		HASH_FIND_INT(isle->store, &vnum, store);
+		if (store) {
+			this = MIN(amount, store->amount);
+			amount -= this;
+			add_to_empire_storage(emp, isle->island, vnum, -this);
 		}
 	}
 	
-	EMPIRE_NEEDS_SAVE(emp) = TRUE;
 	return (amount <= 0);
 }
 
@@ -6673,20 +6703,18 @@ bool charge_stored_resource(empire_data *emp, int island, obj_vnum vnum, int amo
 * @return bool TRUE if it deleted at least 1, FALSE if it deleted 0.
 */
 bool delete_stored_resource(empire_data *emp, obj_vnum vnum) {
-	struct empire_storage_data *sto, *next_sto, *temp;
+	struct empire_island *isle, *next_isle;
+	struct empire_storage_data *sto;
 	int deleted = 0;
 	
-	for (sto = EMPIRE_STORAGE(emp); sto; sto = next_sto) {
-		next_sto = sto->next;
-		
-		if (sto->vnum == vnum) {
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		HASH_FIND_INT(isle->store, &vnum, sto);
+		if (sto) {
 			deleted += sto->amount;
-			REMOVE_FROM_LIST(sto, EMPIRE_STORAGE(emp), next);
-			free(sto);
+			add_to_empire_storage(emp, isle->island, vnum, -sto->amount);
 		}
 	}
 	
-	EMPIRE_NEEDS_SAVE(emp) = TRUE;
 	return (deleted > 0) ? TRUE : FALSE;
 }
 
@@ -6702,15 +6730,17 @@ bool delete_stored_resource(empire_data *emp, obj_vnum vnum) {
 * @param int amount The number that must be available.
 */
 bool empire_can_afford_component(empire_data *emp, int island, int cmp_type, int cmp_flags, int amount) {
-	struct empire_storage_data *store;
+	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle;
 	obj_data *proto;
 	int found = 0;
 	
-	LL_FOREACH(EMPIRE_STORAGE(emp), store) {
-		if (store->island != island) {
-			continue;
-		}
-		
+	HASH_FIND_INT(EMPIRE_ISLANDS(emp), &island, isle);
+	if (!isle) {
+		return (amount <= 0);
+	}
+	
+	HASH_ITER(hh, isle->store, store, next_store) {
 		// need obj
 		if (!(proto = obj_proto(store->vnum))) {
 			continue;
@@ -6738,13 +6768,16 @@ bool empire_can_afford_component(empire_data *emp, int island, int cmp_type, int
 * @return struct empire_storage_data* The storage entry, or NULL if no matches.
 */
 struct empire_storage_data *find_island_storage_by_keywords(empire_data *emp, int island_id, char *keywords) {
-	struct empire_storage_data *store;
+	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle;
 	obj_data *proto;
 	
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		if (store->island != island_id) {
-			continue;
-		}
+	HASH_FIND_INT(EMPIRE_ISLANDS(emp), &island_id, isle);
+	if (!isle) {
+		return NULL;
+	}
+	
+	HASH_ITER(hh, isle->store, store, next_store) {
 		if (!(proto = obj_proto(store->vnum))) {
 			continue;
 		}
@@ -6791,15 +6824,15 @@ int find_lowest_storage_loc(obj_data *obj) {
 * @return struct empire_storage_data* A pointer to the storage object for the empire, if any (otherwise NULL).
 */
 struct empire_storage_data *find_stored_resource(empire_data *emp, int island, obj_vnum vnum) {
-	struct empire_storage_data *store;
-
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		if (store->island == island && store->vnum == vnum) {
-			return store;
-		}
+	struct empire_storage_data *store = NULL;
+	struct empire_island *isle;
+	
+	HASH_FIND_INT(EMPIRE_ISLANDS(emp), &island, isle);
+	if (isle) {
+		HASH_FIND_INT(isle->store, &vnum, store);
 	}
 	
-	return NULL;
+	return store;
 }
 
 
@@ -6812,6 +6845,7 @@ struct empire_storage_data *find_stored_resource(empire_data *emp, int island, o
 * @return int The total number the empire has stored.
 */
 int get_total_stored_count(empire_data *emp, obj_vnum vnum, bool count_shipping) {
+	struct empire_island *isle, *next_isle;
 	struct empire_storage_data *sto;
 	struct shipping_data *shipd;
 	int count = 0;
@@ -6820,8 +6854,9 @@ int get_total_stored_count(empire_data *emp, obj_vnum vnum, bool count_shipping)
 		return count;
 	}
 	
-	for (sto = EMPIRE_STORAGE(emp); sto; sto = sto->next) {
-		if (sto->vnum == vnum) {
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		HASH_FIND_INT(isle->store, &vnum, sto);
+		if (sto) {
 			SAFE_ADD(count, sto->amount, INT_MIN, INT_MAX, TRUE);
 		}
 	}
@@ -6867,15 +6902,18 @@ bool obj_can_be_stored(obj_data *obj, room_data *loc) {
 * @empire_data *emp
 */
 void read_vault(empire_data *emp) {
-	struct empire_storage_data *store;
+	struct empire_storage_data *store, *next_store;
+	struct empire_island *isle, *next_isle;
 	obj_data *proto;
 	
 	EMPIRE_WEALTH(emp) = 0;
 
-	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-		if ((proto = obj_proto(store->vnum))) {
-			if (IS_WEALTH_ITEM(proto)) {
-				EMPIRE_WEALTH(emp) += GET_WEALTH_VALUE(proto) * store->amount;
+	HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+		HASH_ITER(hh, isle->store, store, next_store) {
+			if ((proto = obj_proto(store->vnum))) {
+				if (IS_WEALTH_ITEM(proto)) {
+					EMPIRE_WEALTH(emp) += GET_WEALTH_VALUE(proto) * store->amount;
+				}
 			}
 		}
 	}
@@ -6927,8 +6965,6 @@ bool retrieve_resource(char_data *ch, empire_data *emp, struct empire_storage_da
 		trigger_distrust_from_stealth(ch, emp);
 	}
 	
-	EMPIRE_NEEDS_SAVE(emp) = TRUE;
-	
 	// if it ran out, return false to prevent loops
 	return (available > 0);
 }
@@ -6948,7 +6984,6 @@ int store_resource(char_data *ch, empire_data *emp, obj_data *obj) {
 
 	add_to_empire_storage(emp, GET_ISLAND_ID(IN_ROOM(ch)), GET_OBJ_VNUM(obj), 1);
 	extract_obj(obj);
-	EMPIRE_NEEDS_SAVE(emp) = TRUE;
 	
 	return 1;
 }
@@ -7386,11 +7421,56 @@ void extract_vehicle(vehicle_data *veh) {
 		unharness_mob_from_vehicle(VEH_ANIMALS(veh), veh);
 	}
 	
+	set_vehicle_owner(veh, NULL);	// remove from the owner's vehicle index
 	LL_DELETE2(vehicle_list, veh, next);
 	free_vehicle(veh);
 }
 
 
+/**
+* Changes who owns a vehicle. Always use this instead of setting VEH_OWNER()
+* directly, as it also maintains the owners' vehicle indexes.
+*
+* @param vehicle_data *veh The vehicle.
+* @param empire_data *emp The new owner (or NULL for none).
+*/
+void set_vehicle_owner(vehicle_data *veh, empire_data *emp) {
+	struct empire_vehicle_index *index;
+	any_vnum vnum = VEH_VNUM(veh);
+	
+	if (VEH_OWNER(veh) == emp) {
+		return;	// no change
+	}
+	
+	// remove from old owner
+	if (VEH_OWNER(veh)) {
+		HASH_FIND_INT(EMPIRE_VEHICLE_INDEX(VEH_OWNER(veh)), &vnum, index);
+		if (index) {
+			DL_DELETE2(index->vehicles, veh, prev_owned, next_owned);
+			if (--index->count <= 0) {
+				HASH_DEL(EMPIRE_VEHICLE_INDEX(VEH_OWNER(veh)), index);
+				free(index);
+			}
+		}
+		veh->prev_owned = veh->next_owned = NULL;
+	}
+	
+	VEH_OWNER(veh) = emp;
+	
+	// add to new owner
+	if (emp) {
+		HASH_FIND_INT(EMPIRE_VEHICLE_INDEX(emp), &vnum, index);
+		if (!index) {
+			CREATE(index, struct empire_vehicle_index, 1);
+			index->vnum = vnum;
+			HASH_ADD_INT(EMPIRE_VEHICLE_INDEX(emp), vnum, index);
+		}
+		DL_APPEND2(index->vehicles, veh, prev_owned, next_owned);
+		++index->count;
+	}
+}
+
+
 /**
 * @param char_data *ch Someone trying to sit.
 * @param vehicle_data *veh The vehicle to seat them on.
@@ -304,6 +304,7 @@ void store_unique_item(char_data *ch, obj_data *obj, empire_data *emp, room_data
 
 // vehicle handlers
 void extract_vehicle(vehicle_data *veh);
+void set_vehicle_owner(vehicle_data *veh, empire_data *emp);
 void sit_on_vehicle(char_data *ch, vehicle_data *veh);
 void unseat_char_from_vehicle(char_data *ch);
 void vehicle_from_room(vehicle_data *veh);
@@ -749,7 +749,8 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 	extern bool rmt_has_exit(room_template *rmt, int dir);
 	
 	room_template *start_room = room_template_proto(GET_ADV_START_VNUM(adv));
-	room_data *room, *next_room, *loc, *shift, *found = NULL;
+	struct building_index_room *bir, *next_bir;
+	room_data *room, *loc, *shift, *found = NULL;
 	int dir, iter, sub, num_found, pos;
 	sector_data *findsect = NULL;
 	bool match_buildon = FALSE;
@@ -794,11 +795,11 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 	}
 	
 	// two ways of doing this:
-	if (findsect) {	// scan the whole map
+	if (findsect) {	// scan only map tiles of that sector (from the sector index)
 		num_found = 0;
-		for (map = land_map; map; map = map->next) {
-			// looking for sect: fail
-			if (findsect && map->sector_type != findsect) {
+		LL_FOREACH2(find_sector_index(GET_SECT_VNUM(findsect))->sect_rooms, map, next_in_sect) {
+			// skip BASIC_OCEAN, as the land_map would
+			if (GET_SECT_VNUM(map->sector_type) == BASIC_OCEAN) {
 				continue;
 			}
 			
@@ -814,10 +815,11 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 			}
 		}
 	}
-	else if (findbdg) {	// check live rooms for matching building
+	else if (findbdg) {	// check live rooms with that building (from the building index)
 		num_found = 0;
-		HASH_ITER(hh, world_table, room, next_room) {
-			if (BUILDING_VNUM(room) != GET_BLD_VNUM(findbdg) || !IS_COMPLETE(room)) {
+		HASH_ITER(hh, find_building_index(GET_BLD_VNUM(findbdg))->rooms, bir, next_bir) {
+			room = bir->room;
+			if (!IS_COMPLETE(room)) {
 				continue;
 			}
 			
@@ -44,6 +44,8 @@ extern struct archetype_menu_type archetype_menu[];
 void parse_archetype_menu(descriptor_data *desc, char *argument);
 
 // locals
+extern int *cmd_dispatch_index;
+extern int num_of_cmds;
 void set_creation_state(descriptor_data *d, int state);
 void show_bonus_trait_menu(char_data *ch);
 
@@ -1092,7 +1094,7 @@ cpp_extern const struct command_info cmd_info[] = {
  */
 void command_interpreter(char_data *ch, char *argument) {
 	extern bool check_social(char_data *ch, char *string, bool exact);
-	int cmd, length, iter;
+	int cmd, iter;
 	char *line;
 
 	/* just drop to next line for hitting CR */
@@ -1125,27 +1127,7 @@ void command_interpreter(char_data *ch, char *argument) {
 	}
 
 	/* otherwise, find the command */
-	for (length = strlen(arg), cmd = 0; *cmd_info[cmd].command != '\n'; cmd++) {
-		if (GET_ACCESS_LEVEL(ch) < cmd_info[cmd].minimum_level && (cmd_info[cmd].grants == NO_GRANTS || !IS_GRANTED(ch, cmd_info[cmd].grants))) {
-			continue;
-		}
-		if (IS_SET(cmd_info[cmd].flags, CMD_NO_ABBREV) ? strcmp(arg, cmd_info[cmd].command) : strncmp(cmd_info[cmd].command, arg, length)) {
-			continue;
-		}		
-		if (IS_SET(cmd_info[cmd].flags, CMD_VAMPIRE_ONLY) && !IS_VAMPIRE(ch)) {
-			continue;
-		}
-		if (IS_SET(cmd_info[cmd].flags, CMD_IMM_OR_MOB_ONLY) && GET_ACCESS_LEVEL(ch) < LVL_START_IMM && !IS_NPC(ch)) {
-			continue;
-		}
-		// NPCs can use ability commands IF they aren't charmed; players require the ability
-		if (cmd_info[cmd].ability != NO_ABIL && (IS_NPC(ch) ? AFF_FLAGGED(ch, AFF_CHARM) : !has_ability(ch, cmd_info[cmd].ability))) {
-			continue;
-		}
-		
-		// found!
-		break;
-	}
+	cmd = find_command_for_char(ch, arg);
 
 	if (!IS_SET(cmd_info[cmd].flags, CMD_STAY_HIDDEN | CMD_UNHIDE_AFTER))
 		REMOVE_BIT(AFF_FLAGS(ch), AFF_HIDE);
@@ -1218,6 +1200,104 @@ void command_interpreter(char_data *ch, char *argument) {
 }
 
 
+/**
+* Determines whether or not ch could use a given command, other than the
+* name match itself. This is the same set of checks command_interpreter has
+* always used to skip over commands the player can't see.
+*
+* @param char_data *ch The person typing the command.
+* @param int cmd A position in cmd_info[].
+* @return bool TRUE if ch can use it, FALSE if it should be skipped.
+*/
+static bool can_use_command(char_data *ch, int cmd) {
+	if (GET_ACCESS_LEVEL(ch) < cmd_info[cmd].minimum_level && (cmd_info[cmd].grants == NO_GRANTS || !IS_GRANTED(ch, cmd_info[cmd].grants))) {
+		return FALSE;
+	}
+	if (IS_SET(cmd_info[cmd].flags, CMD_VAMPIRE_ONLY) && !IS_VAMPIRE(ch)) {
+		return FALSE;
+	}
+	if (IS_SET(cmd_info[cmd].flags, CMD_IMM_OR_MOB_ONLY) && GET_ACCESS_LEVEL(ch) < LVL_START_IMM && !IS_NPC(ch)) {
+		return FALSE;
+	}
+	// NPCs can use ability commands IF they aren't charmed; players require the ability
+	if (cmd_info[cmd].ability != NO_ABIL && (IS_NPC(ch) ? AFF_FLAGGED(ch, AFF_CHARM) : !has_ability(ch, cmd_info[cmd].ability))) {
+		return FALSE;
+	}
+	return TRUE;
+}
+
+
+/**
+* Finds the command a character means when they type arg. This uses the
+* alphabetic cmd_dispatch_index (built by index_commands) to jump straight to
+* the commands that start with arg, but still picks the one that comes first
+* in cmd_info[], so abbreviation priority is exactly the order of the master
+* command list. CMD_NO_ABBREV commands only match when typed in full.
+*
+* @param char_data *ch The person typing the command.
+* @param char *arg The typed command word, already lowercased.
+* @return int The position in cmd_info[], or the position of the "\n" terminator if there's no match.
+*/
+int find_command_for_char(char_data *ch, char *arg) {
+	int lo, hi, mid, pos, cmd, found = num_of_cmds;
+	size_t length = strlen(arg);
+	
+	// binary search for the first command >= arg; all prefix matches follow it
+	lo = 0;
+	hi = num_of_cmds;
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (strcmp(cmd_info[cmd_dispatch_index[mid]].command, arg) < 0) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	
+	for (pos = lo; pos < num_of_cmds && !strncmp(cmd_info[cmd_dispatch_index[pos]].command, arg, length); ++pos) {
+		cmd = cmd_dispatch_index[pos];
+		if (cmd >= found) {
+			continue;	// already have a higher-priority match
+		}
+		if (IS_SET(cmd_info[cmd].flags, CMD_NO_ABBREV) && strcmp(arg, cmd_info[cmd].command)) {
+			continue;
+		}
+		if (can_use_command(ch, cmd)) {
+			found = cmd;
+		}
+	}
+	
+	return found;
+}
+
+
+/**
+* Finds the command a character means by scanning all of cmd_info[] in order,
+* the way command_interpreter did before cmd_dispatch_index. This is slow and
+* is only kept as a reference for find_command_for_char (see util cmdbench).
+*
+* @param char_data *ch The person typing the command.
+* @param char *arg The typed command word, already lowercased.
+* @return int The position in cmd_info[], or the position of the "\n" terminator if there's no match.
+*/
+int find_command_for_char_by_scan(char_data *ch, char *arg) {
+	size_t length = strlen(arg);
+	int cmd;
+	
+	for (cmd = 0; *cmd_info[cmd].command != '\n'; ++cmd) {
+		if (IS_SET(cmd_info[cmd].flags, CMD_NO_ABBREV) ? strcmp(arg, cmd_info[cmd].command) : strncmp(cmd_info[cmd].command, arg, length)) {
+			continue;
+		}
+		if (can_use_command(ch, cmd)) {
+			break;
+		}
+	}
+	
+	return cmd;
+}
+
+
 /* Used in specprocs, mostly.  (Exactly) matches "command" to cmd number */
 int find_command(const char *command) {
 	int cmd;
@@ -1485,6 +1565,43 @@ struct sort_struct {
 	byte is_social;
 } *cmd_sort_info = NULL;
 int num_of_cmds;
+int *cmd_dispatch_index = NULL;	// positions in cmd_info[], in strcmp order, for find_command_for_char
+
+
+/**
+* qsort helper for cmd_dispatch_index: byte order by command name (to match
+* the strncmp used for abbreviations), then by position in cmd_info[].
+*
+* @param const void *a One int position in cmd_info[].
+* @param const void *b Another int position in cmd_info[].
+* @return int Sort instruction of <0, 0, or >0.
+*/
+static int sort_command_dispatch(const void *a, const void *b) {
+	int a_cmd = *(const int*)a, b_cmd = *(const int*)b;
+	int diff = strcmp(cmd_info[a_cmd].command, cmd_info[b_cmd].command);
+	return diff ? diff : (a_cmd - b_cmd);
+}
+
+
+/**
+* Builds cmd_dispatch_index, the alphabetic index used by command_interpreter
+* to look up typed commands. Called from sort_commands() at boot; cmd_info[]
+* never changes after that.
+*/
+void index_commands(void) {
+	int iter;
+	
+	if (cmd_dispatch_index) {
+		free(cmd_dispatch_index);
+	}
+	CREATE(cmd_dispatch_index, int, num_of_cmds);
+	
+	for (iter = 0; iter < num_of_cmds; ++iter) {
+		cmd_dispatch_index[iter] = iter;
+	}
+	qsort(cmd_dispatch_index, num_of_cmds, sizeof(int), sort_command_dispatch);
+}
+
 
 void sort_commands(void) {
 	int a, b, tmp;
@@ -1517,6 +1634,8 @@ void sort_commands(void) {
 			}
 		}
 	}
+	
+	index_commands();
 }
 
 
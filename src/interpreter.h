@@ -20,6 +20,8 @@ void command_interpreter(char_data *ch, char *argument);
 char lower( char c );
 void nanny(descriptor_data *d, char *arg);
 int find_command(const char *command);
+int find_command_for_char(char_data *ch, char *arg);
+int find_command_for_char_by_scan(char_data *ch, char *arg);
 void send_low_pos_msg(char_data *ch);
 
 
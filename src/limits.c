@@ -226,7 +226,7 @@ void check_idling(char_data *ch) {
 
 	ch->char_specials.timer++;
 
-	if ((ch->desc && ch->char_specials.timer > config_get_int("idle_rent_time")) || (!ch->desc && ch->char_specials.timer > config_get_int("idle_linkdead_rent_time"))) {
+	if ((ch->desc && ch->char_specials.timer > CONFIG_INT(CFG_IDLE_RENT_TIME)) || (!ch->desc && ch->char_specials.timer > CONFIG_INT(CFG_IDLE_LINKDEAD_RENT_TIME))) {
 		perform_idle_out(ch);
 	}
 }
@@ -456,9 +456,9 @@ void point_update_char(char_data *ch) {
 	}
 	
 	// check spawned
-	if (REAL_NPC(ch) && !ch->desc && MOB_FLAGGED(ch, MOB_SPAWNED) && (!MOB_FLAGGED(ch, MOB_ANIMAL) || !room_has_function_and_city_ok(IN_ROOM(ch), FNC_STABLE)) && MOB_SPAWN_TIME(ch) < (time(0) - config_get_int("mob_spawn_interval") * SECS_PER_REAL_MIN)) {
+	if (REAL_NPC(ch) && !ch->desc && MOB_FLAGGED(ch, MOB_SPAWNED) && (!MOB_FLAGGED(ch, MOB_ANIMAL) || !room_has_function_and_city_ok(IN_ROOM(ch), FNC_STABLE)) && MOB_SPAWN_TIME(ch) < (time(0) - CONFIG_INT(CFG_MOB_SPAWN_INTERVAL) * SECS_PER_REAL_MIN)) {
 		if (!GET_LED_BY(ch) && !GET_LEADING_MOB(ch) && !GET_LEADING_VEHICLE(ch) && !MOB_FLAGGED(ch, MOB_TIED)) {
-			if (distance_to_nearest_player(IN_ROOM(ch)) > config_get_int("mob_despawn_radius")) {
+			if (distance_to_nearest_player(IN_ROOM(ch)) > CONFIG_INT(CFG_MOB_DESPAWN_RADIUS)) {
 				despawn_mob(ch);
 				return;
 			}
@@ -635,8 +635,8 @@ void real_update_char(char_data *ch) {
 			}
 			
 			// special case -- add immunity
-			if (IS_SET(af->bitvector, AFF_STUNNED) && config_get_int("stun_immunity_time") > 0) {
-				immune = create_flag_aff(ATYPE_STUN_IMMUNITY, config_get_int("stun_immunity_time") / SECS_PER_REAL_UPDATE, AFF_IMMUNE_STUN, ch);
+			if (IS_SET(af->bitvector, AFF_STUNNED) && CONFIG_INT(CFG_STUN_IMMUNITY_TIME) > 0) {
+				immune = create_flag_aff(ATYPE_STUN_IMMUNITY, CONFIG_INT(CFG_STUN_IMMUNITY_TIME) / SECS_PER_REAL_UPDATE, AFF_IMMUNE_STUN, ch);
 				affect_join(ch, immune, 0);
 			}
 			
@@ -858,7 +858,7 @@ void real_update_char(char_data *ch) {
 			continue;
 		}
 		
-		if (++fol_count > config_get_int("npc_follower_limit")) {
+		if (++fol_count > CONFIG_INT(CFG_NPC_FOLLOWER_LIMIT)) {
 			REMOVE_BIT(AFF_FLAGS(room_ch), AFF_CHARM);
 			stop_follower(room_ch);
 			
@@ -987,8 +987,11 @@ void check_wars(void) {
 * @param empire_data *emp The empire to reduce by 1 city.
 */
 static void reduce_city_overage_one(empire_data *emp) {
+	extern struct city_metadata_type city_type[];
+	
 	struct empire_city_data *city = NULL;
 	room_data *loc;
+	int radius;
 
 	if (!emp || EMPIRE_IMM_ONLY(emp)) {
 		return;
@@ -1010,7 +1013,10 @@ static void reduce_city_overage_one(empire_data *emp) {
 	
 	if (city->type > 0) {
 		log_to_empire(emp, ELOG_TERRITORY, "%s (%d, %d) is shrinking because of too many city points in use", city->name, X_COORD(loc), Y_COORD(loc));
+		radius = city_type[city->type].radius;	// the old, larger radius
+		update_city_area_territory(emp, loc, radius, FALSE);
 		city->type -= 1;
+		update_city_area_territory(emp, loc, radius, TRUE);
 	}
 	else {
 		log_to_empire(emp, ELOG_TERRITORY, "%s (%d, %d) is no longer a city because of too many city points in use", city->name, X_COORD(loc), Y_COORD(loc));
@@ -1218,7 +1224,7 @@ bool should_delete_empire(empire_data *emp) {
 		return TRUE;
 	}
 	
-	if (EMPIRE_LAST_LOGON(emp) + (config_get_int("time_to_empire_delete") * SECS_PER_REAL_WEEK) < time(0)) {
+	if (EMPIRE_LAST_LOGON(emp) + (CONFIG_INT(CFG_TIME_TO_EMPIRE_DELETE) * SECS_PER_REAL_WEEK) < time(0)) {
 		return TRUE;
 	}
 	
@@ -1252,7 +1258,7 @@ bool check_autostore(obj_data *obj, bool force) {
 	}
 	
 	// timer check (if not forced)
-	if (!force && (GET_AUTOSTORE_TIMER(obj) + config_get_int("autostore_time") * SECS_PER_REAL_MIN) > time(0)) {
+	if (!force && (GET_AUTOSTORE_TIMER(obj) + CONFIG_INT(CFG_AUTOSTORE_TIME) * SECS_PER_REAL_MIN) > time(0)) {
 		return TRUE;
 	}
 	
@@ -1309,7 +1315,7 @@ bool check_autostore(obj_data *obj, bool force) {
 		store = TRUE;
 		unique = TRUE;
 	}
-	else if (OBJ_BOUND_TO(obj) && real_loc && ROOM_PRIVATE_OWNER(HOME_ROOM(real_loc)) == NOBODY && (GET_AUTOSTORE_TIMER(obj) + config_get_int("bound_item_junk_time") * SECS_PER_REAL_MIN) < time(0)) {
+	else if (OBJ_BOUND_TO(obj) && real_loc && ROOM_PRIVATE_OWNER(HOME_ROOM(real_loc)) == NOBODY && (GET_AUTOSTORE_TIMER(obj) + CONFIG_INT(CFG_BOUND_ITEM_JUNK_TIME) * SECS_PER_REAL_MIN) < time(0)) {
 		// room owned, item is bound, not a private home, but not storable? junk it
 		store = TRUE;
 		// DON'T mark unique -- we are just junking it
@@ -1321,7 +1327,7 @@ bool check_autostore(obj_data *obj, bool force) {
 	}
 
 	// final timer check (long-autostore)
-	if (!force && real_loc && ROOM_BLD_FLAGGED(real_loc, BLD_LONG_AUTOSTORE) && (GET_AUTOSTORE_TIMER(obj) + config_get_int("long_autostore_time") * SECS_PER_REAL_MIN) > time(0)) {
+	if (!force && real_loc && ROOM_BLD_FLAGGED(real_loc, BLD_LONG_AUTOSTORE) && (GET_AUTOSTORE_TIMER(obj) + CONFIG_INT(CFG_LONG_AUTOSTORE_TIME) * SECS_PER_REAL_MIN) > time(0)) {
 		return TRUE;
 	}
 	
@@ -1617,14 +1623,14 @@ void point_update_room(room_data *room) {
 	bool junk;
 	int count;
 	
-	int allowed_animals = config_get_int("num_duplicates_in_stable");
+	int allowed_animals = CONFIG_INT(CFG_NUM_DUPLICATES_IN_STABLE);
 
 	// map-only portion
 	if (GET_ROOM_VNUM(room) < MAP_SIZE) {
 		if (ROOM_SECT_FLAGGED(room, SECTF_IS_TRENCH) && get_room_extra_data(room, ROOM_EXTRA_TRENCH_PROGRESS) >= 0) {
 			if (weather_info.sky >= SKY_RAINING) {
-				add_to_room_extra_data(room, ROOM_EXTRA_TRENCH_PROGRESS, config_get_int("trench_gain_from_rain"));
-				if (get_room_extra_data(room, ROOM_EXTRA_TRENCH_PROGRESS) >= config_get_int("trench_full_value")) {
+				add_to_room_extra_data(room, ROOM_EXTRA_TRENCH_PROGRESS, CONFIG_INT(CFG_TRENCH_GAIN_FROM_RAIN));
+				if (get_room_extra_data(room, ROOM_EXTRA_TRENCH_PROGRESS) >= CONFIG_INT(CFG_TRENCH_FULL_VALUE)) {
 					fill_trench(room);
 				}
 			}
@@ -1718,7 +1724,7 @@ void point_update_room(room_data *room) {
 	for (track = ROOM_TRACKS(room); track; track = next_track) {
 		next_track = track->next;
 		
-		if (now - track->timestamp > config_get_int("tracks_lifespan") * SECS_PER_REAL_MIN) {
+		if (now - track->timestamp > CONFIG_INT(CFG_TRACKS_LIFESPAN) * SECS_PER_REAL_MIN) {
 			REMOVE_FROM_LIST(track, ROOM_TRACKS(room), next);
 			free(track);
 		}
@@ -1823,7 +1829,7 @@ void point_update_vehicle(vehicle_data *veh) {
 	bool besiege_vehicle(vehicle_data *veh, int damage, int siege_type);
 	
 	// autostore
-	if ((time(0) - VEH_LAST_MOVE_TIME(veh)) > (config_get_int("autostore_time") * SECS_PER_REAL_MIN)) {
+	if ((time(0) - VEH_LAST_MOVE_TIME(veh)) > (CONFIG_INT(CFG_AUTOSTORE_TIME) * SECS_PER_REAL_MIN)) {
 		autostore_vehicle_contents(veh);
 	}
 
@@ -1906,7 +1912,7 @@ void update_trading_post(void) {
 	int iter, sub, count;
 	long diff;
 	
-	int trading_post_days_to_timeout = config_get_int("trading_post_days_to_timeout");
+	int trading_post_days_to_timeout = CONFIG_INT(CFG_TRADING_POST_DAYS_TO_TIMEOUT);
 	
 	for (tpd = trading_list; tpd; tpd = next_tpd) {
 		next_tpd = tpd->next;
@@ -2072,7 +2078,7 @@ int health_gain(char_data *ch, bool info_only) {
 		}
 		
 		if (GET_POS(ch) == POS_SLEEPING && !AFF_FLAGGED(ch, AFF_EARTHMELD)) {
-			min = round((double) GET_MAX_HEALTH(ch) / ((double) config_get_int("max_sleeping_regen_time") / (room_has_function_and_city_ok(IN_ROOM(ch), FNC_BEDROOM) ? 2.0 : 1.0) / SECS_PER_REAL_UPDATE));
+			min = round((double) GET_MAX_HEALTH(ch) / ((double) CONFIG_INT(CFG_MAX_SLEEPING_REGEN_TIME) / (room_has_function_and_city_ok(IN_ROOM(ch), FNC_BEDROOM) ? 2.0 : 1.0) / SECS_PER_REAL_UPDATE));
 			gain = MAX(gain, min);
 		}
 		
@@ -2128,7 +2134,7 @@ int mana_gain(char_data *ch, bool info_only) {
 		}
 		
 		if (GET_POS(ch) == POS_SLEEPING && !AFF_FLAGGED(ch, AFF_EARTHMELD)) {
-			min = round((double) GET_MAX_MANA(ch) / ((double) config_get_int("max_sleeping_regen_time") / (room_has_function_and_city_ok(IN_ROOM(ch), FNC_BEDROOM) ? 2.0 : 1.0) / SECS_PER_REAL_UPDATE));
+			min = round((double) GET_MAX_MANA(ch) / ((double) CONFIG_INT(CFG_MAX_SLEEPING_REGEN_TIME) / (room_has_function_and_city_ok(IN_ROOM(ch), FNC_BEDROOM) ? 2.0 : 1.0) / SECS_PER_REAL_UPDATE));
 			gain = MAX(gain, min);
 		}
 		
@@ -2180,7 +2186,7 @@ int move_gain(char_data *ch, bool info_only) {
 		}
 		
 		if (GET_POS(ch) == POS_SLEEPING && !AFF_FLAGGED(ch, AFF_EARTHMELD)) {
-			min = round((double) GET_MAX_MOVE(ch) / ((double) config_get_int("max_sleeping_regen_time") / (room_has_function_and_city_ok(IN_ROOM(ch), FNC_BEDROOM) ? 2.0 : 1.0) / SECS_PER_REAL_UPDATE));
+			min = round((double) GET_MAX_MOVE(ch) / ((double) CONFIG_INT(CFG_MAX_SLEEPING_REGEN_TIME) / (room_has_function_and_city_ok(IN_ROOM(ch), FNC_BEDROOM) ? 2.0 : 1.0) / SECS_PER_REAL_UPDATE));
 			gain = MAX(gain, min);
 		}
 
@@ -28,6 +28,7 @@
 * Contents:
 *   Data
 *   Helpers
+*   Map Render Cache
 *   Mappc Functions
 *   Map View Functions
 *   Screen Reader Functions
@@ -61,6 +62,32 @@ struct mappc_data_container {
 };
 
 
+// render cache for map tiles: see find_map_render_cache()
+#define MAP_RENDER_CACHE_SIZE  65536	// number of slots (tiles hash into these by vnum)
+#define MAP_RENDER_AFFS  (ROOM_AFF_NO_FLY)	// room affs that change a tile's own icon
+
+struct map_render_cache {
+	room_vnum vnum;	// which map tile is in this slot
+	int generation;	// only valid if it matches map_render_generation
+	
+	// these must match for the cached icon to be used
+	int tileset;	// TILESET_x
+	int north;	// which way the viewer sees as north (roads rotate)
+	sector_data *sect;
+	sector_data *base_sect;
+	crop_data *crop;
+	bld_data *bld;
+	bitvector_t affs;	// MAP_RENDER_AFFS only
+	
+	// the rendered tile
+	char color[30];	// base color (used to replace &?)
+	char icon[30];	// full icon with color codes, after @ codes were replaced
+};
+
+static struct map_render_cache map_render_cache[MAP_RENDER_CACHE_SIZE];
+static int map_render_generation = 1;	// starts at 1 so the empty table is invalid
+
+
 // external vars
 extern const int confused_dirs[NUM_2D_DIRS][2][NUM_OF_DIRS];
 extern const char *dirs[];
@@ -71,6 +98,8 @@ void replace_question_color(char *input, char *color, char *output);
 
 // locals
 ACMD(do_exits);
+static void build_map_tile_icon(char_data *ch, room_data *to_room, int tileset, struct icon_data *crop_icon, char *buf);
+static void replace_map_icon_codes(char_data *ch, room_data *to_room, int tileset, char *buf);
 static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc, room_data *to_room, bitvector_t options);
 
 
@@ -92,7 +121,7 @@ bool adjacent_room_is_light(room_data *room) {
 	}
 
 	for (i = 0; i < NUM_SIMPLE_DIRS; i++) {
-		to_room = real_shift(room, shift_dir[i][0], shift_dir[i][1]);
+		to_room = real_view_shift(room, shift_dir[i][0], shift_dir[i][1]);
 		if (to_room && IS_REAL_LIGHT(to_room)) {
 			return TRUE;
 		}
@@ -192,7 +221,7 @@ int get_map_radius(char_data *ch) {
 		// auto-detected
 		if (ch->desc && ch->desc->pProtocol->ScreenWidth > 0) {
 			int wide = (ch->desc->pProtocol->ScreenWidth - 6) / 8;	// the /8 is 4 chars per tile, doubled
-			int max_size = config_get_int("max_map_size");
+			int max_size = CONFIG_INT(CFG_MAX_MAP_SIZE);
 			if (ch->desc->pProtocol->ScreenHeight > 0) {
 				// cap based on height, too (save some room)
 				// this saves roughly 4 lines below the map -- if you're going
@@ -204,15 +233,15 @@ int get_map_radius(char_data *ch) {
 			mapsize = MIN(wide, max_size);
 		}
 		else {
-			mapsize = config_get_int("default_map_size");
+			mapsize = CONFIG_INT(CFG_DEFAULT_MAP_SIZE);
 		}
 	}
 	
 	// automatically limit size if the player is moving too fast
 	if (mapsize > 5 && (recent = count_recent_moves(ch)) > 5) {
-		max = config_get_int("max_map_size") - (recent - 5);
+		max = CONFIG_INT(CFG_MAX_MAP_SIZE) - (recent - 5);
 		mapsize = MIN(mapsize, max);
-		smallmax = config_get_int("max_map_while_moving");
+		smallmax = CONFIG_INT(CFG_MAX_MAP_WHILE_MOVING);
 		mapsize = MAX(mapsize, smallmax);
 	}
 	
@@ -310,8 +339,8 @@ char *get_room_name(room_data *room, bool color) {
 // determines which tileset to use for sector color
 int pick_season(room_data *room) {
 	int ycoord = Y_COORD(room);
-	double arctic = config_get_double("arctic_percent") / 200.0;	// split in half and convert from XX.XX to .XXXX (percent)
-	double tropics = config_get_double("tropics_percent") / 200.0;
+	double arctic = CONFIG_DOUBLE(CFG_ARCTIC_PERCENT) / 200.0;	// split in half and convert from XX.XX to .XXXX (percent)
+	double tropics = CONFIG_DOUBLE(CFG_TROPICS_PERCENT) / 200.0;
 	bool northern = (ycoord >= MAP_HEIGHT/2);
 	
 	// month 0 is january
@@ -350,6 +379,135 @@ int pick_season(room_data *room) {
 }
 
 
+ //////////////////////////////////////////////////////////////////////////////
+//// MAP RENDER CACHE ////////////////////////////////////////////////////////
+
+/**
+* Determines if a map tile's icon can be cached at all. Tiles whose icons
+* depend on the viewer (chameleon), or on data not tracked by the cache
+* (custom icons, cities, ruins), are always drawn fresh.
+*
+* @param room_data *room The map tile.
+* @return bool TRUE if the icon can be cached.
+*/
+static bool can_cache_map_tile(room_data *room) {
+	if (GET_ROOM_VNUM(room) >= MAP_SIZE) {
+		return FALSE;
+	}
+	if (ROOM_CUSTOM_ICON(room) || ROOM_AFF_FLAGGED(room, ROOM_AFF_CHAMELEON)) {
+		return FALSE;
+	}
+	if (IS_CITY_CENTER(room) || BUILDING_VNUM(room) == BUILDING_RUINS_CLOSED || BUILDING_VNUM(room) == BUILDING_RUINS_OPEN) {
+		return FALSE;
+	}
+	return TRUE;
+}
+
+
+/**
+* Invalidates every cached map icon, e.g. after sector, crop, or building
+* icons are edited.
+*/
+void clear_all_map_render_cache(void) {
+	++map_render_generation;
+}
+
+
+/**
+* Invalidates the cached map icon for a tile and the 8 tiles around it (roads
+* and barriers are drawn based on their neighbors). Anything that changes how
+* a map tile is drawn should call this.
+*
+* @param room_vnum vnum The map tile that changed (ignored if not on the map).
+*/
+void clear_map_render_cache(room_vnum vnum) {
+	struct map_render_cache *slot;
+	int x_off, y_off, to_x, to_y;
+	room_vnum to_vnum;
+	
+	if (vnum < 0 || vnum >= MAP_SIZE) {
+		return;
+	}
+	
+	for (x_off = -1; x_off <= 1; ++x_off) {
+		for (y_off = -1; y_off <= 1; ++y_off) {
+			if (get_coord_shift(MAP_X_COORD(vnum), MAP_Y_COORD(vnum), x_off, y_off, &to_x, &to_y)) {
+				to_vnum = (to_y * MAP_WIDTH) + to_x;
+				slot = &map_render_cache[to_vnum % MAP_RENDER_CACHE_SIZE];
+				if (slot->vnum == to_vnum) {
+					slot->generation = 0;
+				}
+			}
+		}
+	}
+}
+
+
+/**
+* Finds the cached icon for a map tile, if it's still valid.
+*
+* @param room_data *room The map tile to draw.
+* @param int tileset Which TILESET_x (season) is being drawn.
+* @param int north Which direction the viewer sees as north.
+* @return struct map_render_cache* The cache entry, or NULL if there is none.
+*/
+static struct map_render_cache *find_map_render_cache(room_data *room, int tileset, int north) {
+	struct map_render_cache *slot;
+	
+	if (!can_cache_map_tile(room)) {
+		return NULL;
+	}
+	
+	slot = &map_render_cache[GET_ROOM_VNUM(room) % MAP_RENDER_CACHE_SIZE];
+	if (slot->generation != map_render_generation || slot->vnum != GET_ROOM_VNUM(room)) {
+		return NULL;
+	}
+	if (slot->tileset != tileset || slot->north != north) {
+		return NULL;
+	}
+	if (slot->sect != SECT(room) || slot->base_sect != BASE_SECT(room) || slot->crop != ROOM_CROP(room) || slot->bld != GET_BUILDING(room)) {
+		return NULL;
+	}
+	if (slot->affs != (ROOM_AFF_FLAGS(room) & MAP_RENDER_AFFS)) {
+		return NULL;
+	}
+	
+	return slot;
+}
+
+
+/**
+* Stores a freshly-drawn map icon in the render cache, replacing whatever
+* tile was in that slot.
+*
+* @param room_data *room The map tile that was drawn.
+* @param int tileset Which TILESET_x (season) it was drawn with.
+* @param int north Which direction the viewer sees as north.
+* @param const char *color The base color of the tile.
+* @param const char *icon The full icon, after @ codes were replaced.
+*/
+static void store_map_render_cache(room_data *room, int tileset, int north, const char *color, const char *icon) {
+	struct map_render_cache *slot;
+	
+	if (!can_cache_map_tile(room) || strlen(color) >= sizeof(slot->color) || strlen(icon) >= sizeof(slot->icon)) {
+		return;
+	}
+	
+	slot = &map_render_cache[GET_ROOM_VNUM(room) % MAP_RENDER_CACHE_SIZE];
+	slot->vnum = GET_ROOM_VNUM(room);
+	slot->generation = map_render_generation;
+	slot->tileset = tileset;
+	slot->north = north;
+	slot->sect = SECT(room);
+	slot->base_sect = BASE_SECT(room);
+	slot->crop = ROOM_CROP(room);
+	slot->bld = GET_BUILDING(room);
+	slot->affs = ROOM_AFF_FLAGS(room) & MAP_RENDER_AFFS;
+	strcpy(slot->color, color);
+	strcpy(slot->icon, icon);
+}
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// MAPPC FUNCTIONS /////////////////////////////////////////////////////////
 
@@ -518,7 +676,7 @@ void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options) {
 	int level;
 	
 	// configs
-	int trench_initial_value = config_get_int("trench_initial_value");
+	int trench_initial_value = CONFIG_INT(CFG_TRENCH_INITIAL_VALUE);
 	
 	// options
 	bool ship_partial = IS_SET(options, LRR_SHIP_PARTIAL) ? TRUE : FALSE;
@@ -542,6 +700,9 @@ void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options) {
 		msg_to_char(ch, "You are beneath a building.\r\n");
 		return;
 	}
+	
+	// hold all output until the end, so the map goes out in a few large writes
+	start_output_builder(ch->desc);
 
 	// check for ship
 	if (!look_out && !ship_partial && show_on_ship) {
@@ -722,7 +883,7 @@ void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options) {
 					xx = (y_first ? second_iter : first_iter) * (invert_x ? -1 : 1);
 					yy = (y_first ? first_iter : second_iter) * (invert_y ? -1 : 1);
 				
-					to_room = real_shift(room, xx, yy);
+					to_room = real_view_shift(room, xx, yy);	// does not load unloaded map rooms
 				
 					if (!to_room) {
 						// nothing to show?
@@ -802,11 +963,13 @@ void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options) {
 	
 	// ship-partial ends here
 	if (ship_partial) {
+		flush_output_builder(ch->desc);
 		return;
 	}
 	
 	if (look_out) {
 		// nothing else to show on a look-out
+		flush_output_builder(ch->desc);
 		return;
 	}
 	
@@ -946,6 +1109,8 @@ void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options) {
 	if (COMPLEX_DATA(room) && ROOM_IS_CLOSED(room)) {
 		do_exits(ch, "", 0, GET_ROOM_VNUM(room));
 	}
+	
+	flush_output_builder(ch->desc);
 }
 
 
@@ -1049,7 +1214,7 @@ void look_in_direction(char_data *ch, int dir) {
 			return;
 		}
 
-		to_room = real_shift(IN_ROOM(ch), shift_dir[dir][0], shift_dir[dir][1]);
+		to_room = real_view_shift(IN_ROOM(ch), shift_dir[dir][0], shift_dir[dir][1]);
 
 		// blocked?
 		if (!to_room || ROOM_SECT_FLAGGED(to_room, SECTF_OBSCURE_VISION)) {
@@ -1103,7 +1268,7 @@ void look_in_direction(char_data *ch, int dir) {
 		}
 		
 		/* Shift, rinse, repeat */
-		to_room = real_shift(to_room, shift_dir[dir][0], shift_dir[dir][1]);
+		to_room = real_view_shift(to_room, shift_dir[dir][0], shift_dir[dir][1]);
 		if (to_room && !ROOM_SECT_FLAGGED(to_room, SECTF_OBSCURE_VISION) && !ROOM_IS_CLOSED(to_room)) {
 			if (CAN_SEE_IN_DARK_ROOM(ch, to_room)) {
 				for (c = ROOM_PEOPLE(to_room); c; c = c->next_in_room) {
@@ -1118,7 +1283,7 @@ void look_in_direction(char_data *ch, int dir) {
 				}
 			}
 			/* And a third time for good measure */
-			to_room = real_shift(to_room, shift_dir[dir][0], shift_dir[dir][1]);
+			to_room = real_view_shift(to_room, shift_dir[dir][0], shift_dir[dir][1]);
 			if (to_room && !ROOM_SECT_FLAGGED(to_room, SECTF_OBSCURE_VISION) && !ROOM_IS_CLOSED(to_room)) {
 				if (CAN_SEE_IN_DARK_ROOM(ch, to_room)) {
 					for (c = ROOM_PEOPLE(to_room); c; c = c->next_in_room) {
@@ -1154,82 +1319,43 @@ void look_in_direction(char_data *ch, int dir) {
 }
 
 /**
-* Shows one tile
+* Builds the basic icon for a map tile (buildings, roads, crops, sectors) and
+* appends it to buf. The result may still contain @ codes and &? colors. This
+* part of the icon is the same for every viewer with the same north, and it
+* is what gets stored in the map render cache.
 *
-* @param char_data *ch the viewer
-* @param struct mappc_data_container *mappc Players visible on the map are stored in this, to be shown below the map
-* @param room_data *to_room The room the character is looking at.
-* @param bitvector_t options Will recolor the tile if TRUE
+* @param char_data *ch The viewer (only used to rotate roads).
+* @param room_data *to_room The map tile to draw.
+* @param int tileset Which TILESET_x (season) to draw.
+* @param struct icon_data *crop_icon The crop icon, if the tile shows a crop.
+* @param char *buf The buffer to append to (30 chars).
 */
-static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc, room_data *to_room, bitvector_t options) {
+static void build_map_tile_icon(char_data *ch, room_data *to_room, int tileset, struct icon_data *crop_icon, char *buf) {
 	extern const char *closed_ruins_icons[NUM_RUINS_ICONS];
 	extern const char *open_ruins_icons[NUM_RUINS_ICONS];
 	extern int get_north_for_char(char_data *ch);
-	extern int get_direction_for_char(char_data *ch, int dir);
 	extern struct city_metadata_type city_type[];
 	
-	bool need_color_terminator = FALSE;
-	char buf[30], buf1[30], lbuf[MAX_STRING_LENGTH];
 	struct empire_city_data *city;
-	int iter;
-	empire_data *emp, *chemp = GET_LOYALTY(ch);
-	int tileset = pick_season(to_room);
-	struct icon_data *base_icon, *icon, *crop_icon = NULL;
-	bool junk, enchanted, hidden = FALSE;
+	struct icon_data *icon;
+	empire_data *emp;
 	crop_data *cp = ROOM_CROP(to_room);
-	sector_data *st, *base_sect = BASE_SECT(to_room);
-	char *base_color, *str;
-	room_data *map_loc = get_map_location_for(IN_ROOM(ch)), *map_to_room = get_map_location_for(to_room);
-	vehicle_data *show_veh;
+	sector_data *base_sect = BASE_SECT(to_room);
 	
-	// options
-	bool show_dark = IS_SET(options, LRR_SHOW_DARK) ? TRUE : FALSE;
-	// bool ship_partial = IS_SET(options, LRR_SHIP_PARTIAL) ? TRUE : FALSE;
-		
-	// adjacent rooms, shifted by map change
+	// adjacent rooms, shifted by map change (display-only: may be temporary rooms)
 	// WARNING: You must make sure these are not NULL when you try to use them
-	room_data *r_north = SHIFT_CHAR_DIR(ch, to_room, NORTH);
-	room_data *r_east = SHIFT_CHAR_DIR(ch, to_room, EAST);
-	room_data *r_south = SHIFT_CHAR_DIR(ch, to_room, SOUTH);
-	room_data *r_west = SHIFT_CHAR_DIR(ch, to_room, WEST);
-	room_data *r_northwest = SHIFT_CHAR_DIR(ch, to_room, NORTHWEST);
-	room_data *r_northeast = SHIFT_CHAR_DIR(ch, to_room, NORTHEAST);
-	room_data *r_southwest = SHIFT_CHAR_DIR(ch, to_room, SOUTHWEST);
-	room_data *r_southeast = SHIFT_CHAR_DIR(ch, to_room, SOUTHEAST);
-	
-	#define distance(x, y, a, b)		((x - a) * (x - a) + (y - b) * (y - b))
-
-	// detect base icon
-	base_icon = get_icon_from_set(GET_SECT_ICONS(base_sect), tileset);
-	base_color = base_icon->color;
-	if (ROOM_SECT_FLAGGED(to_room, SECTF_CROP) && cp) {
-		crop_icon = get_icon_from_set(GET_CROP_ICONS(cp), tileset);
-		base_color = crop_icon->color;
-	}
-
-	// start with the sector color
-	strcpy(buf, base_color);
-
-	if (to_room == IN_ROOM(ch) && !ROOM_IS_CLOSED(IN_ROOM(ch))) {
-		sprintf(buf, "&0<%soo&0>", chemp ? EMPIRE_BANNER(chemp) : "");
-	}
-	else if (!show_dark && !PRF_FLAGGED(ch, PRF_INFORMATIVE | PRF_POLITICAL) && show_pc_in_room(ch, to_room, mappc)) {
-		return;
-	}
+	room_data *r_north = VIEW_SHIFT_CHAR_DIR(ch, to_room, NORTH);
+	room_data *r_east = VIEW_SHIFT_CHAR_DIR(ch, to_room, EAST);
+	room_data *r_south = VIEW_SHIFT_CHAR_DIR(ch, to_room, SOUTH);
+	room_data *r_west = VIEW_SHIFT_CHAR_DIR(ch, to_room, WEST);
+	room_data *r_northwest = VIEW_SHIFT_CHAR_DIR(ch, to_room, NORTHWEST);
+	room_data *r_northeast = VIEW_SHIFT_CHAR_DIR(ch, to_room, NORTHEAST);
+	room_data *r_southwest = VIEW_SHIFT_CHAR_DIR(ch, to_room, SOUTHWEST);
+	room_data *r_southeast = VIEW_SHIFT_CHAR_DIR(ch, to_room, SOUTHEAST);
 	
-	// check for a vehicle with an icon
-	else if ((show_veh = find_vehicle_to_show(ch, to_room))) {
-		strcat(buf, NULLSAFE(VEH_ICON(show_veh)));
-	}
-
-	/* Hidden buildings */
-	else if (CHECK_CHAMELEON(map_loc, to_room)) {
-		strcat(buf, base_icon->icon);
-		hidden = TRUE;
-	}
-
 	/* Rooms with custom icons (take precedence over all but hidden rooms */
-	else if (ROOM_CUSTOM_ICON(to_room)) {
+
+	if (ROOM_CUSTOM_ICON(to_room)) {
 		strcat(buf, ROOM_CUSTOM_ICON(to_room));
 	}
 	else if (ANY_ROAD_TYPE(to_room)) {
@@ -1353,91 +1479,202 @@ static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc,
 		icon = get_icon_from_set(GET_SECT_ICONS(SECT(to_room)), tileset);
 		strcat(buf, icon->icon);
 	}
+}
+
+
+/**
+* Replaces the variable tile codes (@) in a map icon, which depend on the
+* tiles to either side of it.
+*
+* @param char_data *ch The viewer (only used to rotate the map).
+* @param room_data *to_room The map tile being drawn.
+* @param int tileset Which TILESET_x (season) to draw.
+* @param char *buf The icon to update (30 chars).
+*/
+static void replace_map_icon_codes(char_data *ch, room_data *to_room, int tileset, char *buf) {
+	extern int get_north_for_char(char_data *ch);
 	
-	// buf is now the completed icon, but has both color codes (&) and variable tile codes (@)
-	if (strchr(buf, '@')) {
-		// NOTE: If you add new @ codes here, you must update "const char *icon_codes" in utils.c
-		
-		// here (@.) roadside icon
-		if (strstr(buf, "@.")) {
-			icon = get_icon_from_set(GET_SECT_ICONS(base_sect), tileset);
-			sprintf(buf1, "%s%c", icon->color, GET_SECT_ROADSIDE_ICON(base_sect));
-			str = str_replace("@.", buf1, buf);
+	char buf1[30];
+	struct icon_data *icon;
+	sector_data *st, *base_sect = BASE_SECT(to_room);
+	bool enchanted;
+	char *str;
+	
+	// adjacent rooms, shifted by map change (display-only: may be temporary rooms)
+	// WARNING: You must make sure these are not NULL when you try to use them
+	room_data *r_east = VIEW_SHIFT_CHAR_DIR(ch, to_room, EAST);
+	room_data *r_west = VIEW_SHIFT_CHAR_DIR(ch, to_room, WEST);
+	
+
+	// NOTE: If you add new @ codes here, you must update "const char *icon_codes" in utils.c
+	
+	// here (@.) roadside icon
+	if (strstr(buf, "@.")) {
+		icon = get_icon_from_set(GET_SECT_ICONS(base_sect), tileset);
+		sprintf(buf1, "%s%c", icon->color, GET_SECT_ROADSIDE_ICON(base_sect));
+		str = str_replace("@.", buf1, buf);
+		strcpy(buf, str);
+		free(str);
+	}
+	// east (@e) tile attachment
+	if (strstr(buf, "@e")) {
+		st = r_east ? BASE_SECT(r_east) : BASE_SECT(to_room);
+		icon = get_icon_from_set(GET_SECT_ICONS(st), tileset);
+		sprintf(buf1, "%s%c", icon->color, GET_SECT_ROADSIDE_ICON(st));
+		str = str_replace("@e", buf1, buf);
+		strcpy(buf, str);
+		free(str);
+	}
+	// west (@w) tile attachment
+	if (strstr(buf, "@w")) {
+		st = r_west ? BASE_SECT(r_west) : BASE_SECT(to_room);
+		icon = get_icon_from_set(GET_SECT_ICONS(st), tileset);
+		sprintf(buf1, "%s%c", icon->color, GET_SECT_ROADSIDE_ICON(st));
+		str = str_replace("@w", buf1, buf);
+		strcpy(buf, str);
+		free(str);
+	}
+	
+	// west (@u) barrier attachment
+	if (strstr(buf, "@u") || strstr(buf, "@U")) {
+		if (!r_west || ((IS_BARRIER(r_west) || ROOM_IS_CLOSED(r_west)) && !ROOM_AFF_FLAGGED(r_west, ROOM_AFF_CHAMELEON))) {
+			enchanted = (r_west && ROOM_AFF_FLAGGED(r_west, ROOM_AFF_NO_FLY)) || ROOM_AFF_FLAGGED(to_room, ROOM_AFF_NO_FLY);
+			// west is a barrier
+			sprintf(buf1, "%sv", enchanted ? "&m" : "&0");
+			str = str_replace("@u", buf1, buf);
+			strcpy(buf, str);
+			free(str);
+			sprintf(buf1, "%sV", enchanted ? "&m" : "&0");
+			str = str_replace("@U", buf1, buf);
 			strcpy(buf, str);
 			free(str);
 		}
-		// east (@e) tile attachment
-		if (strstr(buf, "@e")) {
-			st = r_east ? BASE_SECT(r_east) : BASE_SECT(to_room);
-			icon = get_icon_from_set(GET_SECT_ICONS(st), tileset);
-			sprintf(buf1, "%s%c", icon->color, GET_SECT_ROADSIDE_ICON(st));
-			str = str_replace("@e", buf1, buf);
+		else {
+			// west is not a barrier
+			sprintf(buf1, "&?%c", GET_SECT_ROADSIDE_ICON(base_sect));
+			str = str_replace("@u", buf1, buf);
+			strcpy(buf, str);
+			free(str);
+			str = str_replace("@U", buf1, buf);
 			strcpy(buf, str);
 			free(str);
 		}
-		// west (@w) tile attachment
-		if (strstr(buf, "@w")) {
-			st = r_west ? BASE_SECT(r_west) : BASE_SECT(to_room);
-			icon = get_icon_from_set(GET_SECT_ICONS(st), tileset);
-			sprintf(buf1, "%s%c", icon->color, GET_SECT_ROADSIDE_ICON(st));
-			str = str_replace("@w", buf1, buf);
+	}
+	
+	//  east (@v) barrier attachment
+	if (strstr(buf, "@v") || strstr(buf, "@V")) {
+		if (!r_east || ((IS_BARRIER(r_east) || ROOM_IS_CLOSED(r_east)) && !ROOM_AFF_FLAGGED(r_east, ROOM_AFF_CHAMELEON))) {
+			enchanted = (r_east && ROOM_AFF_FLAGGED(r_east, ROOM_AFF_NO_FLY)) || ROOM_AFF_FLAGGED(to_room, ROOM_AFF_NO_FLY);
+			// east is a barrier
+			sprintf(buf1, "%sv", enchanted ? "&m" : "&0");
+			str = str_replace("@v", buf1, buf);
+			strcpy(buf, str);
+			free(str);
+			sprintf(buf1, "%sV", enchanted ? "&m" : "&0");
+			str = str_replace("@V", buf1, buf);
 			strcpy(buf, str);
 			free(str);
 		}
-		
-		// west (@u) barrier attachment
-		if (strstr(buf, "@u") || strstr(buf, "@U")) {
-			if (!r_west || ((IS_BARRIER(r_west) || ROOM_IS_CLOSED(r_west)) && !ROOM_AFF_FLAGGED(r_west, ROOM_AFF_CHAMELEON))) {
-				enchanted = (r_west && ROOM_AFF_FLAGGED(r_west, ROOM_AFF_NO_FLY)) || ROOM_AFF_FLAGGED(to_room, ROOM_AFF_NO_FLY);
-				// west is a barrier
-				sprintf(buf1, "%sv", enchanted ? "&m" : "&0");
-				str = str_replace("@u", buf1, buf);
-				strcpy(buf, str);
-				free(str);
-				sprintf(buf1, "%sV", enchanted ? "&m" : "&0");
-				str = str_replace("@U", buf1, buf);
-				strcpy(buf, str);
-				free(str);
-			}
-			else {
-				// west is not a barrier
-				sprintf(buf1, "&?%c", GET_SECT_ROADSIDE_ICON(base_sect));
-				str = str_replace("@u", buf1, buf);
-				strcpy(buf, str);
-				free(str);
-				str = str_replace("@U", buf1, buf);
-				strcpy(buf, str);
-				free(str);
-			}
+		else {
+			// east is not a barrier
+			sprintf(buf1, "&?%c", GET_SECT_ROADSIDE_ICON(base_sect));
+			str = str_replace("@v", buf1, buf);
+			strcpy(buf, str);
+			free(str);
+			str = str_replace("@V", buf1, buf);
+			strcpy(buf, str);
+			free(str);
 		}
-		
-		//  east (@v) barrier attachment
-		if (strstr(buf, "@v") || strstr(buf, "@V")) {
-			if (!r_east || ((IS_BARRIER(r_east) || ROOM_IS_CLOSED(r_east)) && !ROOM_AFF_FLAGGED(r_east, ROOM_AFF_CHAMELEON))) {
-				enchanted = (r_east && ROOM_AFF_FLAGGED(r_east, ROOM_AFF_NO_FLY)) || ROOM_AFF_FLAGGED(to_room, ROOM_AFF_NO_FLY);
-				// east is a barrier
-				sprintf(buf1, "%sv", enchanted ? "&m" : "&0");
-				str = str_replace("@v", buf1, buf);
-				strcpy(buf, str);
-				free(str);
-				sprintf(buf1, "%sV", enchanted ? "&m" : "&0");
-				str = str_replace("@V", buf1, buf);
-				strcpy(buf, str);
-				free(str);
-			}
-			else {
-				// east is not a barrier
-				sprintf(buf1, "&?%c", GET_SECT_ROADSIDE_ICON(base_sect));
-				str = str_replace("@v", buf1, buf);
-				strcpy(buf, str);
-				free(str);
-				str = str_replace("@V", buf1, buf);
-				strcpy(buf, str);
-				free(str);
-			}
+	}
+}
+
+
+/**
+* Shows one tile
+*
+* @param char_data *ch the viewer
+* @param struct mappc_data_container *mappc Players visible on the map are stored in this, to be shown below the map
+* @param room_data *to_room The room the character is looking at.
+* @param bitvector_t options Will recolor the tile if TRUE
+*/
+static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc, room_data *to_room, bitvector_t options) {
+	extern int get_north_for_char(char_data *ch);
+	
+	bool need_color_terminator = FALSE;
+	char buf[30], buf1[30], lbuf[MAX_STRING_LENGTH];
+	int iter;
+	empire_data *emp, *chemp = GET_LOYALTY(ch);
+	int tileset = pick_season(to_room);
+	int north = get_north_for_char(ch);
+	struct icon_data *base_icon = NULL, *crop_icon = NULL;
+	struct map_render_cache *cache;
+	bool junk, hidden = FALSE, from_cache = FALSE, cache_it = FALSE;
+	crop_data *cp = ROOM_CROP(to_room);
+	char *base_color, *str;
+	room_data *map_loc = get_map_location_for(IN_ROOM(ch)), *map_to_room = get_map_location_for(to_room);
+	vehicle_data *show_veh;
+	
+	// options
+	bool show_dark = IS_SET(options, LRR_SHOW_DARK) ? TRUE : FALSE;
+	// bool ship_partial = IS_SET(options, LRR_SHIP_PARTIAL) ? TRUE : FALSE;
+	
+	#define distance(x, y, a, b)		((x - a) * (x - a) + (y - b) * (y - b))
+
+	// detect base icon (the cache stores the color, so this is skipped when it's cached)
+	if ((cache = find_map_render_cache(to_room, tileset, north))) {
+		base_color = cache->color;
+	}
+	else {
+		base_icon = get_icon_from_set(GET_SECT_ICONS(BASE_SECT(to_room)), tileset);
+		base_color = base_icon->color;
+		if (ROOM_SECT_FLAGGED(to_room, SECTF_CROP) && cp) {
+			crop_icon = get_icon_from_set(GET_CROP_ICONS(cp), tileset);
+			base_color = crop_icon->color;
 		}
 	}
 
+	// start with the sector color
+	strcpy(buf, base_color);
+
+	if (to_room == IN_ROOM(ch) && !ROOM_IS_CLOSED(IN_ROOM(ch))) {
+		sprintf(buf, "&0<%soo&0>", chemp ? EMPIRE_BANNER(chemp) : "");
+	}
+	else if (!show_dark && !PRF_FLAGGED(ch, PRF_INFORMATIVE | PRF_POLITICAL) && show_pc_in_room(ch, to_room, mappc)) {
+		return;
+	}
+	
+	// check for a vehicle with an icon
+	else if ((show_veh = find_vehicle_to_show(ch, to_room))) {
+		strcat(buf, NULLSAFE(VEH_ICON(show_veh)));
+	}
+
+	/* Hidden buildings: never cached */
+	else if (CHECK_CHAMELEON(map_loc, to_room)) {
+		strcat(buf, base_icon->icon);
+		hidden = TRUE;
+	}
+	
+	// already rendered for this season/orientation
+	else if (cache) {
+		strcpy(buf, cache->icon);
+		from_cache = TRUE;
+	}
+	
+	// draw it fresh
+	else {
+		build_map_tile_icon(ch, to_room, tileset, crop_icon, buf);
+		cache_it = TRUE;
+	}
+	
+	// buf is now the completed icon, but has both color codes (&) and variable tile codes (@)
+	if (!from_cache && strchr(buf, '@')) {
+		replace_map_icon_codes(ch, to_room, tileset, buf);
+	}
+	if (cache_it) {
+		store_map_render_cache(to_room, tileset, north, base_color, buf);
+	}
+
+
 	// buf now contains the tile with preliminary color codes including &?
 
 	if (BUILDING_BURNING(to_room)) {
@@ -1624,7 +1861,7 @@ void screenread_one_dir(char_data *ch, room_data *origin, int dir) {
 	
 	mapsize = GET_MAPSIZE(REAL_CHAR(ch));
 	if (mapsize == 0) {
-		mapsize = config_get_int("default_map_size");
+		mapsize = CONFIG_INT(CFG_DEFAULT_MAP_SIZE);
 	}
 	
 	// constrain for brief
@@ -1639,7 +1876,7 @@ void screenread_one_dir(char_data *ch, room_data *origin, int dir) {
 
 	// show distance that direction		
 	for (dist_iter = 1; dist_iter <= mapsize; ++dist_iter) {
-		to_room = real_shift(origin, shift_dir[dir][0] * dist_iter, shift_dir[dir][1] * dist_iter);
+		to_room = real_view_shift(origin, shift_dir[dir][0] * dist_iter, shift_dir[dir][1] * dist_iter);
 		
 		if (!to_room) {
 			break;
@@ -34,6 +34,21 @@
 *   Mob Scaling
 */
 
+// MOB_TIER_x: how much attention mobile_activity() gives a mob on each pass
+#define MOB_TIER_ACTIVE  0	// within sight of a player (or pursuing one): every pass
+#define MOB_TIER_INSTANCE  1	// in an adventure instance a player is in: every pass
+#define MOB_TIER_DORMANT  2	// no players around: once every MOB_DORMANT_SLICES passes
+
+#define MOB_DORMANT_SLICES  6	// dormant mobs are split into this many groups, 1 group per pass
+
+
+// for mob activity tiers: where players are during this pass
+struct mob_activity_player {
+	int x, y;	// map location (or -1)
+	struct instance_data *inst;	// adventure instance they're in, if any
+};
+
+
 // external vars
 extern struct generic_name_data *generic_names;
 
@@ -570,16 +585,152 @@ bool try_mobile_movement(char_data *ch) {
 //// MOB ACTIVITY ////////////////////////////////////////////////////////////
 
 /**
-* Main cycle of mob activity (iterates over character list).
+* Builds the list of connected players' locations for get_mob_activity_tier().
+*
+* @param int *size A variable to store the number of entries in.
+* @return struct mob_activity_player* The array (caller must free it), or NULL if no players.
+*/
+static struct mob_activity_player *build_mob_activity_players(int *size) {
+	struct mob_activity_player *list = NULL;
+	descriptor_data *desc;
+	room_data *room;
+	int count = 0;
+	
+	for (desc = descriptor_list; desc; desc = desc->next) {
+		if (desc->character && IN_ROOM(desc->character)) {
+			++count;
+		}
+	}
+	
+	*size = 0;
+	if (count > 0) {
+		CREATE(list, struct mob_activity_player, count);
+		for (desc = descriptor_list; desc && *size < count; desc = desc->next) {
+			if (desc->character && (room = IN_ROOM(desc->character))) {
+				list[*size].x = X_COORD(room);
+				list[*size].y = Y_COORD(room);
+				list[*size].inst = IS_ADVENTURE_ROOM(room) ? ROOM_INSTANCE(room) : NULL;
+				++*size;
+			}
+		}
+	}
+	
+	return list;
+}
+
+
+/**
+* Checks one axis of a player's map view: whether 'pos' falls in the span of
+* tiles the map renderer could show around 'center'. The view is square, and
+* on a non-wrapping edge it slides inward instead of shrinking, so it can reach
+* up to twice the radius on the far side (see show_map_to_char).
+*
+* @param int pos The coordinate to check.
+* @param int center The player's coordinate on the same axis.
+* @param int radius The largest map radius a player can have.
+* @param int size The map's size on this axis.
+* @param bool wrap Whether the map wraps on this axis.
+* @return bool TRUE if pos could be on the player's map.
+*/
+static bool mob_activity_in_view(int pos, int center, int radius, int size, bool wrap) {
+	int diff, low;
+	
+	if (wrap) {
+		diff = ABSOLUTE(pos - center);
+		return (MIN(diff, size - diff) <= radius);
+	}
+	
+	low = center - radius;
+	if (low + 2 * radius > size - 1) {
+		low = size - 1 - 2 * radius;
+	}
+	low = MAX(0, low);
+	return (pos >= low && pos <= low + 2 * radius);
+}
+
+
+/**
+* Picks which of the MOB_DORMANT_SLICES groups a mob acts with while it's
+* dormant. This must not change from pass to pass, so it hashes the mob's
+* pointer (which is fixed for its lifetime) rather than using its script id,
+* which would use up mob ids on every mob that ever went dormant.
+*
+* @param char_data *mob The mob.
+* @return int Its slice, from 0 to MOB_DORMANT_SLICES-1.
+*/
+static int get_mob_dormant_slice(char_data *mob) {
+	unsigned int hash = (unsigned int) (((unsigned long) mob) >> 4) * 2654435761U;
+	return (hash >> 16) % MOB_DORMANT_SLICES;
+}
+
+
+/**
+* Determines how often a mob needs to act, based on whether any player could
+* see it. Mobs that are pursuing someone are always active.
+*
+* @param char_data *mob The mob.
+* @param struct mob_activity_player *players The player locations for this pass.
+* @param int num_players How many entries in players.
+* @return int A MOB_TIER_x const.
+*/
+static int get_mob_activity_tier(char_data *mob, struct mob_activity_player *players, int num_players) {
+	room_data *room = IN_ROOM(mob);
+	struct instance_data *inst;
+	int iter, x, y, radius;
+	
+	if (MOB_PURSUIT(mob) || MOB_PURSUIT_LEASH_LOC(mob) != NOWHERE) {
+		return MOB_TIER_ACTIVE;	// must keep up the chase (or go home)
+	}
+	if (num_players == 0) {
+		return MOB_TIER_DORMANT;
+	}
+	
+	// instances only need to be active if a player is inside
+	if (IS_ADVENTURE_ROOM(room) && (inst = ROOM_INSTANCE(room))) {
+		for (iter = 0; iter < num_players; ++iter) {
+			if (players[iter].inst == inst) {
+				return MOB_TIER_INSTANCE;
+			}
+		}
+		return MOB_TIER_DORMANT;
+	}
+	
+	// otherwise, is any player within sight range? (the map view is square)
+	x = X_COORD(room);
+	y = Y_COORD(room);
+	if (x < 0 || y < 0) {
+		return MOB_TIER_DORMANT;	// not on the map
+	}
+	radius = CONFIG_INT(CFG_MAX_MAP_SIZE);
+	for (iter = 0; iter < num_players; ++iter) {
+		if (players[iter].x < 0 || players[iter].y < 0) {
+			continue;
+		}
+		if (mob_activity_in_view(x, players[iter].x, radius, MAP_WIDTH, WRAP_X) && mob_activity_in_view(y, players[iter].y, radius, MAP_HEIGHT, WRAP_Y)) {
+			return MOB_TIER_ACTIVE;
+		}
+	}
+	
+	return MOB_TIER_DORMANT;
+}
+
+
+/**
+* Main cycle of mob activity (iterates over character list). Mobs near
+* players act every pass; mobs with nobody around are split into groups and
+* only one group acts per pass (see MOB_TIER_x).
 */
 void mobile_activity(void) {
 	extern bool catch_up_mobs;
 	
+	static int dormant_pass = 0;
+	
 	register char_data *ch, *next_ch, *vict, *targ, *m;
+	struct mob_activity_player *players;
 	struct track_data *track;
 	struct pursuit_data *purs, *next_purs, *temp;
 	obj_data *obj;
-	int found, dir = NO_DIR;
+	int found, dir = NO_DIR, num_players;
 	empire_data *chemp, *victemp;
 	bool moved;
 
@@ -590,6 +741,9 @@ void mobile_activity(void) {
 		return;
 	}
 	catch_up_mobs = FALSE;
+	
+	players = build_mob_activity_players(&num_players);
+	dormant_pass = (dormant_pass + 1) % MOB_DORMANT_SLICES;
 
 	for (ch = character_list; ch; ch = next_ch) {
 		next_ch = ch->next;
@@ -600,6 +754,11 @@ void mobile_activity(void) {
 		if (FIGHTING(ch) || !AWAKE(ch) || AFF_FLAGGED(ch, AFF_CHARM) || MOB_FLAGGED(ch, MOB_TIED) || IS_INJURED(ch, INJ_TIED) || GET_LED_BY(ch))
 			continue;
 		
+		// dormant mobs only act on their group's pass
+		if (get_mob_activity_tier(ch, players, num_players) == MOB_TIER_DORMANT && get_mob_dormant_slice(ch) != dormant_pass) {
+			continue;
+		}
+		
 		// found stops further execution
 		found = FALSE;
 		
@@ -614,7 +773,7 @@ void mobile_activity(void) {
 				next_purs = purs->next;
 				
 				// check pursuit timeout and distance
-				if (time(0) - purs->last_seen > config_get_int("mob_pursuit_timeout") * SECS_PER_REAL_MIN || compute_distance(IN_ROOM(ch), real_room(purs->location)) > config_get_int("mob_pursuit_distance")) {
+				if (time(0) - purs->last_seen > CONFIG_INT(CFG_MOB_PURSUIT_TIMEOUT) * SECS_PER_REAL_MIN || compute_distance(IN_ROOM(ch), real_room(purs->location)) > CONFIG_INT(CFG_MOB_PURSUIT_DISTANCE)) {
 					REMOVE_FROM_LIST(purs, MOB_PURSUIT(ch), next);
 					free(purs);
 				}
@@ -799,6 +958,10 @@ void mobile_activity(void) {
 
 		/* Add new mobile actions here */
 	}
+	
+	if (players) {
+		free(players);
+	}
 }
 
 
@@ -939,7 +1102,7 @@ static void spawn_one_room(room_data *room, bool only_artisans) {
 	crop_data *cp;
 	mob_vnum artisan = NOTHING;
 	
-	int time_to_empire_emptiness = config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK;
+	int time_to_empire_emptiness = CONFIG_INT(CFG_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK;
 	
 	// safety first
 	if (!room) {
@@ -983,7 +1146,7 @@ static void spawn_one_room(room_data *room, bool only_artisans) {
 	}
 	
 	// normal spawn list
-	if (!only_artisans && count < config_get_int("spawn_limit_per_room")) {
+	if (!only_artisans && count < CONFIG_INT(CFG_SPAWN_LIMIT_PER_ROOM)) {
 		// find a spawn list
 		list = NULL;
 		if (GET_BUILDING(room)) {
@@ -1078,8 +1241,8 @@ void spawn_mobs_from_center(room_data *center) {
 	room_data *to_room;
 	time_t now = time(0);
 	
-	int mob_spawn_interval = config_get_int("mob_spawn_interval") * SECS_PER_REAL_MIN;
-	int mob_spawn_radius = config_get_int("mob_spawn_radius");
+	int mob_spawn_interval = CONFIG_INT(CFG_MOB_SPAWN_INTERVAL) * SECS_PER_REAL_MIN;
+	int mob_spawn_radius = CONFIG_INT(CFG_MOB_SPAWN_RADIUS);
 	
 	// always start on the map
 	center = get_map_location_for(center);
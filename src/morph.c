@@ -535,14 +535,18 @@ void add_morph_to_table(morph_data *morph) {
 		HASH_FIND_INT(morph_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(morph_table, vnum, morph);
-			HASH_SORT(morph_table, sort_morphs);
+			if (!defer_table_sorts) {
+				HASH_SORT(morph_table, sort_morphs);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_morphs, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_morphs, vnum, sizeof(int), morph);
-			HASH_SRT(sorted_hh, sorted_morphs, sort_morphs_by_data);
+			if (!defer_table_sorts) {
+				HASH_SRT(sorted_hh, sorted_morphs, sort_morphs_by_data);
+			}
 		}
 	}
 }
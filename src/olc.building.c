@@ -556,6 +556,7 @@ void save_olc_building(descriptor_data *desc) {
 	if (GET_BLD_ICON(proto)) {
 		free(GET_BLD_ICON(proto));
 	}
+	clear_all_map_render_cache();	// icon may have changed
 	if (GET_BLD_COMMANDS(proto)) {
 		free(GET_BLD_COMMANDS(proto));
 	}
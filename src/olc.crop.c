@@ -322,6 +322,7 @@ void save_olc_crop(descriptor_data *desc) {
 	
 	// free prototype strings and pointers
 	free_icon_set(&GET_CROP_ICONS(proto));
+	clear_all_map_render_cache();	// icons may have changed
 	if (GET_CROP_NAME(proto)) {
 		free(GET_CROP_NAME(proto));
 	}
@@ -123,10 +123,11 @@ OLC_MODULE(mapedit_decay) {
 OLC_MODULE(mapedit_terrain) {
 	extern crop_data *get_crop_by_name(char *name);
 	extern sector_data *get_sect_by_name(char *name);
+	extern struct city_metadata_type city_type[];
 	
 	struct empire_city_data *city, *temp;
 	empire_data *emp;
-	int count;
+	int count, radius;
 	sector_data *sect, *next_sect, *old_sect = NULL;
 	crop_data *crop, *next_crop;
 	crop_data *cp;
@@ -158,11 +159,14 @@ OLC_MODULE(mapedit_terrain) {
 
 		// delete city center?
 		if (IS_CITY_CENTER(IN_ROOM(ch)) && emp && (city = find_city_entry(emp, IN_ROOM(ch)))) {
+			radius = city_type[city->type].radius;
+			update_city_area_territory(emp, IN_ROOM(ch), radius, FALSE);
 			REMOVE_FROM_LIST(city, EMPIRE_CITY_LIST(emp), next);
 			if (city->name) {
 				free(city->name);
 			}
 			free(city);
+			update_city_area_territory(emp, IN_ROOM(ch), radius, TRUE);
 			save_empire(emp);
 		}
 		
@@ -496,6 +500,8 @@ OLC_MODULE(mapedit_delete_exit) {
 
 
 OLC_MODULE(mapedit_naturalize) {
+	void stats_adjust_crop_count(crop_data *cp, int amount);
+	
 	bool island = FALSE, world = FALSE;
 	int count, island_id = NO_ISLAND;
 	struct island_info *isle;
@@ -565,6 +571,7 @@ OLC_MODULE(mapedit_naturalize) {
 					set_crop_type(room, get_potential_crop_for_location(room));
 				}
 				else {
+					stats_adjust_crop_count(map->crop_type, -1);
 					map->crop_type = NULL;
 				}
 			}
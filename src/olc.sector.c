@@ -407,6 +407,7 @@ void save_olc_sector(descriptor_data *desc) {
 	
 	// free prototype strings and pointers
 	free_icon_set(&GET_SECT_ICONS(proto));
+	clear_all_map_render_cache();	// icons may have changed
 	if (GET_SECT_NAME(proto)) {
 		free(GET_SECT_NAME(proto));
 	}
@@ -62,23 +62,28 @@ static void InfoMessage(descriptor_t *apDescriptor, const char *apData) {
 }
 
 static void CompressStart(descriptor_t *apDescriptor) {
-	/* If your mud uses MCCP (Mud Client Compression Protocol), you need to 
-	* call whatever function normally starts compression from here - the 
-	* ReportBug() call should then be deleted.
-	* 
-	* Otherwise you can just ignore this function.
-	*/
-	ReportBug("CompressStart() in protocol.c is being called, but it doesn't do anything!\n");
+	/* Starts MCCP2 output compression (see comm.c) */
+	#ifdef USING_MCCP
+		if (!start_mccp_output(apDescriptor)) {
+			apDescriptor->pProtocol->bMCCP = false;
+		}
+	#else
+		ReportBug("CompressStart() in protocol.c is being called, but MCCP was not compiled in!\n");
+	#endif
 }
 
 static void CompressEnd(descriptor_t *apDescriptor) {
-	/* If your mud uses MCCP (Mud Client Compression Protocol), you need to 
-	* call whatever function normally starts compression from here - the 
-	* ReportBug() call should then be deleted.
-	* 
-	* Otherwise you can just ignore this function.
-	*/
-	ReportBug("CompressEnd() in protocol.c is being called, but it doesn't do anything!\n");
+	/* Finishes MCCP2 output compression (see comm.c) */
+	#ifdef USING_MCCP
+		end_mccp_output(apDescriptor);
+	#endif
+}
+
+static void CompressInputEnd(descriptor_t *apDescriptor) {
+	/* Stops decompressing MCCP3 input (see comm.c) */
+	#ifdef USING_MCCP
+		end_mccp_input(apDescriptor);
+	#endif
 }
 
 /******************************************************************************
@@ -475,6 +480,7 @@ protocol_t *ProtocolCreate(void) {
 	pProtocol->bMSP = false;
 	pProtocol->bMXP = false;
 	pProtocol->bMCCP = false;
+	pProtocol->bMCCP3 = false;
 	pProtocol->b256Support = eUNKNOWN;
 	pProtocol->ScreenWidth = 0;
 	pProtocol->ScreenHeight = 0;
@@ -1222,6 +1228,12 @@ const char *CopyoverGet(descriptor_t *apDescriptor) {
 			*pBuffer++ = 'S';
 		if (pProtocol->pVariables[eMSDP_MXP]->ValueInt)
 			*pBuffer++ = 'X';
+		if (pProtocol->bMCCP3) {
+			/* Input compression can't survive the copyover, so ask the client to stop. */
+			static const char NoMCCP3[] = { (char)IAC, (char)WONT, TELOPT_MCCP3, '\0' };
+			write_to_client(apDescriptor, NoMCCP3);
+			CompressInputEnd(apDescriptor);
+		}
 		if (pProtocol->bMCCP) {
 			*pBuffer++ = 'c';
 			CompressEnd(apDescriptor);
@@ -1736,6 +1748,7 @@ static void Negotiate(descriptor_t *apDescriptor) {
 		ConfirmNegotiation(apDescriptor, eNEGOTIATED_MSP, true, true);
 		ConfirmNegotiation(apDescriptor, eNEGOTIATED_MXP, true, true);
 		ConfirmNegotiation(apDescriptor, eNEGOTIATED_MCCP, true, true);
+		ConfirmNegotiation(apDescriptor, eNEGOTIATED_MCCP3, true, true);
 	}
 }
 
@@ -1904,6 +1917,27 @@ static void PerformHandshake(descriptor_t *apDescriptor, char aCmd, char aProtoc
 			break;
 		}
 
+		case (char)TELOPT_MCCP3: {
+			if (aCmd == (char)DO) {
+				/* The client may now send IAC SB MCCP3 IAC SE and compress the rest. */
+				ConfirmNegotiation(apDescriptor, eNEGOTIATED_MCCP3, true, true);
+				pProtocol->bMCCP3 = true;
+			}
+			else if (aCmd == (char)DONT) {
+				ConfirmNegotiation(apDescriptor, eNEGOTIATED_MCCP3, false, pProtocol->bMCCP3);
+
+				if (pProtocol->bMCCP3) {
+					pProtocol->bMCCP3 = false;
+					CompressInputEnd(apDescriptor);
+				}
+			}
+			else if (aCmd == (char)WILL) {
+				/* Invalid negotiation, send a rejection */
+				SendNegotiationSequence(apDescriptor, (char)DONT, (char)aProtocol);
+			}
+			break;
+		}
+
 		case (char)TELOPT_MSP: {
 			if (aCmd == (char)DO) {
 				ConfirmNegotiation(apDescriptor, eNEGOTIATED_MSP, true, true);
@@ -2244,6 +2278,11 @@ static bool_t ConfirmNegotiation(descriptor_t *apDescriptor, negotiated_t aProto
 							SendNegotiationSequence(apDescriptor, (char) (abWillDo ? WILL : WONT), TELOPT_MCCP);
 						#endif /* USING_MCCP */
 						break;
+					case eNEGOTIATED_MCCP3:
+						#ifdef USING_MCCP
+							SendNegotiationSequence(apDescriptor, (char) (abWillDo ? WILL : WONT), TELOPT_MCCP3);
+						#endif /* USING_MCCP */
+						break;
 					default: {
 						bResult = false;
 						break;
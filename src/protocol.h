@@ -37,10 +37,12 @@ typedef struct descriptor_data descriptor_t;
 
 
 /******************************************************************************
- If your mud supports MCCP (compression), uncomment the next line.
+ MCCP (compression) is supported whenever configure found zlib.
  *****************************************************************************/
 
-// #define USING_MCCP
+#if defined(HAVE_ZLIB_H) && defined(HAVE_LIBZ)
+	#define USING_MCCP
+#endif
 
 
 /******************************************************************************
@@ -69,6 +71,7 @@ typedef struct descriptor_data descriptor_t;
 #define TELOPT_MSDP  69
 #define TELOPT_MSSP  70
 #define TELOPT_MCCP  86	// This is MCCP version 2
+#define TELOPT_MCCP3  87	// MCCP version 3 (client-to-server compression)
 #define TELOPT_MSP  90
 #define TELOPT_MXP  91
 #define TELOPT_ATCP  200
@@ -109,6 +112,7 @@ typedef enum {
 	eNEGOTIATED_MXP, 
 	eNEGOTIATED_MXP2, 
 	eNEGOTIATED_MCCP, 
+	eNEGOTIATED_MCCP3, 
 	
 	eNEGOTIATED_MAX	// This must always be last
 } negotiated_t;
@@ -278,6 +282,7 @@ typedef struct {
 	bool_t bMSP;	// The client supports MSP
 	bool_t bMXP;	// The client supports MXP
 	bool_t bMCCP;	// The client supports MCCP
+	bool_t bMCCP3;	// The client supports MCCP3 (may compress its input)
 	support_t b256Support;	// The client supports XTerm 256 colors
 	int ScreenWidth;	// The client's screen width
 	int ScreenHeight;	// The client's screen height
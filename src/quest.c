@@ -195,14 +195,14 @@ void copy_quest_progress(struct req_data *to_list, struct req_data *from_list) {
 * @return int The number of completed buildings with that vnum, owned by emp.
 */
 int count_owned_buildings(empire_data *emp, bld_vnum vnum) {
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	int count = 0;	// ah ah ah
 	
 	if (!emp || vnum == NOTHING) {
 		return count;
 	}
 	
-	LL_FOREACH(EMPIRE_TERRITORY_LIST(emp), ter) {
+	HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, next_ter) {
 		if (!IS_COMPLETE(ter->room) || !GET_BUILDING(ter->room)) {
 			continue;
 		}
@@ -226,6 +226,7 @@ int count_owned_buildings(empire_data *emp, bld_vnum vnum) {
 * @return int The number of completed vehicles with that vnum, owned by emp.
 */
 int count_owned_vehicles(empire_data *emp, any_vnum vnum) {
+	struct empire_vehicle_index *vidx;
 	vehicle_data *veh;
 	int count = 0;
 	
@@ -233,16 +234,15 @@ int count_owned_vehicles(empire_data *emp, any_vnum vnum) {
 		return count;
 	}
 	
-	LL_FOREACH(vehicle_list, veh) {
-		if (!VEH_IS_COMPLETE(veh) || VEH_OWNER(veh) != emp) {
-			continue;
-		}
-		if (VEH_VNUM(veh) != vnum) {
-			continue;
+	HASH_FIND_INT(EMPIRE_VEHICLE_INDEX(emp), &vnum, vidx);
+	if (!vidx) {
+		return count;
+	}
+	
+	DL_FOREACH2(vidx->vehicles, veh, next_owned) {
+		if (VEH_IS_COMPLETE(veh)) {
+			++count;
 		}
-		
-		// found
-		++count;
 	}
 	
 	return count;
@@ -2674,7 +2674,9 @@ void add_quest_to_table(quest_data *quest) {
 		HASH_FIND_INT(quest_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(quest_table, vnum, quest);
-			HASH_SORT(quest_table, sort_quests);
+			if (!defer_table_sorts) {
+				HASH_SORT(quest_table, sort_quests);
+			}
 		}
 	}
 }
@@ -2490,14 +2490,18 @@ void add_skill_to_table(skill_data *skill) {
 		HASH_FIND_INT(skill_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(skill_table, vnum, skill);
-			HASH_SORT(skill_table, sort_skills);
+			if (!defer_table_sorts) {
+				HASH_SORT(skill_table, sort_skills);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_skills, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_skills, vnum, sizeof(int), skill);
-			HASH_SRT(sorted_hh, sorted_skills, sort_skills_by_data);
+			if (!defer_table_sorts) {
+				HASH_SRT(sorted_hh, sorted_skills, sort_skills_by_data);
+			}
 		}
 	}
 }
@@ -224,7 +224,7 @@ void olc_search_social(char_data *ch, any_vnum vnum) {
 
 
 // Simple vnum sorter for the socials hash
-int sort_socials(social_data *a, social_data *b) {
+int sort_socials_by_vnum(social_data *a, social_data *b) {
 	return SOC_VNUM(a) - SOC_VNUM(b);
 }
 
@@ -252,6 +252,32 @@ int sort_socials_by_data(social_data *a, social_data *b) {
 }
 
 
+/**
+* Sorts sorted_socials alphabetically and rebuilds social_index, the array
+* version of it that find_social() binary-searches. This must be called any
+* time a social is added, removed, or renamed.
+*/
+void sort_socials(void) {
+	social_data *soc, *next_soc;
+	int count = 0;
+	
+	HASH_SRT(sorted_hh, sorted_socials, sort_socials_by_data);
+	
+	if (social_index) {
+		free(social_index);
+		social_index = NULL;
+	}
+	
+	social_index_size = HASH_CNT(sorted_hh, sorted_socials);
+	if (social_index_size > 0) {
+		CREATE(social_index, social_data*, social_index_size);
+		HASH_ITER(sorted_hh, sorted_socials, soc, next_soc) {
+			social_index[count++] = soc;
+		}
+	}
+}
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// DATABASE ////////////////////////////////////////////////////////////////
 
@@ -269,14 +295,18 @@ void add_social_to_table(social_data *soc) {
 		HASH_FIND_INT(social_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(social_table, vnum, soc);
-			HASH_SORT(social_table, sort_socials);
+			if (!defer_table_sorts) {
+				HASH_SORT(social_table, sort_socials_by_vnum);
+			}
 		}
 		
 		// sorted table
 		HASH_FIND(sorted_hh, sorted_socials, &vnum, sizeof(int), find);
 		if (!find) {
 			HASH_ADD(sorted_hh, sorted_socials, vnum, sizeof(int), soc);
-			HASH_SRT(sorted_hh, sorted_socials, sort_socials_by_data);
+			if (!defer_table_sorts) {
+				sort_socials();
+			}
 		}
 	}
 }
@@ -290,6 +320,7 @@ void add_social_to_table(social_data *soc) {
 void remove_social_from_table(social_data *soc) {
 	HASH_DEL(social_table, soc);
 	HASH_DELETE(sorted_hh, sorted_socials, soc);
+	sort_socials();	// rebuilds social_index without it
 }
 
 
@@ -613,7 +644,7 @@ void save_olc_social(descriptor_data *desc) {
 	save_library_file_for_vnum(DB_BOOT_SOC, vnum);
 
 	// ... and re-sort
-	HASH_SRT(sorted_hh, sorted_socials, sort_socials_by_data);
+	sort_socials();
 }
 
 
@@ -39,15 +39,12 @@ struct stats_data_struct {
 	UT_hash_handle hh;	// hashable
 };
 
-// stats globals
-struct stats_data_struct *global_sector_count = NULL;	// hash table of sector counts
-int global_sector_size = 0;
-struct stats_data_struct *global_crop_count = NULL;	// hash table count of crops
-int global_crop_size = 0;
-struct stats_data_struct *global_building_count = NULL;	// hash table of building counts
-int global_building_size = 0;
-
-time_t last_world_count = 0;	// timestamp of last sector/crop/building tally
+// stats globals: these are counted at startup and then updated live by
+// perform_change_sect(), set_crop_type(), and attach/detach_building_to_room()
+struct stats_data_struct *global_sector_count = NULL;	// hash table of sector counts (map tiles)
+struct stats_data_struct *global_crop_count = NULL;	// hash table count of crops (map tiles)
+struct stats_data_struct *global_building_count = NULL;	// hash table of building counts (map tiles)
+
 time_t last_account_count = 0;	// timestamp of last time accounts were read
 
 int total_accounts = 0;	// including inactive
@@ -63,7 +60,7 @@ int max_players_this_uptime = 0;
 
 
 // locals
-void update_world_count();
+int update_world_count(bool verify);
 
 
  //////////////////////////////////////////////////////////////////////////////
@@ -233,10 +230,6 @@ int stats_get_building_count(bld_data *bdg) {
 		return 0;
 	}
 	
-	if (HASH_COUNT(global_building_count) != global_building_size || last_world_count + rescan_world_after < time(0)) {
-		update_world_count();
-	}
-	
 	vnum = GET_BLD_VNUM(bdg);
 	HASH_FIND_INT(global_building_count, &vnum, data);
 	return data ? data->count : 0;
@@ -255,10 +248,6 @@ int stats_get_crop_count(crop_data *cp) {
 		return 0;
 	}
 	
-	if (HASH_COUNT(global_crop_count) != global_crop_size || last_world_count + rescan_world_after < time(0)) {
-		update_world_count();
-	}
-	
 	vnum = GET_CROP_VNUM(cp);
 	HASH_FIND_INT(global_crop_count, &vnum, data);
 	
@@ -278,10 +267,6 @@ int stats_get_sector_count(sector_data *sect) {
 		return 0;
 	}
 	
-	if (HASH_COUNT(global_sector_count) != global_sector_size || last_world_count + rescan_world_after < time(0)) {
-		update_world_count();
-	}
-	
 	vnum = GET_SECT_VNUM(sect);
 	HASH_FIND_INT(global_sector_count, &vnum, data);
 	
@@ -394,84 +379,160 @@ void update_players_online_stats(void) {
 //// WORLD STATS /////////////////////////////////////////////////////////////
 
 /**
-* Updates global_sector_count, global_crop_count, global_building_count.
+* Adds to (or subtracts from) one entry in a world stats hash.
+*
+* @param struct stats_data_struct **hash Which global hash to update.
+* @param any_vnum vnum Which sector/crop/building vnum.
+* @param int amount How much to add (may be negative).
 */
-void update_world_count(void) {
-	struct stats_data_struct *sect_inf = NULL, *crop_inf = NULL, *bld_inf = NULL, *data, *next_data;
-	any_vnum vnum, last_bld_vnum = NOTHING, last_crop_vnum = NOTHING, last_sect_vnum = NOTHING;
-	struct map_data *map;
-	room_data *room;
+static void adjust_stats_count(struct stats_data_struct **hash, any_vnum vnum, int amount) {
+	struct stats_data_struct *data;
 	
-	// free and recreate counts
-	HASH_ITER(hh, global_sector_count, data, next_data) {
-		HASH_DEL(global_sector_count, data);
-		free(data);
+	HASH_FIND_INT(*hash, &vnum, data);
+	if (!data) {
+		CREATE(data, struct stats_data_struct, 1);
+		data->vnum = vnum;
+		HASH_ADD_INT(*hash, vnum, data);
 	}
-	HASH_ITER(hh, global_crop_count, data, next_data) {
-		HASH_DEL(global_crop_count, data);
-		free(data);
+	data->count += amount;
+}
+
+
+/**
+* Updates the live building count when a building is added to or removed
+* from a map tile.
+*
+* @param bld_data *bdg The building type (NULL does nothing).
+* @param int amount How many to add (negative to remove).
+*/
+void stats_adjust_building_count(bld_data *bdg, int amount) {
+	if (bdg) {
+		adjust_stats_count(&global_building_count, GET_BLD_VNUM(bdg), amount);
+	}
+}
+
+
+/**
+* Updates the live crop count when a map tile's crop changes.
+*
+* @param crop_data *cp The crop type (NULL does nothing).
+* @param int amount How many to add (negative to remove).
+*/
+void stats_adjust_crop_count(crop_data *cp, int amount) {
+	if (cp) {
+		adjust_stats_count(&global_crop_count, GET_CROP_VNUM(cp), amount);
+	}
+}
+
+
+/**
+* Updates the live sector count when a map tile's sector changes.
+*
+* @param sector_data *sect The sector type (NULL does nothing).
+* @param int amount How many to add (negative to remove).
+*/
+void stats_adjust_sector_count(sector_data *sect, int amount) {
+	if (sect) {
+		adjust_stats_count(&global_sector_count, GET_SECT_VNUM(sect), amount);
+	}
+}
+
+
+/**
+* Compares one freshly-counted stats hash to the live one and logs any
+* differences.
+*
+* @param struct stats_data_struct *live The live (incremental) counts.
+* @param struct stats_data_struct *fresh The counts from a full scan.
+* @param const char *type "sector", "crop", or "building" for the log.
+* @return int The number of mismatched entries.
+*/
+static int verify_stats_counts(struct stats_data_struct *live, struct stats_data_struct *fresh, const char *type) {
+	struct stats_data_struct *data, *next_data, *find;
+	int errors = 0;
+	
+	HASH_ITER(hh, fresh, data, next_data) {
+		HASH_FIND_INT(live, &data->vnum, find);
+		if ((find ? find->count : 0) != data->count) {
+			log("SYSERR: update_world_count: %s %d has live count %d but world has %d", type, data->vnum, find ? find->count : 0, data->count);
+			++errors;
+		}
+	}
+	HASH_ITER(hh, live, data, next_data) {
+		HASH_FIND_INT(fresh, &data->vnum, find);
+		if (!find && data->count != 0) {
+			log("SYSERR: update_world_count: %s %d has live count %d but world has 0", type, data->vnum, data->count);
+			++errors;
+		}
 	}
-	HASH_ITER(hh, global_building_count, data, next_data) {
-		HASH_DEL(global_building_count, data);
+	
+	return errors;
+}
+
+
+/**
+* Frees a world stats hash.
+*
+* @param struct stats_data_struct **hash The hash to free.
+*/
+static void free_stats_counts(struct stats_data_struct **hash) {
+	struct stats_data_struct *data, *next_data;
+	
+	HASH_ITER(hh, *hash, data, next_data) {
+		HASH_DEL(*hash, data);
 		free(data);
 	}
+}
+
+
+/**
+* Counts every map tile's sector, crop, and building from scratch and
+* replaces global_sector_count, global_crop_count, and global_building_count.
+* This runs once at startup; after that, the counts are kept up to date
+* whenever tiles change, and this is only needed to check them.
+*
+* @param bool verify If TRUE, logs any difference between the live counts and the fresh ones before replacing them.
+* @return int The number of mismatches found (always 0 if not verifying).
+*/
+int update_world_count(bool verify) {
+	struct stats_data_struct *sect_cnt = NULL, *crop_cnt = NULL, *bld_cnt = NULL;
+	room_data *room, *next_room;
+	struct map_data *map;
+	int x, y, errors = 0;
 	
-	// scan world
-	for (map = land_map; map; map = map->next) {
-		// sector
-		vnum = GET_SECT_VNUM(map->sector_type);
-		if (vnum != last_sect_vnum || !sect_inf) {
-			HASH_FIND_INT(global_sector_count, &vnum, sect_inf);
-			if (!sect_inf) {
-				CREATE(sect_inf, struct stats_data_struct, 1);
-				sect_inf->vnum = vnum;
-				HASH_ADD_INT(global_sector_count, vnum, sect_inf);
+	// scan the map for sectors and crops
+	for (x = 0; x < MAP_WIDTH; ++x) {
+		for (y = 0; y < MAP_HEIGHT; ++y) {
+			map = &(world_map[x][y]);
+			if (map->sector_type) {
+				adjust_stats_count(&sect_cnt, GET_SECT_VNUM(map->sector_type), 1);
 			}
-			last_sect_vnum = vnum;
-		}
-		++sect_inf->count;
-		
-		// crop
-		if (map->crop_type) {
-			vnum = GET_CROP_VNUM(map->crop_type);
-			
-			if (vnum != last_crop_vnum || !crop_inf) {
-				HASH_FIND_INT(global_crop_count, &vnum, crop_inf);
-				if (!crop_inf) {
-					CREATE(crop_inf, struct stats_data_struct, 1);
-					crop_inf->vnum = vnum;
-					HASH_ADD_INT(global_crop_count, vnum, crop_inf);
-				}
-				last_crop_vnum = vnum;
+			if (map->crop_type) {
+				adjust_stats_count(&crop_cnt, GET_CROP_VNUM(map->crop_type), 1);
 			}
-			
-			++crop_inf->count;
 		}
-		
-		// any further data?
-		if (!(room = real_real_room(map->vnum))) {
-			continue;
-		}
-		
-		// building?
-		vnum = BUILDING_VNUM(room);
-		if (vnum != NOTHING) {
-			if (vnum != last_bld_vnum) {
-				HASH_FIND_INT(global_building_count, &vnum, bld_inf);
-				if (!bld_inf) {
-					CREATE(bld_inf, struct stats_data_struct, 1);
-					bld_inf->vnum = vnum;
-					HASH_ADD_INT(global_building_count, vnum, bld_inf);
-				}
-				last_bld_vnum = vnum;
-			}
-			
-			++bld_inf->count;
+	}
+	
+	// buildings are only on loaded rooms
+	HASH_ITER(hh, world_table, room, next_room) {
+		if (GET_ROOM_VNUM(room) < MAP_SIZE && GET_BUILDING(room)) {
+			adjust_stats_count(&bld_cnt, GET_BLD_VNUM(GET_BUILDING(room)), 1);
 		}
 	}
 	
-	last_world_count = time(0);
-	global_sector_size = HASH_COUNT(global_sector_count);
-	global_crop_size = HASH_COUNT(global_crop_count);
-	global_building_size = HASH_COUNT(global_building_count);
+	if (verify) {
+		errors += verify_stats_counts(global_sector_count, sect_cnt, "sector");
+		errors += verify_stats_counts(global_crop_count, crop_cnt, "crop");
+		errors += verify_stats_counts(global_building_count, bld_cnt, "building");
+	}
+	
+	// replace
+	free_stats_counts(&global_sector_count);
+	free_stats_counts(&global_crop_count);
+	free_stats_counts(&global_building_count);
+	global_sector_count = sect_cnt;
+	global_crop_count = crop_cnt;
+	global_building_count = bld_cnt;
+	
+	return errors;
 }
@@ -753,6 +753,233 @@ typedef struct vehicle_data vehicle_data;
 #define NUM_ROLES  7
 
 
+ //////////////////////////////////////////////////////////////////////////////
+//// CONFIG DEFINES //////////////////////////////////////////////////////////
+
+// CFG_x: typed handles to configs, used with CONFIG_INT() etc (utils.h)
+// NOTE: each one needs an entry in config_handle_list[] in config.c
+
+// approval
+#define CFG_AUTO_APPROVE  0
+#define CFG_APPROVE_PER_CHARACTER  1
+#define CFG_NEED_APPROVAL_STRING  2
+#define CFG_BUILD_APPROVAL  3
+#define CFG_CHAT_APPROVAL  4
+#define CFG_CRAFT_APPROVAL  5
+#define CFG_GATHER_APPROVAL  6
+#define CFG_JOIN_EMPIRE_APPROVAL  7
+#define CFG_MANAGE_EMPIRE_APPROVAL  8
+#define CFG_QUEST_APPROVAL  9
+#define CFG_SKILL_GAIN_APPROVAL  10
+#define CFG_TELL_APPROVAL  11
+#define CFG_TERRAFORM_APPROVAL  12
+#define CFG_TITLE_APPROVAL  13
+#define CFG_TRAVEL_APPROVAL  14
+#define CFG_WRITE_APPROVAL  15
+
+// game configs
+#define CFG_ALLOW_EXTENDED_COLOR_CODES  16
+#define CFG_HIRING_BUILDERS  17
+#define CFG_HIRING_CODERS  18
+#define CFG_MUD_CONTACT  19
+#define CFG_MUD_CREATED  20
+#define CFG_MUD_HOSTNAME  21
+#define CFG_MUD_ICON  22
+#define CFG_MUD_IP  23
+#define CFG_MUD_LOCATION  24
+#define CFG_MUD_MINIMUM_AGE  25
+#define CFG_MUD_NAME  26
+#define CFG_MUD_STATUS  27
+#define CFG_MUD_WEBSITE  28
+#define CFG_NEWYEAR_MESSAGE  29
+#define CFG_STARTING_YEAR  30
+#define CFG_WELCOME_MESSAGE  31
+#define CFG_OK_STRING  32
+#define CFG_NO_PERSON  33
+#define CFG_HUH_STRING  34
+#define CFG_PUBLIC_LOGINS  35
+
+// actions
+#define CFG_CHORE_DISTANCE  36
+#define CFG_CHIP_TIMER  37
+#define CFG_CHOP_TIMER  38
+#define CFG_DIG_BASE_TIMER  39
+#define CFG_FISHING_TIMER  40
+#define CFG_GATHER_BASE_TIMER  41
+#define CFG_HARVEST_TIMER  42
+#define CFG_MINING_TIMER  43
+#define CFG_PANNING_TIMER  44
+#define CFG_PICK_BASE_TIMER  45
+#define CFG_PLANTING_BASE_TIMER  46
+#define CFG_TAN_TIMER  47
+#define CFG_CHOP_DEPLETION  48
+#define CFG_COMMON_DEPLETION  49
+#define CFG_GARDEN_DEPLETION  50
+#define CFG_GATHER_DEPLETION  51
+#define CFG_PICK_DEPLETION  52
+#define CFG_SHORT_DEPLETION  53
+#define CFG_HIGH_DEPLETION  54
+#define CFG_SHEAR_GROWTH_TIME  55
+#define CFG_TAVERN_BREW_TIME  56
+#define CFG_TAVERN_TIMER  57
+#define CFG_TRENCH_INITIAL_VALUE  58
+#define CFG_TRENCH_GAIN_FROM_RAIN  59
+#define CFG_TRENCH_FULL_VALUE  60
+#define CFG_MAX_CHORE_RESOURCE  61
+#define CFG_MAX_CHORE_RESOURCE_OVER_TOTAL  62
+#define CFG_MAX_CHORE_RESOURCE_SKILLED  63
+
+// cities
+#define CFG_PLAYERS_PER_CITY_POINT  64
+#define CFG_BONUS_CITY_POINT_WEALTH  65
+#define CFG_BONUS_CITY_POINT_TECHS  66
+#define CFG_MIN_DISTANCE_BETWEEN_CITIES  67
+#define CFG_MIN_DISTANCE_BETWEEN_ALLY_CITIES  68
+#define CFG_MIN_DISTANCE_FROM_CITY_TO_STARTING_LOCATION  69
+#define CFG_CITIES_ON_NEWBIE_ISLANDS  70
+#define CFG_CITY_TRAIT_RADIUS  71
+#define CFG_DISREPAIR_MINOR  72
+#define CFG_DISREPAIR_MAJOR  73
+#define CFG_DISREPAIR_LIMIT  74
+#define CFG_DISREPAIR_LIMIT_UNFINISHED  75
+#define CFG_MAX_OUT_OF_CITY_PORTAL  76
+#define CFG_MINUTES_TO_FULL_CITY  77
+
+// empire
+#define CFG_LAND_PER_GREATNESS  78
+#define CFG_LAND_PER_TECH  79
+#define CFG_LAND_PER_WEALTH  80
+#define CFG_LAND_OUTSIDE_CITY_MODIFIER  81
+#define CFG_BUILDING_POPULATION_TIMER  82
+#define CFG_TIME_TO_EMPIRE_DELETE  83
+#define CFG_TIME_TO_EMPIRE_EMPTINESS  84
+#define CFG_MEMBER_TIMEOUT_NEWBIE  85
+#define CFG_MINUTES_PER_DAY_NEWBIE  86
+#define CFG_MEMBER_TIMEOUT_FULL  87
+#define CFG_MINUTES_PER_DAY_FULL  88
+#define CFG_MEMBER_TIMEOUT_MAX_THRESHOLD  89
+#define CFG_NEWBIE_ISLAND_DAY_LIMIT  90
+#define CFG_WHOLE_EMPIRE_TIMEOUT  91
+#define CFG_EMPIRE_LOG_TTL  92
+#define CFG_REDESIGNATE_TIME  93
+
+// items
+#define CFG_AUTO_UPDATE_ITEMS  94
+#define CFG_AUTOSTORE_TIME  95
+#define CFG_BOUND_ITEM_JUNK_TIME  96
+#define CFG_LONG_AUTOSTORE_TIME  97
+#define CFG_ROOM_ITEM_LIMIT  98
+#define CFG_SCALE_POINTS_AT_100  99
+#define CFG_SCALE_FOOD_FULLNESS  100
+#define CFG_SCALE_DRINK_CAPACITY  101
+#define CFG_SCALE_COIN_AMOUNT  102
+#define CFG_SCALE_PACK_SIZE  103
+
+// mobs
+#define CFG_MAX_NPC_ATTRIBUTE  104
+#define CFG_MOB_SPAWN_INTERVAL  105
+#define CFG_MOB_SPAWN_RADIUS  106
+#define CFG_MOB_DESPAWN_RADIUS  107
+#define CFG_NPC_FOLLOWER_LIMIT  108
+#define CFG_NUM_DUPLICATES_IN_STABLE  109
+#define CFG_SPAWN_LIMIT_PER_ROOM  110
+#define CFG_MOB_PURSUIT_TIMEOUT  111
+#define CFG_MOB_PURSUIT_DISTANCE  112
+#define CFG_USE_MOB_STACKING  113
+
+// other
+#define CFG_TEST_CONFIG  114
+
+// players
+#define CFG_DAILIES_PER_DAY  115
+#define CFG_DEFAULT_CLASS_ABBREV  116
+#define CFG_DEFAULT_CLASS_NAME  117
+#define CFG_DELETE_INACTIVE_PLAYERS_AFTER  118
+#define CFG_DELETE_INVALID_PLAYERS_AFTER  119
+#define CFG_EXP_LEVEL_DIFFERENCE  120
+#define CFG_POOL_BONUS_AMOUNT  121
+#define CFG_NUM_DAILY_SKILL_POINTS  122
+#define CFG_NUM_BONUS_TRAIT_DAILY_SKILLS  123
+#define CFG_IDLE_RENT_TIME  124
+#define CFG_IDLE_LINKDEAD_RENT_TIME  125
+#define CFG_MAX_CAPITALS_IN_NAME  126
+#define CFG_MAX_PLAYER_ATTRIBUTE  127
+#define CFG_MAX_SLEEPING_REGEN_TIME  128
+#define CFG_REMOVE_LORE_AFTER_YEARS  129
+#define CFG_DEFAULT_MAP_SIZE  130
+#define CFG_MAX_MAP_SIZE  131
+#define CFG_MAX_MAP_WHILE_MOVING  132
+#define CFG_BLOOD_STARVATION_LEVEL  133
+#define CFG_OFFER_TIME  134
+
+// skills
+#define CFG_EXP_FROM_WORKFORCE  135
+#define CFG_MORPH_TIMER  136
+#define CFG_TRACKS_LIFESPAN  137
+#define CFG_GREATER_ENCHANTMENTS_BONUS  138
+#define CFG_ENCHANT_POINTS_AT_100  139
+#define CFG_MIN_EXP_TO_ROLL_SKILLUP  140
+#define CFG_MUST_BE_VAMPIRE  141
+#define CFG_POTION_HEAL_SCALE  142
+#define CFG_POTION_APPLY_PER_100  143
+#define CFG_SKILL_SWAP_ALLOWED  144
+#define CFG_SKILL_SWAP_MIN_LEVEL  145
+#define CFG_SUMMON_NPC_LIMIT  146
+
+// system
+#define CFG_NAMESERVER_IS_SLOW  147
+#define CFG_MAX_FILESIZE  148
+#define CFG_MAX_BAD_PWS  149
+#define CFG_MCCP_COMPRESSION_LEVEL  150
+#define CFG_USE_AUTOWIZ  151
+#define CFG_SITEOK_EVERYONE  152
+#define CFG_LOG_LOSING_DESCRIPTOR_WITHOUT_CHAR  153
+
+// trade
+#define CFG_IMPORTS_PER_DAY  154
+#define CFG_TRADING_POST_MAX_HOURS  155
+#define CFG_TRADING_POST_DAYS_TO_TIMEOUT  156
+#define CFG_TRADING_POST_FEE  157
+
+// war
+#define CFG_FIRE_EXTINGUISH_VALUE  158
+#define CFG_PVP_TIMER  159
+#define CFG_STOLEN_OBJECT_TIMER  160
+#define CFG_HOSTILE_FLAG_TIME  161
+#define CFG_DEATH_RELEASE_MINUTES  162
+#define CFG_DEATHS_BEFORE_PENALTY  163
+#define CFG_DEATHS_BEFORE_PENALTY_WAR  164
+#define CFG_HOSTILE_LOGIN_DELAY  165
+#define CFG_MUTUAL_WAR_ONLY  166
+#define CFG_ROGUE_FLAG_TIME  167
+#define CFG_SECONDS_PER_DEATH  168
+#define CFG_STUN_IMMUNITY_TIME  169
+#define CFG_VEHICLE_SIEGE_TIME  170
+#define CFG_WAR_COST_MAX  171
+#define CFG_WAR_COST_MIN  172
+#define CFG_WAR_LOGIN_DELAY  173
+
+// world
+#define CFG_DEFAULT_INTERIOR  174
+#define CFG_WATER_CROP_DISTANCE  175
+#define CFG_NATURALIZE_NEWBIE_ISLANDS  176
+#define CFG_NATURALIZE_UNCLAIMABLE  177
+#define CFG_NEARBY_SECTOR_DISTANCE  178
+#define CFG_INTERLINK_DISTANCE  179
+#define CFG_INTERLINK_RIVER_LIMIT  180
+#define CFG_INTERLINK_MOUNTAIN_LIMIT  181
+#define CFG_GENERIC_FACING  182
+#define CFG_NEWBIE_ADVENTURE_CAP  183
+#define CFG_ARCTIC_PERCENT  184
+#define CFG_TROPICS_PERCENT  185
+#define CFG_OCEAN_POOL_SIZE  186
+#define CFG_DEFAULT_BUILDING_SECT  187
+#define CFG_DEFAULT_INSIDE_SECT  188
+#define CFG_DEFAULT_ADVENTURE_SECT  189
+
+#define NUM_CONFIG_HANDLES  190
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// CRAFT DEFINES ///////////////////////////////////////////////////////////
 
@@ -1051,12 +1278,14 @@ typedef struct vehicle_data vehicle_data;
 #define PASSES_PER_SEC  (1000000 / OPT_USEC)
 #define RL_SEC  * PASSES_PER_SEC
 #define SEC_MICRO  *1000000	// convert seconds to microseconds for microtime()
+#define EVO_USEC_PER_PULSE  5000	// most time map evolutions may take in one pulse (see update_map_evolutions)
 
 
 // Variables for the output buffering system
 #define MAX_SOCK_BUF  (24 * 1024)	// Size of kernel's sock buf
 #define MAX_PROMPT_LENGTH  275	// Max length of rendered prompt
 #define GARBAGE_SPACE  32	// Space for **OVERFLOW** etc
+#define OUTPUT_BUILDER_CHUNK  2048	// text sent to write_to_output() at a time when flushing an output builder (leaves room for color codes to expand)
 #define SMALL_BUFSIZE  8192	// Static output buffer size
 // Max amount of output that can be buffered
 #define LARGE_BUFSIZE  (MAX_SOCK_BUF - GARBAGE_SPACE - MAX_PROMPT_LENGTH)
@@ -2087,6 +2316,7 @@ typedef struct vehicle_data vehicle_data;
 #define MAX_STRING_LENGTH  8192
 #define MAX_TITLE_LENGTH  100
 #define MAX_TITLE_LENGTH_NO_COLOR  80	// title limit without color codes (less than MAX_TITLE_LENGTH)
+#define MAX_TRACKS_PER_ROOM  20	// oldest tracks in a room are overwritten past this
 #define NUM_ACTION_VNUMS  3	// action vnums 0, 1, 2
 #define NUM_OBJ_VAL_POSITIONS  3	// GET_OBJ_VAL(obj, X) -- caution: changing this will require you to change the .obj file format
 #define NUM_GLB_VAL_POSITIONS  3	// GET_GLOBAL_VAL(glb, X) -- caution: changing this will require you to change the .glb file format
@@ -2747,6 +2977,24 @@ struct bld_data {
 };
 
 
+// for iteration of live rooms by building type
+struct building_index_type {
+	bld_vnum vnum;	// which building
+	
+	struct building_index_room *rooms;	// hash of rooms with this building
+	int count;	// how many rooms in the hash
+	
+	UT_hash_handle hh;	// building_index hash handle
+};
+
+
+// one entry in a building_index_type
+struct building_index_room {
+	room_data *room;	// the room (hash key)
+	UT_hash_handle hh;	// building_index_type->rooms hash handle
+};
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// CLASS STRUCTS ///////////////////////////////////////////////////////////
 
@@ -2900,6 +3148,7 @@ struct player_index_data {
 	empire_data *loyalty;	// empire, if any
 	int rank;	// empire rank
 	char *last_host;	// last known host
+	int greatness;	// total greatness as of the last time they were in-game (-1 if unknown)
 	
 	UT_hash_handle idnum_hh;	// player_table_by_idnum
 	UT_hash_handle name_hh;	// player_table_by_name
@@ -2953,6 +3202,14 @@ struct descriptor_data {
 	int showstr_page;	// which page are we currently showing?
 	
 	protocol_t *pProtocol; // see protocol.c
+	struct z_stream_s *mccp_out;	// MCCP2 output compression, if the client asked for it
+	char *mccp_pending;	// output waiting on a full socket once MCCP is involved (see write_to_client)
+	size_t mccp_pending_len, mccp_pending_size;	// bytes used/allocated in mccp_pending
+	struct z_stream_s *mccp_in;	// MCCP3 input decompression, if the client started it
+	char *mccp_inbuf;	// raw input for mccp_in (MAX_PROTOCOL_BUFFER)
+	size_t mccp_inbuf_len;	// plain input left in mccp_inbuf after the client's stream ended
+	char mccp_marker[4];	// start of an IAC SB MCCP3 IAC SE that was split across reads
+	int mccp_marker_len;	// bytes held in mccp_marker
 	struct color_reducer color;
 	bool no_nanny;	// skips interpreting player input if only a telnet negotiation sequence was sent
 	
@@ -2979,6 +3236,11 @@ struct descriptor_data {
 	bool data_left_to_write;	// indicates there is more data to write, to prevent an extra crlf
 	struct txt_block *large_outbuf;	// ptr to large buffer, if we need it
 	struct txt_q input;	// q of unprocessed input
+	
+	char *output_builder;	// output held by start_output_builder() until it's flushed
+	size_t output_builder_len;	// length of the text in output_builder
+	size_t output_builder_size;	// allocated size of output_builder
+	int output_builder_depth;	// start_output_builder() calls not yet flushed
 
 	char_data *character;	// linked to char
 	char_data *original;	// original char if switched
@@ -3618,6 +3880,10 @@ struct empire_island {
 	int city_terr;	// total territory IN cities on the island
 	int outside_terr;	// total territory OUTSIDE cities on the island
 	
+	// storage (saved with the empire's storage file)
+	struct empire_storage_data *store;	// hash of stored items by vnum
+	int store_total;	// total amount of all items in 'store'
+	
 	UT_hash_handle hh;	// EMPIRE_ISLANDS(emp) hash handle
 };
 
@@ -3658,16 +3924,17 @@ struct empire_political_data {
 
 /* The storage structure for empires */
 struct empire_storage_data {
-	obj_vnum vnum;	// what's stored
+	obj_vnum vnum;	// what's stored (hash key)
 	int amount;	// how much
 	int island;	// which island it's stored on
 
-	struct empire_storage_data *next;
+	UT_hash_handle hh;	// empire_island->store hash handle
 };
 
 
 // list of rooms and buildings owned
 struct empire_territory_data {
+	room_vnum vnum;	// hash key: the room's vnum
 	room_data *room;	// pointer to territory location
 	int population_timer;	// time to re-populate
 	
@@ -3675,7 +3942,7 @@ struct empire_territory_data {
 	
 	bool marked;	// for checking that rooms still exist
 	
-	struct empire_territory_data *next;	// linked list
+	UT_hash_handle hh;	// EMPIRE_TERRITORY_LIST hash (iterates in the order added)
 };
 
 
@@ -3701,6 +3968,17 @@ struct empire_unique_storage {
 };
 
 
+// for iterating an empire's vehicles without scanning vehicle_list
+struct empire_vehicle_index {
+	any_vnum vnum;	// which vehicle type (hash key)
+	
+	vehicle_data *vehicles;	// DL list of owned vehicles of this vnum (veh->next_owned)
+	int count;	// how many in the list
+	
+	UT_hash_handle hh;	// EMPIRE_VEHICLE_INDEX(emp) hash handle
+};
+
+
 // for the ewt system: island entry
 struct empire_workforce_tracker_island {
 	int id;
@@ -3744,15 +4022,15 @@ struct empire_data {
 	// linked lists
 	struct empire_political_data *diplomacy;
 	struct shipping_data *shipping_list;
-	struct empire_storage_data *store;
 	struct empire_unique_storage *unique_store;	// LL: eus->next
 	struct empire_trade_data *trade;
 	struct empire_log_data *logs;
 	
 	// unsaved data
-	struct empire_territory_data *territory_list;	// linked list of buildings/rooms
+	struct empire_territory_data *territory_list;	// hash of buildings/rooms by vnum
 	struct empire_city_data *city_list;	// linked list of cities
 	struct empire_workforce_tracker *ewt_tracker;	// workforce tracker
+	struct empire_vehicle_index *vehicle_index;	// hash by vnum of owned vehicles, maintained by set_vehicle_owner()
 	
 	// unsaved data
 	int city_terr;	// total territory IN cities
@@ -3778,6 +4056,9 @@ struct empire_data {
 	bool banner_has_underline;	// helper
 	
 	bool needs_save;	// for things that delay-save
+	char *journal;	// pending journal lines, appended to the journal file by save_marked_empires()
+	size_t journal_size;	// strlen of journal
+	int journal_entries;	// lines in the journal file since the last full save
 	
 	UT_hash_handle hh;	// empire_table hash handle
 };
@@ -3864,6 +4145,17 @@ struct message_list {
  //////////////////////////////////////////////////////////////////////////////
 //// GAME STRUCTS ////////////////////////////////////////////////////////////
 
+// data storage for the config system (see config.c)
+union config_data_union {
+	bitvector_t bitvector_val;
+	bool bool_val;
+	double double_val;
+	int int_val;
+	int *int_array;
+	char *string_val;
+};
+
+
 // For reboots/shutdowns
 struct reboot_control_data {
 	int type;	// SCMD_REBOOT, SCMD_SHUTDOWN
@@ -4108,6 +4400,8 @@ struct sector_index_type {
 	struct map_data *base_rooms;	// LL of rooms
 	int base_count;	// number of rooms with it as the base sect
 	
+	unsigned char *chunk_count;	// number of map tiles with this sect in each chunk (see SECT_CHUNK_SIZE), or NULL if none yet
+	
 	UT_hash_handle hh;	// sector_index hash handle
 };
 
@@ -4185,6 +4479,7 @@ struct vehicle_data {
 	// lists
 	struct vehicle_data *next;	// vehicle_list (global) linked list
 	struct vehicle_data *next_in_room;	// ROOM_VEHICLES(room) linked list
+	struct vehicle_data *prev_owned, *next_owned;	// empire's vehicle_index list (set_vehicle_owner)
 	UT_hash_handle hh;	// vehicle_table hash handle
 };
 
@@ -254,6 +254,14 @@ struct in_addr {
 # include <sys/uio.h>
 #endif
 
+#ifdef HAVE_SYS_EPOLL_H
+# include <sys/epoll.h>
+#endif
+
+#ifdef HAVE_ZLIB_H
+# include <zlib.h>
+#endif
+
 #endif /* __COMM_C__ && EMPIRE_UTIL */
 
 
@@ -267,6 +275,30 @@ struct in_addr {
 #endif /* __ACT_OTHER_C__ */
 
 
+/* Header files that are only used in db.player.c */
+#ifdef __DB_PLAYER_C__
+
+#ifdef HAVE_SYS_STAT_H
+# include <sys/stat.h>
+#endif
+
+#endif /* __DB_PLAYER_C__ */
+
+
+/* Header files that are only used in db.world.c */
+#ifdef __DB_WORLD_C__
+
+#ifdef HAVE_SYS_STAT_H
+# include <sys/stat.h>
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+# include <sys/mman.h>
+#endif
+
+#endif /* __DB_WORLD_C__ */
+
+
 /* Basic system dependencies *******************************************/
 
 #if !defined(__GNUC__)
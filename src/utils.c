@@ -471,8 +471,8 @@ void score_empires(void) {
 	extern const double score_levels[];
 	
 	int iter, pos, total[NUM_SCORES], max[NUM_SCORES], num_emps = 0;
+	struct empire_island *isle, *next_isle;
 	struct empire_political_data *pol;
-	struct empire_storage_data *store;
 	empire_data *emp, *next_emp;
 	long long num;
 	
@@ -522,8 +522,8 @@ void score_empires(void) {
 		EMPIRE_SCORE(emp, SCORE_TECHS) = num;
 		
 		num = 0;
-		for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-			num += store->amount;
+		HASH_ITER(hh, EMPIRE_ISLANDS(emp), isle, next_isle) {
+			num += isle->store_total;
 		}
 		num /= 1000;	// for sanity of number size
 		total[SCORE_EINV] += num;
@@ -1491,7 +1491,13 @@ void log_to_empire(empire_data *emp, int type, const char *str, ...) {
 			EMPIRE_LOGS(emp) = elog;
 		}
 		
-		EMPIRE_NEEDS_SAVE(emp) = TRUE;
+		// journal it unless it won't fit on one line (or the journal isn't safe to use yet)
+		if (emp->storage_loaded && !strchr(elog->string, '\n') && !strchr(elog->string, '\r')) {
+			add_to_empire_journal(emp, "L %d %ld %s\n", elog->type, (long) elog->timestamp, elog->string);
+		}
+		else {
+			EMPIRE_NEEDS_SAVE(emp) = TRUE;
+		}
 	}
 	
 	// show to players
@@ -4215,22 +4221,15 @@ int compute_map_distance(int x1, int y1, int x2, int y2) {
 * @return int The number of matching adjacent tiles.
 */
 int count_adjacent_sectors(room_data *room, sector_vnum sect, bool count_original_sect) {
-	sector_data *rl_sect = sector_proto(sect);
-	int iter, count = 0;
-	room_data *to_room;
-	
-	// we only care about its map room
-	room = HOME_ROOM(room);
+	room_data *map;
 	
-	for (iter = 0; iter < NUM_2D_DIRS; ++iter) {
-		to_room = real_shift(room, shift_dir[iter][0], shift_dir[iter][1]);
-		
-		if (to_room && (SECT(to_room) == rl_sect || (count_original_sect && BASE_SECT(to_room) == rl_sect))) {
-			++count;
-		}
+	// we only care about its map room (the world_map has the same sectors, without loading any rooms)
+	map = get_map_location_for(HOME_ROOM(room));
+	if (!map || GET_ROOM_VNUM(map) >= MAP_SIZE) {
+		return 0;
 	}
 	
-	return count;
+	return count_adjacent_map_sectors(&(world_map[FLAT_X_COORD(map)][FLAT_Y_COORD(map)]), sect, count_original_sect);
 }
 
 
@@ -4358,7 +4357,7 @@ room_data *get_map_location_for(room_data *room) {
 room_data *find_load_room(char_data *ch) {
 	extern room_data *find_starting_location();
 	
-	struct empire_territory_data *ter;
+	struct empire_territory_data *ter, *next_ter;
 	room_data *rl, *rl_last_room, *found = NULL;
 	int num_found = 0;
 	sh_int island;
@@ -4375,7 +4374,7 @@ room_data *find_load_room(char_data *ch) {
 	// first: look for graveyard
 	if (!IS_NPC(ch) && (rl = real_room(GET_LAST_ROOM(ch))) && GET_LOYALTY(ch)) {
 		island = GET_ISLAND_ID(rl);
-		for (ter = EMPIRE_TERRITORY_LIST(GET_LOYALTY(ch)); ter; ter = ter->next) {
+		HASH_ITER(hh, EMPIRE_TERRITORY_LIST(GET_LOYALTY(ch)), ter, next_ter) {
 			if (room_has_function_and_city_ok(ter->room, FNC_TOMB) && IS_COMPLETE(ter->room) && GET_ISLAND_ID(ter->room) == island && !BUILDING_BURNING(ter->room)) {
 				// pick at random if more than 1
 				if (!number(0, num_found++) || !found) {
@@ -4476,25 +4475,12 @@ bool find_sect_within_distance_from_char(char_data *ch, sector_vnum sect, int di
 */
 bool find_sect_within_distance_from_room(room_data *room, sector_vnum sect, int distance) {
 	room_data *real = get_map_location_for(room);
-	sector_data *find = sector_proto(sect);
-	bool found = FALSE;
-	room_data *shift;
-	int x, y;
 	
-	if (!real) {	// no map location
+	if (!real || GET_ROOM_VNUM(real) >= MAP_SIZE) {	// no map location
 		return FALSE;
 	}
 	
-	for (x = -1 * distance; x <= distance && !found; ++x) {
-		for (y = -1 * distance; y <= distance && !found; ++y) {
-			shift = real_shift(real, x, y);
-			if (shift && SECT(shift) == find && compute_distance(real, shift) <= distance) {
-				found = TRUE;
-			}
-		}
-	}
-	
-	return found;
+	return map_sect_within_distance(&(world_map[FLAT_X_COORD(real)][FLAT_Y_COORD(real)]), sect, distance);
 }
 
 
@@ -4749,6 +4735,39 @@ room_data *real_shift(room_data *origin, int x_shift, int y_shift) {
 }
 
 
+/**
+* Like real_shift(), but for display only: map tiles that aren't in memory
+* are NOT loaded. You may get a temporary room back (see real_view_room), so
+* never modify or store the result.
+*
+* @param room_data *origin The start location
+* @param int x_shift How far to move east/west
+* @param int y_shift How far to move north/south
+* @return room_data* The location on the map (maybe temporary), or NULL if the location would be off the map
+*/
+room_data *real_view_shift(room_data *origin, int x_shift, int y_shift) {
+	int x_coord, y_coord;
+	room_data *map;
+	
+	// sanity?
+	if (!origin) {
+		return NULL;
+	}
+	
+	map = get_map_location_for(origin);
+	
+	// are we somehow not on the map? if not, don't shift
+	if (!map || GET_ROOM_VNUM(map) >= MAP_SIZE) {
+		return NULL;
+	}
+	
+	if (get_coord_shift(FLAT_X_COORD(map), FLAT_Y_COORD(map), x_shift, y_shift, &x_coord, &y_coord)) {
+		return real_view_room((y_coord * MAP_WIDTH) + x_coord);
+	}
+	return NULL;
+}
+
+
 /**
 * Removes all players from a room.
 *
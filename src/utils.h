@@ -382,6 +382,17 @@ extern int GET_MAX_BLOOD(char_data *ch);	// this one is different than the other
 #define CLASS_FLAGGED(cls, flag)  IS_SET(CLASS_FLAGS(cls), (flag))
 
 
+ //////////////////////////////////////////////////////////////////////////////
+//// CONFIG UTILS ////////////////////////////////////////////////////////////
+
+// fast, typed access to configs by CFG_x handle (see config_get_int() etc for string keys)
+#define CONFIG_BITVECTOR(cfg)  (config_handles[(cfg)]->bitvector_val)
+#define CONFIG_BOOL(cfg)  (config_handles[(cfg)]->bool_val)
+#define CONFIG_DOUBLE(cfg)  (config_handles[(cfg)]->double_val)
+#define CONFIG_INT(cfg)  (config_handles[(cfg)]->int_val)
+#define CONFIG_STRING(cfg)  (config_handles[(cfg)]->string_val ? config_handles[(cfg)]->string_val : "")
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// CRAFT UTILS /////////////////////////////////////////////////////////////
 
@@ -476,7 +487,6 @@ extern int GET_MAX_BLOOD(char_data *ch);	// this one is different than the other
 #define EMPIRE_PRIV(emp, num)  ((emp)->priv[(num)])
 #define EMPIRE_DESCRIPTION(emp)  ((emp)->description)
 #define EMPIRE_DIPLOMACY(emp)  ((emp)->diplomacy)
-#define EMPIRE_STORAGE(emp)  ((emp)->store)
 #define EMPIRE_TRADE(emp)  ((emp)->trade)
 #define EMPIRE_LOGS(emp)  ((emp)->logs)
 #define EMPIRE_TERRITORY_LIST(emp)  ((emp)->territory_list)
@@ -500,13 +510,14 @@ extern int GET_MAX_BLOOD(char_data *ch);	// this one is different than the other
 #define EMPIRE_SHIPPING_LIST(emp)  ((emp)->shipping_list)
 #define EMPIRE_SORT_VALUE(emp)  ((emp)->sort_value)
 #define EMPIRE_UNIQUE_STORAGE(emp)  ((emp)->unique_store)
+#define EMPIRE_VEHICLE_INDEX(emp)  ((emp)->vehicle_index)
 #define EMPIRE_WORKFORCE_TRACKER(emp)  ((emp)->ewt_tracker)
 #define EMPIRE_ISLANDS(emp)  ((emp)->islands)
 #define EMPIRE_TOP_SHIPPING_ID(emp)  ((emp)->top_shipping_id)
 
 // helpers
 #define EMPIRE_HAS_TECH(emp, num)  (EMPIRE_TECH((emp), (num)) > 0)
-#define EMPIRE_IS_TIMED_OUT(emp)  (EMPIRE_LAST_LOGON(emp) + (config_get_int("whole_empire_timeout") * SECS_PER_REAL_DAY) < time(0))
+#define EMPIRE_IS_TIMED_OUT(emp)  (EMPIRE_LAST_LOGON(emp) + (CONFIG_INT(CFG_WHOLE_EMPIRE_TIMEOUT) * SECS_PER_REAL_DAY) < time(0))
 #define GET_TOTAL_WEALTH(emp)  (EMPIRE_WEALTH(emp) + (EMPIRE_COINS(emp) * COIN_VALUE))
 #define EXPLICIT_BANNER_TERMINATOR(emp)  (EMPIRE_BANNER_HAS_UNDERLINE(emp) ? "\t0" : "")
 
@@ -711,7 +722,7 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 
 // definitions
 #define IS_BLOOD_WEAPON(obj)  (GET_OBJ_VNUM(obj) == o_BLOODSWORD || GET_OBJ_VNUM(obj) == o_BLOODSTAFF || GET_OBJ_VNUM(obj) == o_BLOODSPEAR || GET_OBJ_VNUM(obj) == o_BLOODSKEAN || GET_OBJ_VNUM(obj) == o_BLOODMACE)
-#define IS_STOLEN(obj)  (GET_STOLEN_TIMER(obj) > 0 && (config_get_int("stolen_object_timer") * SECS_PER_REAL_MIN) + GET_STOLEN_TIMER(obj) > time(0))
+#define IS_STOLEN(obj)  (GET_STOLEN_TIMER(obj) > 0 && (CONFIG_INT(CFG_STOLEN_OBJECT_TIMER) * SECS_PER_REAL_MIN) + GET_STOLEN_TIMER(obj) > time(0))
 
 // helpers
 #define OBJ_FLAGGED(obj, flag)  (IS_SET(GET_OBJ_EXTRA(obj), (flag)))
@@ -990,7 +1001,7 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 #define IS_IMMORTAL(ch)  (GET_ACCESS_LEVEL(ch) >= LVL_START_IMM)
 #define IS_RIDING(ch)  (!IS_NPC(ch) && GET_MOUNT_VNUM(ch) != NOTHING && MOUNT_FLAGGED(ch, MOUNT_RIDING))
 #define IS_THIRSTY(ch)  (GET_COND(ch, THIRST) >= 360 && !has_ability(ch, ABIL_UNNATURAL_THIRST) && !has_ability(ch, ABIL_SATED_THIRST))
-#define IS_BLOOD_STARVED(ch)  (IS_VAMPIRE(ch) && GET_BLOOD(ch) <= config_get_int("blood_starvation_level"))
+#define IS_BLOOD_STARVED(ch)  (IS_VAMPIRE(ch) && GET_BLOOD(ch) <= CONFIG_INT(CFG_BLOOD_STARVATION_LEVEL))
 
 // for act() and act-like things (requires to_sleeping and is_spammy set to true/false)
 #define SENDOK(ch)  (((ch)->desc || SCRIPT_CHECK((ch), MTRIG_ACT)) && (to_sleeping || AWAKE(ch)) && (!PRF_FLAGGED(ch, PRF_NOSPAM) || !is_spammy))
@@ -1078,9 +1089,9 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 // definitions
 #define BLD_ALLOWS_MOUNTS(room)  (ROOM_IS_CLOSED(room) ? (ROOM_BLD_FLAGGED((room), BLD_ALLOW_MOUNTS | BLD_OPEN) || RMT_FLAGGED((room), RMT_OUTDOOR)) : TRUE)
 #define CAN_CHOP_ROOM(room)  (has_evolution_type(SECT(room), EVO_CHOPPED_DOWN) || CAN_INTERACT_ROOM((room), INTERACT_CHOP) || (ROOM_SECT_FLAGGED((room), SECTF_CROP) && ROOM_CROP_FLAGGED((room), CROPF_IS_ORCHARD)))
-#define DEPLETION_LIMIT(room)  (ROOM_BLD_FLAGGED((room), BLD_HIGH_DEPLETION) ? config_get_int("high_depletion") : config_get_int("common_depletion"))
-#define HAS_MINOR_DISREPAIR(room)  (HOME_ROOM(room) == room && GET_BUILDING(room) && BUILDING_DAMAGE(room) > 0 && (BUILDING_DAMAGE(room) >= (GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) * config_get_int("disrepair_minor") / 100)))
-#define HAS_MAJOR_DISREPAIR(room)  (HOME_ROOM(room) == room && GET_BUILDING(room) && BUILDING_DAMAGE(room) > 0 && (BUILDING_DAMAGE(room) >= (GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) * config_get_int("disrepair_major") / 100)))
+#define DEPLETION_LIMIT(room)  (ROOM_BLD_FLAGGED((room), BLD_HIGH_DEPLETION) ? CONFIG_INT(CFG_HIGH_DEPLETION) : CONFIG_INT(CFG_COMMON_DEPLETION))
+#define HAS_MINOR_DISREPAIR(room)  (HOME_ROOM(room) == room && GET_BUILDING(room) && BUILDING_DAMAGE(room) > 0 && (BUILDING_DAMAGE(room) >= (GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) * CONFIG_INT(CFG_DISREPAIR_MINOR) / 100)))
+#define HAS_MAJOR_DISREPAIR(room)  (HOME_ROOM(room) == room && GET_BUILDING(room) && BUILDING_DAMAGE(room) > 0 && (BUILDING_DAMAGE(room) >= (GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) * CONFIG_INT(CFG_DISREPAIR_MAJOR) / 100)))
 #define IS_CITY_CENTER(room)  (BUILDING_VNUM(room) == BUILDING_CITY_CENTER)
 #define IS_DARK(room)  (MAGIC_DARKNESS(room) || (!IS_ANY_BUILDING(room) && ROOM_LIGHTS(room) == 0 && (!ROOM_OWNER(room) || !EMPIRE_HAS_TECH(ROOM_OWNER(room), TECH_CITY_LIGHTS)) && !RMT_FLAGGED((room), RMT_LIGHT) && (weather_info.sunlight == SUN_DARK || RMT_FLAGGED((room), RMT_DARK))))
 #define IS_LIGHT(room)  (!MAGIC_DARKNESS(room) && WOULD_BE_LIGHT_WITHOUT_MAGIC_DARKNESS(room))
@@ -1115,6 +1126,8 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 #define ROOM_SECT_FLAGGED(room, flg)  SECT_FLAGGED(SECT(room), (flg))
 #define SHIFT_CHAR_DIR(ch, room, dir)  SHIFT_DIR((room), confused_dirs[get_north_for_char(ch)][0][(dir)])
 #define SHIFT_DIR(room, dir)  real_shift((room), shift_dir[(dir)][0], shift_dir[(dir)][1])
+#define VIEW_SHIFT_CHAR_DIR(ch, room, dir)  VIEW_SHIFT_DIR((room), confused_dirs[get_north_for_char(ch)][0][(dir)])
+#define VIEW_SHIFT_DIR(room, dir)  real_view_shift((room), shift_dir[(dir)][0], shift_dir[(dir)][1])
 
 // island info
 extern int GET_ISLAND_ID(room_data *room);	// formerly #define GET_ISLAND_ID(room)  (get_map_location_for(room)->island)
@@ -1285,6 +1298,7 @@ void SET_ISLAND_ID(room_data *room, int island);	// formerly a #define and a roo
  //////////////////////////////////////////////////////////////////////////////
 //// CONST EXTERNS ///////////////////////////////////////////////////////////
 
+extern union config_data_union *config_handles[NUM_CONFIG_HANDLES];	// config.c
 extern FILE *logfile;	// comm.c
 extern const int shift_dir[][2];	// constants.c
 extern struct weather_data weather_info;	// db.c
@@ -1432,6 +1446,7 @@ extern bool get_coord_shift(int start_x, int start_y, int x_shift, int y_shift,
 extern int get_direction_to(room_data *from, room_data *to);
 extern room_data *get_map_location_for(room_data *room);
 extern room_data *real_shift(room_data *origin, int x_shift, int y_shift);
+extern room_data *real_view_shift(room_data *origin, int x_shift, int y_shift);
 extern room_data *straight_line(room_data *origin, room_data *destination, int iter);
 extern sector_data *find_first_matching_sector(bitvector_t with_flags, bitvector_t without_flags);
 
@@ -1446,6 +1461,7 @@ void start_action(char_data *ch, int type, int timer);
 // utils from act.empire.c
 extern bool check_in_city_requirement(room_data *room, bool check_wait);
 extern bool is_in_city_for_empire(room_data *loc, empire_data *emp, bool check_wait, bool *too_soon);
+void update_city_area_territory(empire_data *emp, room_data *cityloc, int radius, bool add);
 
 // utils from act.informative.c
 extern char *get_obj_desc(obj_data *obj, char_data *ch, int mode);
@@ -1463,6 +1479,8 @@ void gain_condition(char_data *ch, int condition, int value);
 
 // utils from mapview.c
 extern bool adjacent_room_is_light(room_data *room);
+void clear_all_map_render_cache(void);
+void clear_map_render_cache(room_vnum vnum);
 void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options);
 #define look_at_room(ch)  look_at_room_by_loc((ch), IN_ROOM(ch), NOBITS)
 
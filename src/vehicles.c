@@ -1244,7 +1244,7 @@ vehicle_data *unstore_vehicle_from_file(FILE *fl, any_vnum vnum) {
 			case 'O': {
 				if (OBJ_FILE_TAG(line, "Owner:", length)) {
 					if (sscanf(line + length + 1, "%d", &i_in[0])) {
-						VEH_OWNER(veh) = real_empire(i_in[0]);
+						set_vehicle_owner(veh, real_empire(i_in[0]));
 					}
 				}
 				break;
@@ -1315,7 +1315,9 @@ void add_vehicle_to_table(vehicle_data *veh) {
 		HASH_FIND_INT(vehicle_table, &vnum, find);
 		if (!find) {
 			HASH_ADD_INT(vehicle_table, vnum, veh);
-			HASH_SORT(vehicle_table, sort_vehicles);
+			if (!defer_table_sorts) {
+				HASH_SORT(vehicle_table, sort_vehicles);
+			}
 		}
 	}
 }
@@ -1716,7 +1718,7 @@ void convert_one_obj_to_vehicle(obj_data *obj) {
 	}
 	
 	// convert traits
-	VEH_OWNER(veh) = real_empire(obj->last_empire_id);
+	set_vehicle_owner(veh, real_empire(obj->last_empire_id));
 	VEH_SCALE_LEVEL(veh) = GET_OBJ_CURRENT_SCALE_LEVEL(obj);
 	
 	// type-based traits
@@ -1727,7 +1729,7 @@ void convert_one_obj_to_vehicle(obj_data *obj) {
 				
 				// detect owner from room
 				if (ROOM_OWNER(main_room)) {
-					VEH_OWNER(veh) = ROOM_OWNER(main_room);
+					set_vehicle_owner(veh, ROOM_OWNER(main_room));
 				}
 				
 				// apply vehicle aff
@@ -1748,7 +1750,7 @@ void convert_one_obj_to_vehicle(obj_data *obj) {
 	
 	// did we successfully get an owner? try the room it's in
 	if (!VEH_OWNER(veh)) {
-		VEH_OWNER(veh) = ROOM_OWNER(room);
+		set_vehicle_owner(veh, ROOM_OWNER(room));
 	}
 	
 	// remove the object
@@ -60,7 +60,6 @@ void vehicle_chore_repair(empire_data *emp, vehicle_data *veh);
 
 // other locals
 int empire_chore_limit(empire_data *emp, int island_id, int chore);
-int sort_einv(struct empire_storage_data *a, struct empire_storage_data *b);
 
 // external functions
 void empire_skillup(empire_data *emp, any_vnum ability, double amount);	// skills.c
@@ -321,6 +320,7 @@ static struct empire_workforce_tracker_island *ewt_find_island(struct empire_wor
 * @return struct empire_workforce_tracker* A pointer to the empire's tracker for that resource (guaranteed).
 */
 static struct empire_workforce_tracker *ewt_find_tracker(empire_data *emp, obj_vnum vnum) {
+	struct empire_island *eisle, *next_eisle;
 	struct empire_workforce_tracker_island *isle;
 	struct empire_workforce_tracker *tt;
 	struct empire_storage_data *store;
@@ -333,8 +333,9 @@ static struct empire_workforce_tracker *ewt_find_tracker(empire_data *emp, obj_v
 		HASH_ADD_INT(EMPIRE_WORKFORCE_TRACKER(emp), vnum, tt);
 		
 		// scan for data
-		for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-			if (store->vnum == vnum) {
+		HASH_ITER(hh, EMPIRE_ISLANDS(emp), eisle, next_eisle) {
+			HASH_FIND_INT(eisle->store, &vnum, store);
+			if (store) {
 				tt->total_amount += store->amount;
 				isle = ewt_find_island(tt, store->island);
 				isle->amount += store->amount;
@@ -465,10 +466,10 @@ static bool can_gain_chore_resource(empire_data *emp, room_data *loc, int chore,
 
 	// determine local maxima
 	if (EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR)) {
-		island_max = config_get_int("max_chore_resource_skilled");
+		island_max = CONFIG_INT(CFG_MAX_CHORE_RESOURCE_SKILLED);
 	}
 	else {
-		island_max = config_get_int("max_chore_resource");
+		island_max = CONFIG_INT(CFG_MAX_CHORE_RESOURCE);
 	}
 	
 	// total max is a factor of this
@@ -483,7 +484,7 @@ static bool can_gain_chore_resource(empire_data *emp, room_data *loc, int chore,
 
 	// do we have too much?
 	if (tt->total_amount + tt->total_workers >= total_max) {
-		if (isle->amount + isle->workers < config_get_int("max_chore_resource_over_total")) {
+		if (isle->amount + isle->workers < CONFIG_INT(CFG_MAX_CHORE_RESOURCE_OVER_TOTAL)) {
 			return TRUE;
 		}
 	}
@@ -577,11 +578,12 @@ bool can_gain_chore_resource_from_interaction(empire_data *emp, room_data *room,
 void chore_update(void) {
 	void ewt_free_tracker(struct empire_workforce_tracker **tracker);
 	
+	struct empire_vehicle_index *vidx, *next_vidx;
 	struct empire_territory_data *ter;
 	vehicle_data *veh, *next_veh;
 	empire_data *emp, *next_emp;
 	
-	int time_to_empire_emptiness = config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK;
+	int time_to_empire_emptiness = CONFIG_INT(CFG_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK;
 
 	HASH_ITER(hh, empire_table, emp, next_emp) {
 		// skip idle empires
@@ -590,23 +592,17 @@ void chore_update(void) {
 		}
 
 		if (EMPIRE_HAS_TECH(emp, TECH_WORKFORCE)) {
-			// sort einv now to ensure it's in a useful order (most quantity first)
-			LL_SORT(EMPIRE_STORAGE(emp), sort_einv);
-			
 			global_next_territory_entry = NULL;
-			for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = global_next_territory_entry) {
-				global_next_territory_entry = ter->next;
+			HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter, global_next_territory_entry) {
 				process_one_chore(emp, ter->room);
 			}
 			
-			LL_FOREACH_SAFE(vehicle_list, veh, next_veh) {
-				if (VEH_OWNER(veh) == emp) {
+			HASH_ITER(hh, EMPIRE_VEHICLE_INDEX(emp), vidx, next_vidx) {
+				DL_FOREACH_SAFE2(vidx->vehicles, veh, next_veh, next_owned) {
 					process_one_vehicle_chore(emp, veh);
 				}
 			}
 			
-			EMPIRE_NEEDS_SAVE(emp) = TRUE;
-			
 			// no longer need this -- free up the tracker
 			ewt_free_tracker(&EMPIRE_WORKFORCE_TRACKER(emp));
 		}
@@ -761,18 +757,22 @@ char_data *find_chore_worker_in_room(room_data *room, mob_vnum vnum) {
 * @return struct empire_npc_data* The npc who will help, or NULL.
 */
 struct empire_npc_data *find_free_npc_for_chore(empire_data *emp, room_data *loc) {
-	struct empire_territory_data *ter_iter;
+	struct empire_territory_data *ter_iter, *next_ter;
 	struct empire_npc_data *found = NULL, *backup = NULL, *npc_iter;
 	room_data *rm;
 
-	int chore_distance = config_get_int("chore_distance");
+	int chore_distance = CONFIG_INT(CFG_CHORE_DISTANCE);
 	
 	if (!emp || !loc) {
 		return NULL;
 	}
 	
 	// massive iteration to try to find one
-	for (ter_iter = EMPIRE_TERRITORY_LIST(emp); ter_iter && !found; ter_iter = ter_iter->next) {
+	HASH_ITER(hh, EMPIRE_TERRITORY_LIST(emp), ter_iter, next_ter) {
+		if (found) {
+			break;
+		}
+		
 		// only bother checking anything if npcs live here
 		if (ter_iter->npcs) {			
 			if ((rm = ter_iter->room) && GET_ISLAND_ID(loc) == GET_ISLAND_ID(rm) && compute_distance(loc, rm) <= chore_distance) {
@@ -839,18 +839,6 @@ char_data *place_chore_worker(empire_data *emp, int chore, room_data *room) {
 }
 
 
-/**
-* Simple sorter puts higher quantities at the top (helps workforce optimize)
-*
-* @param struct empire_storage_data *a One element
-* @param struct empire_storage_data *b Another element
-* @return int Sort instruction of <0, 0, or >0
-*/
-int sort_einv(struct empire_storage_data *a, struct empire_storage_data *b) {
-	return b->amount - a->amount;
-}
-
-
  /////////////////////////////////////////////////////////////////////////////
 //// GENERIC CRAFT WORKFORCE ////////////////////////////////////////////////
 
@@ -1066,9 +1054,9 @@ void do_chore_gen_craft(empire_data *emp, room_data *room, int chore, CHORE_GEN_
 		}
 		
 		add_to_empire_storage(emp, islid, GET_CRAFT_OBJECT(do_craft), GET_CRAFT_QUANTITY(do_craft));
-		empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+		empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 		if (is_skilled) {
-			empire_skillup(emp, ABIL_SKILLED_LABOR, config_get_double("exp_from_workforce"));
+			empire_skillup(emp, ABIL_SKILLED_LABOR, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 		}
 		
 		// only send message if someone else is present (don't bother verifying it's a player)
@@ -1104,7 +1092,7 @@ void do_chore_brickmaking(empire_data *emp, room_data *room) {
 		add_to_empire_storage(emp, islid, o_BRICKS, 1);
 		
 		act("$n finishes a pile of bricks.", FALSE, worker, NULL, NULL, TO_ROOM);
-		empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+		empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 	}
 	else if (can_do) {
 		// place worker
@@ -1155,7 +1143,7 @@ void do_chore_building(empire_data *emp, room_data *room, int mode) {
 	if (worker && can_do) {
 		if (res) {
 			found = TRUE;
-			empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+			empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 			
 			if (res->type == RES_OBJECT) {
 				add_to_resource_list(&GET_BUILT_WITH(room), RES_OBJECT, res->vnum, 1, 0);
@@ -1218,9 +1206,9 @@ void do_chore_chopping(empire_data *emp, room_data *room) {
 	extern void change_chop_territory(room_data *room);
 	
 	char_data *worker = find_chore_worker_in_room(room, chore_data[CHORE_CHOPPING].mob);
-	bool can_do = (get_depletion(room, DPLTN_CHOP) < config_get_int("chop_depletion")) && can_gain_chore_resource_from_interaction(emp, room, CHORE_CHOPPING, INTERACT_CHOP);
+	bool can_do = (get_depletion(room, DPLTN_CHOP) < CONFIG_INT(CFG_CHOP_DEPLETION)) && can_gain_chore_resource_from_interaction(emp, room, CHORE_CHOPPING, INTERACT_CHOP);
 	
-	int chop_timer = config_get_int("chop_timer");
+	int chop_timer = CONFIG_INT(CFG_CHOP_TIMER);
 	
 	if (worker && can_do) {
 		if (get_room_extra_data(room, ROOM_EXTRA_CHOP_PROGRESS) <= 0) {
@@ -1233,7 +1221,7 @@ void do_chore_chopping(empire_data *emp, room_data *room) {
 				// finished!
 				run_room_interactions(worker, room, INTERACT_CHOP, one_chop_chore);
 				change_chop_territory(room);
-				empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+				empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 				
 				if (CAN_CHOP_ROOM(room)) {
 					set_room_extra_data(room, ROOM_EXTRA_CHOP_PROGRESS, chop_timer);
@@ -1271,7 +1259,7 @@ INTERACTION_FUNC(one_dig_chore) {
 		ewt_mark_resource_worker(emp, inter_room, interaction->vnum);
 		add_to_empire_storage(emp, GET_ISLAND_ID(inter_room), interaction->vnum, interaction->quantity);
 		add_depletion(inter_room, DPLTN_DIG, TRUE);
-		empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+		empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 		return TRUE;
 	}
 	
@@ -1338,7 +1326,7 @@ void do_chore_dismantle(empire_data *emp, room_data *room) {
 				found = TRUE;
 				res->amount -= 1;
 				add_to_empire_storage(emp, GET_ISLAND_ID(room), res->vnum, 1);
-				empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+				empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 			}
 			
 			// remove res?
@@ -1419,14 +1407,15 @@ INTERACTION_FUNC(one_einv_interaction_chore) {
 */
 void do_chore_einv_interaction(empire_data *emp, room_data *room, int chore, int interact_type) {
 	char_data *worker = find_chore_worker_in_room(room, chore_data[chore].mob);
-	struct empire_storage_data *store, *found_store = NULL;
+	struct empire_storage_data *store, *next_store, *found_store = NULL;
 	obj_data *proto, *found_proto = NULL;
 	int islid = GET_ISLAND_ID(room);
+	struct empire_island *isle = get_empire_island(emp, islid);
 	int most_found = -1;
 	
 	// look for something to process
-	LL_FOREACH(EMPIRE_STORAGE(emp), store) {
-		if (store->island != islid || store->amount < 1) {
+	HASH_ITER(hh, isle->store, store, next_store) {
+		if (store->amount < 1) {
 			continue;
 		}
 		if (!(proto = obj_proto(store->vnum))) {
@@ -1451,14 +1440,9 @@ void do_chore_einv_interaction(empire_data *emp, room_data *room, int chore, int
 		einv_interaction_chore_type = chore;
 		
 		if (run_interactions(worker, found_proto->interactions, interact_type, room, worker, found_proto, one_einv_interaction_chore) && found_store) {
-			empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
-			
-			found_store->amount -= 1;
+			empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 			
-			if (found_store->amount <= 0) {
-				LL_DELETE(EMPIRE_STORAGE(emp), found_store);
-				free(found_store);
-			}
+			add_to_empire_storage(emp, islid, found_store->vnum, -1);
 		}
 		else {
 			// failed to hit any interactions
@@ -1483,7 +1467,7 @@ INTERACTION_FUNC(one_farming_chore) {
 	
 	if (emp && proto && proto->storage && can_gain_chore_resource(emp, inter_room, CHORE_FARMING, interaction->vnum)) {
 		ewt_mark_resource_worker(emp, inter_room, interaction->vnum);
-		empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+		empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 		
 		amt = interaction->quantity;
 		add_to_empire_storage(emp, GET_ISLAND_ID(inter_room), interaction->vnum, amt);
@@ -1516,7 +1500,7 @@ void do_chore_farming(empire_data *emp, room_data *room) {
 		if (worker) {
 			// set up harvest time if needed
 			if (get_room_extra_data(room, ROOM_EXTRA_HARVEST_PROGRESS) <= 0) {
-				set_room_extra_data(room, ROOM_EXTRA_HARVEST_PROGRESS, config_get_int("harvest_timer") * (ROOM_CROP_FLAGGED(room, CROPF_IS_ORCHARD) ? 2 : 1));
+				set_room_extra_data(room, ROOM_EXTRA_HARVEST_PROGRESS, CONFIG_INT(CFG_HARVEST_TIMER) * (ROOM_CROP_FLAGGED(room, CROPF_IS_ORCHARD) ? 2 : 1));
 			}
 			
 			// harvest ticker
@@ -1532,7 +1516,7 @@ void do_chore_farming(empire_data *emp, room_data *room) {
 				run_room_interactions(worker, room, INTERACT_HARVEST, one_farming_chore);
 				
 				// only change to seeded if it's not an orchard OR if it's over-picked			
-				if (!ROOM_CROP_FLAGGED(room, CROPF_IS_ORCHARD) || get_depletion(room, DPLTN_PICK) >= config_get_int("short_depletion")) {
+				if (!ROOM_CROP_FLAGGED(room, CROPF_IS_ORCHARD) || get_depletion(room, DPLTN_PICK) >= CONFIG_INT(CFG_SHORT_DEPLETION)) {
 					if (empire_chore_limit(emp, GET_ISLAND_ID(room), CHORE_REPLANTING) && (old_sect = reverse_lookup_evolution_for_sector(SECT(room), EVO_CROP_GROWS))) {
 						// sly-convert back to what it was grown from ... not using change_terrain
 						perform_change_sect(room, NULL, old_sect);
@@ -1580,7 +1564,7 @@ void do_chore_farming(empire_data *emp, room_data *room) {
 
 
 void do_chore_fire_brigade(empire_data *emp, room_data *room) {
-	int fire_extinguish_value = config_get_int("fire_extinguish_value");
+	int fire_extinguish_value = CONFIG_INT(CFG_FIRE_EXTINGUISH_VALUE);
 	char_data *worker = find_chore_worker_in_room(room, chore_data[CHORE_FIRE_BRIGADE].mob);
 	
 	if (worker && BUILDING_BURNING(room) > 0) {
@@ -1614,8 +1598,8 @@ INTERACTION_FUNC(one_gardening_chore) {
 		
 		add_to_empire_storage(emp, GET_ISLAND_ID(inter_room), interaction->vnum, interaction->quantity);
 		add_depletion(inter_room, DPLTN_PICK, TRUE);
-		empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
-		empire_skillup(emp, ABIL_SKILLED_LABOR, config_get_double("exp_from_workforce"));
+		empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
+		empire_skillup(emp, ABIL_SKILLED_LABOR, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 
 		act("$n picks an herb and carefully hangs it to dry.", FALSE, ch, NULL, NULL, TO_ROOM);
 		return TRUE;
@@ -1626,7 +1610,7 @@ INTERACTION_FUNC(one_gardening_chore) {
 
 
 void do_chore_gardening(empire_data *emp, room_data *room) {
-	int garden_depletion = config_get_int("garden_depletion");
+	int garden_depletion = CONFIG_INT(CFG_GARDEN_DEPLETION);
 	
 	char_data *worker = find_chore_worker_in_room(room, chore_data[CHORE_HERB_GARDENING].mob);
 	bool depleted = (get_depletion(room, DPLTN_PICK) >= garden_depletion);
@@ -1677,7 +1661,7 @@ INTERACTION_FUNC(one_mining_chore) {
 		if (interaction->quantity > 0) {
 			add_to_room_extra_data(inter_room, ROOM_EXTRA_MINE_AMOUNT, -1 * interaction->quantity);
 			add_to_empire_storage(emp, GET_ISLAND_ID(inter_room), interaction->vnum, interaction->quantity);
-			empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+			empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 			
 			sprintf(buf, "$n strikes the wall and %s falls loose!", get_obj_name_by_proto(interaction->vnum));
 			act(buf, FALSE, ch, NULL, NULL, TO_ROOM);
@@ -1724,9 +1708,10 @@ void do_chore_mining(empire_data *emp, room_data *room) {
 
 
 void do_chore_minting(empire_data *emp, room_data *room) {
-	struct empire_storage_data *highest, *store, *temp;
+	struct empire_storage_data *highest, *store, *next_store;
 	char_data *worker = find_chore_worker_in_room(room, chore_data[CHORE_MINTING].mob);
 	int high_amt, limit, islid = GET_ISLAND_ID(room);
+	struct empire_island *isle = get_empire_island(emp, islid);
 	bool can_do = TRUE;
 	obj_data *orn;
 	obj_vnum vnum;
@@ -1741,11 +1726,7 @@ void do_chore_minting(empire_data *emp, room_data *room) {
 		// first, find the best item to mint
 		highest = NULL;
 		high_amt = 0;
-		for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
-			if (store->island != islid) {
-				continue;
-			}
-			
+		HASH_ITER(hh, isle->store, store, next_store) {
 			orn = obj_proto(store->vnum);
 			if (orn && store->amount >= 1 && IS_WEALTH_ITEM(orn) && GET_WEALTH_VALUE(orn) > 0 && GET_WEALTH_AUTOMINT(orn)) {
 				if (highest == NULL || store->amount > high_amt) {
@@ -1765,19 +1746,14 @@ void do_chore_minting(empire_data *emp, room_data *room) {
 			}
 			
 			vnum = highest->vnum;
-			highest->amount = MAX(0, highest->amount - 1);
-			
-			if (highest->amount == 0) {
-				REMOVE_FROM_LIST(highest, EMPIRE_STORAGE(emp), next);
-				free(highest);
-			}
+			add_to_empire_storage(emp, islid, vnum, -1);
 			
 			orn = obj_proto(vnum);	// existence of this was pre-validated
 			increase_empire_coins(emp, emp, GET_WEALTH_VALUE(orn) * (1.0/COIN_VALUE));
 			
 			act("$n finishes minting some coins.", FALSE, worker, NULL, NULL, TO_ROOM);
-			empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
-			empire_skillup(emp, ABIL_SKILLED_LABOR, config_get_double("exp_from_workforce"));
+			empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
+			empire_skillup(emp, ABIL_SKILLED_LABOR, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 		}
 		else {
 			// nothing remains: mark for despawn
@@ -1805,7 +1781,7 @@ void do_chore_nailmaking(empire_data *emp, room_data *room) {
 		add_to_empire_storage(emp, islid, o_NAILS, 4);
 		
 		act("$n finishes a pouch of nails.", FALSE, worker, NULL, NULL, TO_ROOM);
-		empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+		empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 	}
 	else if (can_do) {
 		// place worker
@@ -1834,7 +1810,7 @@ INTERACTION_FUNC(one_quarry_chore) {
 
 void do_chore_quarrying(empire_data *emp, room_data *room) {
 	char_data *worker = find_chore_worker_in_room(room, chore_data[CHORE_QUARRYING].mob);
-	bool depleted = (get_depletion(room, DPLTN_QUARRY) >= config_get_int("common_depletion")) ? TRUE : FALSE;
+	bool depleted = (get_depletion(room, DPLTN_QUARRY) >= CONFIG_INT(CFG_COMMON_DEPLETION)) ? TRUE : FALSE;
 	bool can_do = !depleted && can_gain_chore_resource_from_interaction(emp, room, CHORE_QUARRYING, INTERACT_QUARRY);
 	
 	if (worker && can_do) {
@@ -1847,7 +1823,7 @@ void do_chore_quarrying(empire_data *emp, room_data *room) {
 			if (get_room_extra_data(room, ROOM_EXTRA_QUARRY_WORKFORCE_PROGRESS) == 0) {
 				if (run_room_interactions(worker, room, INTERACT_QUARRY, one_quarry_chore)) {
 					add_depletion(room, DPLTN_QUARRY, TRUE);
-					empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+					empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 				}
 				else {
 					SET_BIT(MOB_FLAGS(worker), MOB_SPAWNED);
@@ -1871,7 +1847,7 @@ void do_chore_quarrying(empire_data *emp, room_data *room) {
 
 
 void do_chore_shearing(empire_data *emp, room_data *room) {
-	int shear_growth_time = config_get_int("shear_growth_time");
+	int shear_growth_time = CONFIG_INT(CFG_SHEAR_GROWTH_TIME);
 	
 	char_data *worker = find_chore_worker_in_room(room, chore_data[CHORE_SHEARING].mob);
 	char_data *mob, *shearable = NULL;
@@ -1905,7 +1881,7 @@ void do_chore_shearing(empire_data *emp, room_data *room) {
 					ewt_mark_resource_worker(emp, room, interact->vnum);
 					
 					act("$n shears $N.", FALSE, worker, NULL, shearable, TO_ROOM);
-					empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+					empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 					found = TRUE;
 				}
 				
@@ -1927,7 +1903,7 @@ void do_chore_shearing(empire_data *emp, room_data *room) {
 
 
 void do_chore_trapping(empire_data *emp, room_data *room) {
-	int short_depletion = config_get_int("short_depletion");
+	int short_depletion = CONFIG_INT(CFG_SHORT_DEPLETION);
 	
 	char_data *worker = find_chore_worker_in_room(room, chore_data[CHORE_TRAPPING].mob);
 	obj_vnum vnum = number(0, 1) ? o_SMALL_SKIN : o_LARGE_SKIN;
@@ -1941,8 +1917,8 @@ void do_chore_trapping(empire_data *emp, room_data *room) {
 		if (!number(0, 23)) {
 			add_to_empire_storage(emp, GET_ISLAND_ID(room), vnum, 1);
 			add_depletion(room, DPLTN_TRAPPING, TRUE);
-			empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
-			empire_skillup(emp, ABIL_SKILLED_LABOR, config_get_double("exp_from_workforce"));
+			empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
+			empire_skillup(emp, ABIL_SKILLED_LABOR, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 		}
 	}
 	else if (can_do) {
@@ -2000,7 +1976,7 @@ void vehicle_chore_repair(empire_data *emp, vehicle_data *veh) {
 	
 	if (worker && can_do) {
 		if (res) {
-			empire_skillup(emp, ABIL_WORKFORCE, config_get_double("exp_from_workforce"));
+			empire_skillup(emp, ABIL_WORKFORCE, CONFIG_DOUBLE(CFG_EXP_FROM_WORKFORCE));
 			
 			if (res->type == RES_OBJECT) {
 				charge_stored_resource(emp, islid, res->vnum, 1);